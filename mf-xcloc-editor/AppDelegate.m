@@ -21,6 +21,7 @@
     {
         bool _filterOptions_Regex;
         bool _filterOptions_CaseSensitive;
+        bool _filterOptions_OnlyIssues; /// [Oct 2026]
     }
 
 #pragma mark - Lifecycle
@@ -58,6 +59,8 @@
 
     - (void)applicationDidFinishLaunching:(NSNotification *)aNotification {
         
+        mftrace_setEnabled([[NSUserDefaults standardUserDefaults] boolForKey: @"MFTraceEnabled"]); /// See `Trace.m` [Oct 2026]
+        
         if ((0)) { /// TESTING
         
             NSString *xclocPath;
@@ -77,6 +80,11 @@
 
     - (NSApplicationTerminateReply) applicationShouldTerminate: (NSApplication *)sender {
         
+        /// Write journaled edits into the xliffs (See `EditJournal.m`) [Oct 2026]
+        ///     Closing the windows below usually closes the documents too, which does the same – this is just to be sure.
+        for (NSDocument *doc in [[NSDocumentController sharedDocumentController] documents])
+            if (isclass(doc, XclocDocument)) [(XclocDocument *)doc flushJournalSynchronously];
+        
         /// Close all windows
         ///     (Otherwise our `windowWillClose:` callbacks aren't called. See https://stackoverflow.com/q/2997571.
         ///         Update: Shouldn't be necessary anymore since `windowWillClose:` was only used to restore window frames which is now handled by restorable state stuff (See `XclocDocumentController` and `setFrameUsingName: @"TheeeEditor"`)
@@ -135,12 +143,19 @@
             if (isaction(quickLookMenuItemSelected:))
                 ret(!!doc);
             
+            if (isaction(performanceMenuItemSelected:))
+                ret(YES);
+            
             if (isaction(filterMenuItemSelected:))
                 ret(!!doc);
             if (isaction(caseSensitiveMenuItemSelected:)) {
                 menuItem.state = self->_filterOptions_CaseSensitive;
                 ret(!!doc);
             }
+            if (isaction(onlyIssuesMenuItemSelected:)) {
+                menuItem.state = self->_filterOptions_OnlyIssues;
+                ret(!!doc);
+            }
             if (isaction(regexMenuItemSelected:)) {
                 menuItem.image = ({ /// Custom-draw `.*` icon for the regex menuItem. (SF Symbols doesn't offer that) [Dec 2025].
                     auto text = [[NSAttributedString alloc]
@@ -178,6 +193,12 @@
                     ![(id)[tableView.window firstResponder] respondsToSelector: @selector(isDescendantOf:)] ||                          /// [Dec 2025] Pretty sure I saw a crash that this should prevent.
                     ![(id)[tableView.window firstResponder] isDescendantOf: tableView]
                 )                                                                                                                      ret (NO); /// Ignore input when tableView is not firstResponder to prevent accidental input [Oct 2025] || isDescendantOf: is necessary when editing an NSTextField.
+                if ([[tableView selectedRowIndexes] count] > 1) { /// Multiple selection – Marks all of them as translated, unless they all are already. [Oct 2026]
+                    BOOL allTranslated;
+                    auto rows = [tableView bulkEditableSelection: &allTranslated]; /// Cached – this runs on every validation
+                    if (!rows.count)                                                                                                   ret (NO);
+                    ret (allTranslated == [menuItem.identifier isEqual: @"mark_for_review"]);
+                }
                 if (![tableView selectedItem])                                                                                         ret (NO);
                 if (rowModel_isPluralParent([tableView selectedItem]))                                                                 ret (NO);
                 if ([tableView  rowIsTranslated: [tableView selectedItem]] && [menuItem.identifier isEqual: @"mark_for_review"])       ret (YES);
@@ -185,6 +206,15 @@
                 ret (NO);
                 
             }
+            if (isaction(useSuggestionMenuItemSelected:)) { /// [Oct 2026]
+                TableView *tableView = !doc?nil: doc->ctrl->out_tableView;
+                if ([[tableView selectedRowIndexes] count] != 1) ret (NO);
+                ret ([[tableView translationMemorySuggestionsForItem: [tableView selectedItem]] count] > 0);
+            }
+            if (isaction(markAllShownMenuItemSelected:)) { /// [Oct 2026]
+                TableView *tableView = !doc?nil: doc->ctrl->out_tableView;
+                ret ([[tableView displayedItems] count] > 0); /// Not checking whether any of the rows would actually change – that's a pass over all of them, on every keystroke.
+            }
             if (isaction(showInFilenameMenuItemSelected:)) {
                 
                 TableView *tableView = !doc?nil: doc->ctrl->out_tableView;;
@@ -228,29 +258,55 @@
     
     - (IBAction)regexMenuItemSelected: (NSMenuItem *)sender         { sender.state = !sender.state; self->_filterOptions_Regex         = sender.state; [self updateFilterStuff: nil]; }
     - (IBAction)caseSensitiveMenuItemSelected: (NSMenuItem *)sender { sender.state = !sender.state; self->_filterOptions_CaseSensitive = sender.state; [self updateFilterStuff: nil]; }
+    - (IBAction)onlyIssuesMenuItemSelected: (NSMenuItem *)sender    { sender.state = !sender.state; self->_filterOptions_OnlyIssues    = sender.state; [self updateFilterStuff: nil]; } /// (See `Validator.m`) [Oct 2026]
 
     - (void) updateFilterStuff: (TableView *)tableView {
         
         mflog(@"regex: %d, case: %d", self->_filterOptions_Regex, self->_filterOptions_CaseSensitive);
         
-        NSStringCompareOptions options = 0;
-        if (!self->_filterOptions_CaseSensitive)  options |= NSCaseInsensitiveSearch;
-        if (self ->_filterOptions_Regex)          options |= NSRegularExpressionSearch;
+        NSStringCompareOptions options = rowModel_filterOptions(self->_filterOptions_Regex, self->_filterOptions_CaseSensitive);
     
-        if (tableView) /// Necessary because we're calling this in (TableView.m -init), before the tableView is available via `getdoc_alldocs()`. Very hacky. Could use KVO instead. [Dec 2025]
+        if (tableView) { /// Necessary because we're calling this in (TableView.m -init), before the tableView is available via `getdoc_alldocs()`. Very hacky. Could use KVO instead. [Dec 2025]
             [tableView updateFilterOptions: options];
+            [tableView updateFilterOnlyIssues: self->_filterOptions_OnlyIssues];
+        }
         else
-            for (XclocDocument *doc in getdoc_alldocs())
+            for (XclocDocument *doc in getdoc_alldocs()) {
                 [doc->ctrl->out_tableView updateFilterOptions: options];
+                [doc->ctrl->out_tableView updateFilterOnlyIssues: self->_filterOptions_OnlyIssues];
+            }
     }
 
     - (IBAction) quickLookMenuItemSelected: (id)sender {
         [getdoc_frontmost()->ctrl->out_tableView togglePreviewPanel: sender];
     }
+    
+    - (IBAction) performanceMenuItemSelected: (id)sender {
+        [MFTraceStatsPanel.shared makeKeyAndOrderFront: sender]; /// [Oct 2026]
+    }
 
     - (IBAction) markAsTranslatedMenuItemSelected: (id)sender {
         auto tableView = getdoc_frontmost()->ctrl->out_tableView;
-        [tableView toggleIsTranslatedState: [tableView selectedItem]];
+        if ([[tableView selectedRowIndexes] count] > 1)
+            [tableView setIsTranslatedState: [[sender identifier] isEqual: @"mark_as_translated"] onRowModels: [tableView selectedItems]]; /// [Oct 2026]
+        else
+            [tableView toggleIsTranslatedState: [tableView selectedItem]];
+    }
+    - (IBAction) useSuggestionMenuItemSelected: (id)sender {
+        
+        /// Puts the best translation memory suggestion into the selected row [Oct 2026]
+        
+        auto tableView = getdoc_frontmost()->ctrl->out_tableView;
+        auto transUnit = [tableView selectedItem];
+        auto suggestions = [tableView translationMemorySuggestionsForItem: transUnit];
+        if (suggestions.count) [tableView useTranslationMemorySuggestion: suggestions[0] onRowModel: transUnit];
+    }
+    - (IBAction) markAllShownMenuItemSelected: (id)sender {
+        
+        /// Marks every row that's currently displayed – all rows of the selected file that match the filter, not just the ones on screen. [Oct 2026]
+        
+        auto tableView = getdoc_frontmost()->ctrl->out_tableView;
+        [tableView setIsTranslatedState: [[sender identifier] isEqual: @"mark_all_shown_as_translated"] onRowModels: [tableView displayedItems]];
     }
     - (IBAction) showInFilenameMenuItemSelected: (id)sender {
         
@@ -19,6 +19,22 @@
     
 #define kMFStr_RevealInAll                      stringf(@"Show in '%@'", kMFPath_AllDocuments)
 #define kMFStr_GoToAll                          stringf(@"Go to '%@'", kMFPath_AllDocuments)
+#define kMFStr_TranslationMemory                @"Translation Memory"
+#define kMFStr_TranslationMemorySuggestion(sg)  stringf(@"%d%%  %@", (int)round((sg)->similarity * 100), (sg)->target) /** (See `TMSuggestion`) [Oct 2026] */
+#define kMFStr_TranslationMemoryLoading         @"Looking Up…"
+#define kMFStr_Issues                           @"Issues"   /** (See `MFRowIssue`) [Oct 2026] */
+#define kMFStr_IssueCount(n)                    stringf(@"%ld %@ with issues", (long)(n), (n) == 1 ? @"string" : @"strings")
+#define kMFStr_Issue_MissingSpecifier           @"The translation leaves out a format specifier of the source (e.g. %@ or %d)"
+#define kMFStr_Issue_ExtraSpecifier             @"The translation has a format specifier that the source doesn't have"
+#define kMFStr_Issue_MismatchedSpecifier        @"A format specifier in the translation has a different type than in the source (e.g. %@ instead of %d)"
+#define kMFStr_Issue_PluralVariable             @"The translation changes a %#@variable@ of the source"
+#define kMFStr_Issue_EmptyVariant               @"This plural variant has no translation, but the other variants do"
+#define kMFStr_MergeConflicts                   @"The file was changed by another app while you were editing" /** (See `XliffMerge.m`) [Oct 2026] */
+#define kMFStr_MergeConflictsInfo(conflicts, lost) stringf(@"%@%@", \
+    (conflicts) ? stringf(@"%ld of the strings you edited were also changed in the file. Your versions were kept. ", (long)(conflicts)) : @"", \
+    (lost)      ? stringf(@"%ld of the strings you edited aren't in the file anymore – those edits were dropped.", (long)(lost)) : @"")
+#define kMFStr_MergeKeepMine                    @"Keep My Versions"
+#define kMFStr_MergeUseTheirs                   @"Use Versions from File"
 
 
 #define kMFStr_MarkForReview_Symbol     @"circle"
@@ -26,4 +42,6 @@
 #define kMFStr_RevealInFile_Symbol      @"document"
 #define kMFStr_RevealInAll_Symbol       (@"document.on.document"/*@"document.viewfinder"*/)
 #define kMFStr_GoToAll_Symbol           @"document.on.document"
+#define kMFStr_TranslationMemory_Symbol @"text.badge.checkmark"
+#define kMFStr_Issues_Symbol            @"exclamationmark.triangle.fill"
 
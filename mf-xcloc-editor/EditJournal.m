@@ -0,0 +1,185 @@
+//
+//  EditJournal.m
+//  mf-xcloc-editor
+//
+//  Created by Noah Nübling on 10/17/26.
+//
+
+/// Append-only log of the edits to a document, stored next to the .xcloc [Oct 2026]
+///
+///     Why: Every edit used to go through a full `saveDocument:` – and NSDocument's saving machinery occasionally hangs on `_NSDocumentSerializationSemaphore` (See `writeTranslationDataToFile`).
+///         Now each edit only appends one line here, and the xliff itself is rewritten in the background every so often. (See `-[XclocDocument flushJournal]`)
+///         If the app crashes or hangs before a flush finishes, the edits are still here and get replayed the next time the document is opened.
+///
+///     Format: One JSON object per line – `{"file": <original attr of the <file>>, "id": ..., "column": "target"|"state", "old": ..., "new": ...}`
+///         Missing values are `null`. JSON escapes newlines, so a line is always one entry. A torn line from a crash mid-write is skipped.
+///
+///     Lifetime: Created when the document is opened, emptied after every successful flush, deleted when the document is closed. Kept when the document is reverted – its entries are replayed onto the new contents.
+
+@interface EditJournal : NSObject
+    {
+        @public
+        NSString *path;
+        int fd;
+        NSArray<NSString *> *filePaths;     /// Of the xliff – Maps `RowStore->fileIndexes` to the `file` we record. (ids are only unique within a file)
+        NSUInteger length;                  /// Bytes in the file. Lets flushes tell whether more edits came in while they were writing.
+        BOOL needsSync;
+    }
+@end
+@implementation EditJournal
+    - (void) dealloc {
+        if (self->fd != -1) close(self->fd);
+    }
+@end
+
+NSString *EditJournal_PathForDocument(NSURL *xclocURL) {
+
+    /// `Foo.xcloc` -> `.Foo.xcloc.mfjournal` in the same folder.
+    ///     Outside the package so NSDocument and Xcode never see it. Hidden so it doesn't clutter the user's folder while the document is open.
+
+    NSString *dir  = xclocURL.path.stringByDeletingLastPathComponent;
+    NSString *name = xclocURL.path.lastPathComponent;
+    return [dir stringByAppendingPathComponent: stringf(@".%@.mfjournal", name)];
+}
+
+NSArray<NSDictionary *> *EditJournal_Read(NSString *path) {
+
+    /// Returns the entries in the order they were written. Empty if there's no journal.
+
+    NSData *data = [NSData dataWithContentsOfFile: path];
+    if (!data.length) return @[];
+
+    auto result = [NSMutableArray<NSDictionary *> new];
+
+    const char *b = data.bytes;
+    NSUInteger n = data.length;
+    NSUInteger lineStart = 0;
+    while (lineStart < n) {
+
+        const char *nl = memchr(b + lineStart, '\n', n - lineStart);
+        if (!nl) { /// The last entry was cut off mid-write – it was never committed.
+            mflog(@"Ignoring torn last line in journal (%lu bytes)", n - lineStart);
+            break;
+        }
+        NSUInteger lineEnd = nl - b;
+
+        if (lineEnd > lineStart) {
+            NSData *line = [NSData dataWithBytesNoCopy: (void *)(b + lineStart) length: lineEnd - lineStart freeWhenDone: NO];
+            NSDictionary *entry = [NSJSONSerialization JSONObjectWithData: line options: 0 error: nil];
+            if (isclass(entry, NSDictionary) && entry[@"file"] && entry[@"id"] && entry[@"column"])
+                [result addObject: entry];
+            else
+                mflog(@"Skipping unreadable journal line at byte %lu", lineStart);
+        }
+
+        lineStart = lineEnd + 1;
+    }
+
+    return result;
+}
+
+EditJournal *_Nullable EditJournal_Open(NSString *path, NSArray<NSString *> *filePaths, NSError *__autoreleasing _Nullable *outError) {
+
+    /// Opens the journal for appending. Existing entries are kept until the next successful flush – call `EditJournal_Read()` first to replay them.
+
+    int fd = open(path.fileSystemRepresentation, O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (fd == -1) {
+        if (outError) *outError = [NSError errorWithDomain: NSPOSIXErrorDomain code: errno userInfo: @{ NSDebugDescriptionErrorKey: stringf(@"Couldn't open journal at '%@' (%s)", path, strerror(errno)) }];
+        return nil;
+    }
+
+    auto j = [EditJournal new];
+    j->path = path;
+    j->fd = fd;
+    j->filePaths = filePaths;
+    j->length = (NSUInteger)lseek(fd, 0, SEEK_END);
+
+    /// Terminate a torn last line, so it doesn't swallow the next entry
+    if (j->length > 0) {
+        char last = 0;
+        if (pread(fd, &last, 1, j->length - 1) == 1 && last != '\n') {
+            if (write(fd, "\n", 1) == 1) j->length += 1;
+        }
+    }
+
+    return j;
+}
+
+void editJournal_append(EditJournal *j, int32_t fileIndex, NSString *transUnitID, NSString *columnID, NSString *_Nullable oldValue, NSString *_Nullable newValue) {
+
+    /// Called for every `rowStore_setCellModel()`. Doesn't fsync – that happens once per user action in `editJournal_sync()`
+
+    if (j->fd == -1) return;
+
+    NSDictionary *entry = @{
+        @"file":    j->filePaths[fileIndex],
+        @"id":      transUnitID ?: @"",
+        @"column":  columnID,
+        @"old":     oldValue ?: (id)[NSNull null],
+        @"new":     newValue ?: (id)[NSNull null],
+    };
+    NSError *err = nil;
+    NSMutableData *line = [[NSJSONSerialization dataWithJSONObject: entry options: 0 error: &err] mutableCopy];
+    if (!line) {
+        mflog(@"Couldn't encode journal entry %@: %@", entry, err);
+        return;
+    }
+    [line appendBytes: "\n" length: 1];
+
+    const char *bytes = line.bytes;
+    NSUInteger written = 0;
+    while (written < line.length) { /// O_APPEND, so a single `write()` lands at the end as one piece. The loop is only for short writes.
+        ssize_t n = write(j->fd, bytes + written, line.length - written);
+        if (n == -1 && errno == EINTR) continue;
+        if (n == -1) {
+            mflog(@"Writing to journal failed (%s) – this edit will only be saved by the next flush", strerror(errno));
+            break;
+        }
+        written += n;
+    }
+    j->length += written;
+    j->needsSync = YES;
+}
+
+void editJournal_sync(EditJournal *j) {
+
+    /// Makes the appended entries durable. Call once per user action (`writeTranslationDataToFile`), not per cell.
+
+    if (j->fd == -1 || !j->needsSync) return;
+    if (fsync(j->fd) == -1) mflog(@"fsync of journal failed (%s)", strerror(errno));
+    j->needsSync = NO;
+}
+
+void editJournal_truncate(EditJournal *j, NSUInteger flushedLength) {
+
+    /// Empties the journal after a flush wrote everything up to `flushedLength` into the xliff.
+    ///     Does nothing if edits came in while the flush was running – those aren't in the xliff yet. The next flush will empty it. (Replaying already-flushed entries is harmless.)
+
+    if (j->fd == -1 || j->length != flushedLength || j->length == 0) return;
+    if (ftruncate(j->fd, 0) == -1) {
+        mflog(@"Truncating journal failed (%s)", strerror(errno));
+        return;
+    }
+    fsync(j->fd);
+    j->length = 0;
+    j->needsSync = NO;
+}
+
+void editJournal_close(EditJournal *j) {
+
+    /// Stops appending, but keeps the entries – for replaying them into a reverted document. [Oct 2026]
+
+    if (j->fd == -1) return;
+    close(j->fd);
+    j->fd = -1;
+}
+
+void editJournal_remove(EditJournal *j) {
+
+    /// Only call this once everything in the journal is in the xliff.
+
+    if (j->fd == -1) return;
+    close(j->fd);
+    j->fd = -1;
+    unlink(j->path.fileSystemRepresentation);
+}
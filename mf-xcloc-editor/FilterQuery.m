@@ -0,0 +1,202 @@
+//
+//  FilterQuery.m
+//  mf-xcloc-editor
+//
+//  Created by Noah Nübling on 10/17/26.
+//
+
+/// One filter pass of the table – its inputs, snapshotted on the main thread, and its results. [Oct 2026]
+///
+///     Why: The filter pass used to run on the main thread inside `bigUpdateAndStuff_OnlyUpdateSorting:`. On large documents a broad regex took long enough to drop keystrokes in the filterField.
+///     Now the filterField starts a query in the background (See `-[TableView _startFilterQuery]`). The query matches its candidates on all cores and sorts the matches – only the final list of rows comes back to the main thread.
+///     Cancelling: Every query has a generation. Starting a new one bumps the table's `_filterGeneration`, and running queries stop at their next chunk when they see that.
+///     Threads: `filterQuery_run()` only reads the snapshots below and the parts of the `RowStore` that never change (See `RowStore.m`).
+///     Part of the model so `xcloc-tool bench` times the same code the filterField runs (See `Bench.m`)
+
+@interface FilterQuery : NSObject
+    {
+        @public
+        NSUInteger generation;
+        NSArray<NSXMLElement *> *transUnits;            /// What the table shows when nothing is filtered
+        NSArray<NSXMLElement *> *candidates;            /// The rows that can match – `transUnits`, or the previous matches if we can narrow them down
+        NSString *filterString;
+        NSStringCompareOptions options;
+        NSRegularExpression *regex;                     /// `filterString` compiled once for the whole query. nil if it's not a regex or invalid.
+        BOOL onlyIssues;
+        
+        RowStore *store;                                /// nil if the rows don't belong to one – then the query isn't safe off the main thread
+        NSUInteger editCount;                           /// `store->editCount` at the time of the snapshot
+        NSRange storeRows;                              /// The rows of `store` that `transUnits` covers. Length 0 if they aren't contiguous.
+        NSArray *searchStrings;                         /// Copy of `store->searchStrings`
+        NSArray<NSString *> *targets;                   /// Copy of `store->targets` – to build the missing searchStrings
+        NSArray<NSString *> *displayNotes;              /// `store->displayNotes` – never changes once it's there. If it's nil, the notes are cleaned up on the way.
+        SearchIndex *searchIndex;
+        NSIndexSet *searchIndexDirtyRows;
+        NSData *issues;                                 /// Copy of `store->issues`. Only for `onlyIssues`.
+        NSArray<NSSortDescriptor *> *sortDescriptors;
+        NSData *sortKeys;                               /// See `rowStore_snapshotSortKeys()`. nil if the keys weren't built – then the table sorts on the main thread afterwards.
+        
+        NSArray<NSXMLElement *> *matches;               /// Result – document order
+        NSArray<NSXMLElement *> *sorted;                /// Result – `matches` sorted by `sortDescriptors`. nil if there were no `sortKeys`.
+        NSMapTable<NSXMLElement *, NSDictionary<NSString *, NSArray<NSValue *> *> *> *highlights; /// Result – transUnit -> `rowModel_filterHighlights()`, for the matches and their plural variants. Only the cells that have any. Found by the matching workers, so drawing a cell never runs the filter. (See `_getCellView()`)
+        NSMutableDictionary<NSNumber *, NSString *> *builtSearchStrings; /// row -> searchString that the query had to build. Cached in the `RowStore` when the results are shown.
+    }
+@end
+@implementation FilterQuery @end
+
+    static MFRowIssue _filterQuery_getIssues(FilterQuery *q, NSInteger row) { /// `rowStore_getIssues()` on the snapshot
+        if (!q->issues) return MFRowIssue_None;
+        const MFRowIssue *issues = q->issues.bytes;
+        MFRowIssue result = issues[row];
+        if (q->store->isPluralParent[row]) {
+            for (NSXMLElement *child in q->store->children[row]) {
+                NSInteger childRow;
+                if (rowStore_lookup(child, &childRow)) result |= issues[childRow];
+            }
+        }
+        return result;
+    }
+
+FilterQuery *FilterQuery_Make(NSArray<NSXMLElement *> *transUnits, NSString *filterString, NSStringCompareOptions options, BOOL onlyIssues) {
+    
+    /// Snapshots what a filter pass over `transUnits` needs, so it can run on any thread. Call it on the main thread.
+    ///     The caller sets the `generation` and narrows down the `candidates` if it can (See `-[TableView _makeFilterQuery]`)
+    
+    auto q = [FilterQuery new];
+    q->transUnits       = transUnits;
+    q->candidates       = transUnits;
+    q->filterString     = filterString;
+    q->options          = options;
+    q->onlyIssues       = onlyIssues;
+    q->regex            = rowModel_filterRegex(q->filterString, q->options); /// Once per query instead of once per row
+    if ((q->options & NSRegularExpressionSearch) && q->filterString.length && !q->regex)
+        mflog(@"Couldn't compile filter regex '%@' – nothing matches", q->filterString);
+    
+    NSInteger lo = -1, hi = -1;
+    RowStore *store = rowStore_lookup(q->transUnits.firstObject, &lo);
+    rowStore_lookup(q->transUnits.lastObject, &hi);
+    q->editCount = store ? store->editCount : 0;
+    
+    /// Snapshot the `RowStore`
+    ///     Only the @"target" column, the issues and the caches can change while the query runs. Copying them is a fraction of a millisecond per 10k rows.
+    if (store) {
+        q->store = store;
+        if (hi - lo + 1 == (NSInteger)q->transUnits.count) q->storeRows = NSMakeRange(lo, hi - lo + 1);
+        if (q->filterString.length) {
+            q->searchStrings        = [store->searchStrings copy];
+            q->targets              = [store->targets copy];
+            q->displayNotes         = store->displayNotes;
+            q->searchIndex          = store->searchIndex;
+            q->searchIndexDirtyRows = [store->searchIndexDirtyRows copy];
+        }
+        if (q->onlyIssues && store->issues)
+            q->issues = [NSData dataWithBytes: store->issues length: MAX(1, store->count) * sizeof(MFRowIssue)];
+    }
+    
+    return q;
+}
+
+BOOL filterQuery_run(FilterQuery *q, NSUInteger *_Nullable generation) {
+
+    /// Fills `q->matches` (and `q->sorted`). Thread-safe if `q->store` is set.
+    ///     `generation`: Returns NO as soon as it doesn't equal `q->generation` anymore – a newer query has started. Pass NULL for a query that can't be cancelled.
+
+    #define isCancelled() (generation && __atomic_load_n(generation, __ATOMIC_RELAXED) != q->generation)
+    #define kMFFilterChunkSize 1024 /// Rows per block on `dispatch_apply()`. Big enough that the blocks don't cost more than the matching, small enough to cancel quickly.
+
+    CFAbsoluteTime t0 = CFAbsoluteTimeGetCurrent();
+
+    NSArray<NSXMLElement *> *candidates = q->candidates;
+    q->builtSearchStrings = [NSMutableDictionary new];
+    q->highlights = [NSMapTable mapTableWithKeyOptions: NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality valueOptions: NSPointerFunctionsStrongMemory];
+
+    /// Ask the `SearchIndex` which rows can match
+    ///     Only works if `q->transUnits` is a contiguous range of rows in the `RowStore` – which is true for all the items in the `SourceList`.
+    if (q->filterString.length && candidates == q->transUnits && q->searchIndex && q->storeRows.length) {
+        NSIndexSet *indexHits = searchIndex_query(q->searchIndex, q->filterString, q->options);
+        if (indexHits) {
+            auto rows = [indexHits mutableCopy];
+            [rows addIndexes: q->searchIndexDirtyRows];
+            auto c = [NSMutableArray<NSXMLElement *> new];
+            [rows enumerateIndexesInRange: q->storeRows options: 0 usingBlock: ^(NSUInteger row, BOOL *stop) {
+                [c addObject: q->transUnits[row - q->storeRows.location]];
+            }];
+            mflog(@"SearchIndex narrowed %ld rows down to %ld", q->transUnits.count, c.count);
+            candidates = c;
+        }
+    }
+    if (isCancelled()) return NO;
+
+    /// Match
+    ///     In chunks on all cores. Each block only writes its own part of `isMatch`.
+    ///     The matches' `highlights` are found right here too – while the compiled regex and the snapshots are at hand, and off the main thread. [Oct 2026]
+    ///     Without a store, the searchStrings are built from the live xml – then only on this thread.
+    NSInteger n = candidates.count;
+    BOOL *isMatch = calloc(MAX(1, n), sizeof(BOOL));
+    NSInteger chunkCount = (n + kMFFilterChunkSize - 1) / kMFFilterChunkSize;
+    void (^matchChunk)(size_t) = ^(size_t chunk) {
+        if (isCancelled()) return;
+        @autoreleasepool {
+            auto built = [NSMutableDictionary<NSNumber *, NSString *> new];
+            auto highlighted = [NSMutableArray new]; /// transUnit, highlights, transUnit, highlights, ...
+            NSInteger end = MIN(n, (NSInteger)(chunk + 1) * kMFFilterChunkSize);
+            for (NSInteger i = chunk * kMFFilterChunkSize; i < end; i++) {
+                
+                NSXMLElement *transUnit = candidates[i];
+                
+                { /// Validate
+                    assert(isclass(transUnit, NSXMLElement));
+                    assert([transUnit.name isEqual: @"trans-unit"]);
+                }
+                
+                NSInteger row = -1;
+                RowStore *s = rowStore_lookup(transUnit, &row);
+                
+                if (s && s->parentRow[row] != -1)
+                    continue; /// Skip child variants - they'll be shown as children of their parent
+                
+                if (q->onlyIssues && !(s ? _filterQuery_getIssues(q, row) : MFRowIssue_None))
+                    continue; /// Cheap – so before the string matching
+                
+                if (!q->filterString.length) { isMatch[i] = YES; continue; }
+                
+                id searchString = s ? q->searchStrings[row] : nil; /// Cached in the `RowStore` – building these was the main cost of filtering large documents. The cache is cleared when the @"target" changes.
+                if (!searchString || searchString == [NSNull null]) {
+                    searchString = _rowModel_makeSearchString(transUnit, q->targets, q->displayNotes);
+                    if (s) built[@(row)] = searchString;
+                }
+                isMatch[i] = rowModel_searchStringMatches(searchString, q->filterString, q->options, q->regex);
+                if (!isMatch[i]) continue;
+                
+                for (NSXMLElement *t in [@[transUnit] arrayByAddingObjectsFromArray: rowModel_getChildren(transUnit)]) {
+                    auto h = rowModel_filterHighlights(t, q->targets, q->displayNotes, q->filterString, q->options, q->regex);
+                    if (h) [highlighted addObjectsFromArray: @[t, h]];
+                }
+            }
+            if (built.count) @synchronized (q->builtSearchStrings) { [q->builtSearchStrings addEntriesFromDictionary: built]; }
+            if (highlighted.count) @synchronized (q->highlights) {
+                for (NSInteger j = 0; j < (NSInteger)highlighted.count; j += 2) [q->highlights setObject: highlighted[j + 1] forKey: highlighted[j]];
+            }
+        }
+    };
+    if (q->store) dispatch_apply(chunkCount, DISPATCH_APPLY_AUTO, matchChunk);
+    else          for (NSInteger chunk = 0; chunk < chunkCount; chunk++) matchChunk(chunk);
+    if (isCancelled()) { free(isMatch); return NO; }
+
+    auto matches = [NSMutableArray<NSXMLElement *> new];
+    for (NSInteger i = 0; i < n; i++) if (isMatch[i]) [matches addObject: candidates[i]];
+    free(isMatch);
+    q->matches = matches;
+
+    mflog(@"Filtered %ld candidates on %ld chunks in %.2f ms – %ld matches", n, chunkCount, (CFAbsoluteTimeGetCurrent() - t0) * 1000, matches.count);
+
+    /// Sort
+    if (q->sortKeys) {
+        q->sorted = sortKeys_sortRows(q->sortKeys, q->sortDescriptors.count, matches);
+        if (isCancelled()) return NO;
+    }
+
+    return YES;
+
+    #undef isCancelled
+}
@@ -0,0 +1,25 @@
+//
+//  Model.h
+//  mf-xcloc-editor
+//
+//  Created by Noah Nübling on 10/17/26.
+//
+
+/// The part of the unity build that only needs Foundation and libxml2 – loading, querying, editing and saving xliffs. [Oct 2026]
+///     Included by the app (`main.m`) and by the command-line tool (`xcloc-tool/main.m`). Keep AppKit out of everything in here.
+///     Shared utilities that do need AppKit are behind `#if !MF_HEADLESS` (See `Utility.h`, `RowUtils.h`)
+
+#include "StringTable.m"
+#include "RowStore.h"
+#include "RowUtils.h"       /// Depends on RowStore
+#include "EditJournal.m"    /// RowStore.m depends on editJournal_append()
+#include "SortKeys.m"       /// RowStore.m depends on sortKeys_targetDidChange()
+#include "SearchIndex.m"
+#include "TranslationMemory.m" /// Depends on SearchIndex's trigrams. RowStore.m depends on translationMemory_add()
+#include "Validator.m"      /// RowStore.m depends on rowStore_validateAll()
+#include "RowStore.m"
+#include "FilterQuery.m"    /// Depends on RowStore, SearchIndex and SortKeys
+#include "Xliff.m"
+#include "XliffMerge.m"   /// Depends on Xliff
+#include "XclocPackage.m"
+#include "XclocProject.m"  /// Depends on XclocPackage
@@ -0,0 +1,269 @@
+//
+//  RowHeights.m
+//  mf-xcloc-editor
+//
+//  Created by Noah Nübling on 10/17/26.
+//
+
+/// Exact row heights for the `TableView`, measured ahead of time [Oct 2026]
+///
+///     Before, the table used `usesAutomaticRowHeights` and we returned a guessed `_defaultRowHeight` from `heightOfRowByItem:` – the real heights were only known once a row's views were laid out.
+///         That made rows jump while scrolling up, made every `reloadData` forget all heights, and made restoring the selection after a reload a retry-loop hidden behind a fade (See `TableRowView -setFrame:` and `__restorePosition()` in the git history).
+///
+///     Now we measure the text of each cell with the same fonts, widths and line-breaking as the cell, and add up the insets from `ReusableViews.xib`. That's cheap enough to do for every row – in the background.
+///         The rows that are on screen are measured right away on the main thread, the rest follows in a background pass (See `rowHeights_measureInBackground()`).
+///         The background pass also finds the rows and their flags itself, from the displayed top-level rows – walking the outlineView's rows on the main thread took as long as measuring them.
+///
+///     Cache: Text heights are cached by (text, font, width, lineBreakMode) – so filtering, sorting, switching files and edits in other rows are mostly cache hits. Only edited rows and resized columns miss.
+///     Threads: `-[NSAttributedString boundingRectWithSize:options:]` is safe to use off the main thread. Everything else that touches the table is main-thread only.
+///
+///     Keep the insets in sync with `ReusableViews.xib`:
+
+#define kRowHeights_CellInsetV          8.0     /// Top and bottom constraint of all table cells
+#define kRowHeights_CellInsetH          4.0     /// Leading + trailing constraint of `theReusableCell_Table` and `theReusableCell_TableTarget`
+#define kRowHeights_TextFieldPaddingH   4.0     /// NSTextFieldCell insets its text by 2 on each side
+#define kRowHeights_IDStackSpacing      5.0     /// Spacing of both stackViews in `theReusableCell_TableID`
+#define kRowHeights_QuickLookButtonW    20.0
+#define kRowHeights_QuickLookButtonH    16.0
+#define kRowHeights_MaxCachedWidths     12      /// Text-height buckets to keep – one per (font, width, lineBreakMode). Old widths are dropped when columns are resized a lot.
+
+typedef NS_OPTIONS(uint8_t, RowHeightsFlags) {
+    RowHeightsFlags_ShowsFilename  = 1 << 0,    /// `filename-field` of the @"id" cell is visible
+    RowHeightsFlags_ShowsQuickLook = 1 << 1,    /// `quick-look-button` of the @"id" cell is visible
+};
+
+typedef struct {
+    CGFloat idWidth;        /// Cell widths of a top-level row (`frameOfCellAtColumn:row:`)
+    CGFloat sourceWidth;
+    CGFloat targetWidth;
+    CGFloat noteWidth;
+    CGFloat indentationPerLevel;
+} RowHeightsLayout;
+
+@interface RowHeights : NSObject
+    {
+        @public
+        NSFont *textFont;                                                       /// Font of the textFields of all cells (`cellTitle` in IB)
+        NSFont *filenameFont;
+        dispatch_queue_t queue;                                                 /// Serial. Background passes run here.
+        NSMapTable<NSXMLElement *, NSNumber *> *heights;                        /// Main thread only. Pointer-keyed. Pruned to the displayed rows by each complete pass, so rows of old files and replaced xliffs don't stay around.
+        NSUInteger generation;                                                  /// Bumped by each background pass, so a stale pass stops early and doesn't overwrite newer results. Written on the main thread only.
+        BOOL isMeasuring;                                                       /// Main thread only. A background pass is pending.
+        NSHashTable<NSXMLElement *> *forgottenDuringPass;                       /// Main thread only. Rows edited while a background pass runs – its results for them are outdated.
+        os_unfair_lock cacheLock;
+        NSMutableDictionary<NSString *, NSMutableDictionary<NSString *, NSNumber *> *> *textHeights; /// bucket -> text -> height || Guarded by `cacheLock`
+        NSMutableArray<NSString *> *bucketLRU;                                 /// Guarded by `cacheLock`
+    }
+@end
+@implementation RowHeights @end
+
+RowHeights *RowHeights_Make(NSFont *textFont, NSFont *filenameFont) {
+    auto rh = [RowHeights new];
+    rh->textFont = textFont;
+    rh->filenameFont = filenameFont;
+    rh->queue = dispatch_queue_create("com.nuebling.mf-xcloc-editor.row-heights", dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_USER_INITIATED, 0));
+    rh->forgottenDuringPass = [NSHashTable hashTableWithOptions: NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality];
+    rh->heights = [NSMapTable mapTableWithKeyOptions: NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality valueOptions: NSPointerFunctionsStrongMemory];
+    rh->cacheLock = OS_UNFAIR_LOCK_INIT;
+    rh->textHeights = [NSMutableDictionary new];
+    rh->bucketLRU = [NSMutableArray new];
+    return rh;
+}
+
+#pragma mark - Measuring
+
+    static CGFloat _rowHeights_lineHeight(NSFont *font) {
+        return ceil(font.ascender - font.descender + font.leading);
+    }
+
+    static CGFloat _rowHeights_textHeight(RowHeights *rh, NSString *text, NSFont *font, CGFloat width, NSLineBreakMode lineBreakMode) {
+
+        /// Height of `text` wrapped to `width`. Any thread.
+
+        width = MAX(1.0, round(width * 2.0) / 2.0);
+        if (!text.length) return _rowHeights_lineHeight(font); /// Empty textFields are still one line tall
+
+        NSString *bucketKey = stringf(@"%@ %.1f %.1f %ld", font.fontName, font.pointSize, width, (long)lineBreakMode);
+
+        os_unfair_lock_lock(&rh->cacheLock);
+        NSNumber *cached = rh->textHeights[bucketKey][text];
+        os_unfair_lock_unlock(&rh->cacheLock);
+        if (cached) return cached.doubleValue;
+
+        NSMutableParagraphStyle *p = [NSMutableParagraphStyle new];
+        p.lineBreakMode = lineBreakMode;
+        p.lineBreakStrategy = NSLineBreakStrategyNone; /// Same as the cells (See `_getCellView()`)
+        NSRect r = [[[NSAttributedString alloc] initWithString: text attributes: @{
+            NSFontAttributeName: font,
+            NSParagraphStyleAttributeName: p,
+        }] boundingRectWithSize: NSMakeSize(width, CGFLOAT_MAX) options: NSStringDrawingUsesLineFragmentOrigin | NSStringDrawingUsesFontLeading];
+        CGFloat height = MAX(ceil(r.size.height), _rowHeights_lineHeight(font));
+
+        os_unfair_lock_lock(&rh->cacheLock);
+        if (!rh->textHeights[bucketKey]) {
+            rh->textHeights[bucketKey] = [NSMutableDictionary new];
+            [rh->bucketLRU addObject: bucketKey];
+            while (rh->bucketLRU.count > kRowHeights_MaxCachedWidths) {
+                [rh->textHeights removeObjectForKey: rh->bucketLRU.firstObject];
+                [rh->bucketLRU removeObjectAtIndex: 0];
+            }
+        }
+        else if (![rh->bucketLRU.lastObject isEqual: bucketKey]) {
+            [rh->bucketLRU removeObject: bucketKey];
+            [rh->bucketLRU addObject: bucketKey];
+        }
+        rh->textHeights[bucketKey][text] = @(height);
+        os_unfair_lock_unlock(&rh->cacheLock);
+
+        return height;
+    }
+
+    static NSString *_rowHeights_getUIString(NSXMLElement *item, NSString *columnID, NSArray<NSString *> *_Nullable targets) {
+
+        /// `rowModel_getUIString()` for any thread – pass a snapshot of the @"target" column when off the main thread. (The @"state" column doesn't affect the height.)
+
+        NSInteger row;
+        RowStore *store = rowStore_lookup(item, &row);
+        NSString *cellModel;
+        if ((0)) {}
+            else if (!store)                                    cellModel = rowModel_getCellModel(item, columnID);
+            else if ([columnID isEqual: @"note"])               cellModel = NSThread.isMainThread ? rowModel_getDisplayNote(item) : stringTable_displayNote(store->strings, rowStore_getCellModel(store, row, @"note"), _rowModel_cleanUpNote);
+            else if ([columnID isEqual: @"target"] && targets)  cellModel = targets[row] == (id)[NSNull null] ? nil : targets[row];
+            else                                                cellModel = rowStore_getCellModel(store, row, columnID);
+        return _rowModel_getUIString_FromCellModel(item, columnID, cellModel) ?: @"";
+    }
+
+    static CGFloat _rowHeights_measureRow(RowHeights *rh, NSXMLElement *item, NSInteger level, RowHeightsFlags flags, RowHeightsLayout layout, NSArray<NSString *> *_Nullable targets) {
+
+        /// Height of the tallest cell in the row. Any thread.
+
+        CGFloat lineH = _rowHeights_lineHeight(rh->textFont);
+        CGFloat result = kRowHeights_CellInsetV + lineH + kRowHeights_CellInsetV; /// Single-line cell – also covers the @"state" badge
+
+        /// @"id"
+        ///     The textField sits in a vertical stack with the `filename-field`, which sits in a horizontal stack with the `quick-look-button`. Hidden views are detached from the stacks. The stack is inset by 2 on the leading edge and -2 on the trailing edge.
+        {
+            CGFloat w = layout.idWidth - level * layout.indentationPerLevel - kRowHeights_TextFieldPaddingH;
+            if (flags & RowHeightsFlags_ShowsQuickLook) w -= kRowHeights_QuickLookButtonW + kRowHeights_IDStackSpacing;
+            CGFloat h = _rowHeights_textHeight(rh, _rowHeights_getUIString(item, @"id", targets), rh->textFont, w, NSLineBreakByCharWrapping);
+            if (flags & RowHeightsFlags_ShowsFilename)  h += kRowHeights_IDStackSpacing + _rowHeights_lineHeight(rh->filenameFont);
+            if (flags & RowHeightsFlags_ShowsQuickLook) h = MAX(h, kRowHeights_QuickLookButtonH);
+            result = MAX(result, kRowHeights_CellInsetV + h + kRowHeights_CellInsetV);
+        }
+
+        /// @"source", @"target", @"note"
+        struct { NSString *columnID; CGFloat width; } cols[] = {
+            { @"source", layout.sourceWidth },
+            { @"target", layout.targetWidth },
+            { @"note",   layout.noteWidth   },
+        };
+        for (int i = 0; i < 3; i++) {
+            CGFloat w = cols[i].width - kRowHeights_CellInsetH - kRowHeights_TextFieldPaddingH;
+            CGFloat h = _rowHeights_textHeight(rh, _rowHeights_getUIString(item, cols[i].columnID, targets), rh->textFont, w, NSLineBreakByWordWrapping);
+            result = MAX(result, kRowHeights_CellInsetV + h + kRowHeights_CellInsetV);
+        }
+
+        return result;
+    }
+
+#pragma mark - Interface
+
+CGFloat rowHeights_get(RowHeights *rh, NSXMLElement *item) {
+
+    /// 0 if the row hasn't been measured yet
+
+    return [[rh->heights objectForKey: item] doubleValue];
+}
+
+void rowHeights_forget(RowHeights *rh, NSXMLElement *item) {
+
+    /// Call when the text of `item` changed. The next pass that includes it measures it again – it's 0 until then.
+
+    [rh->heights removeObjectForKey: item];
+    [rh->forgottenDuringPass addObject: item];
+}
+
+void rowHeights_measure(RowHeights *rh, NSArray<NSXMLElement *> *items, NSInteger *levels, RowHeightsFlags *flags, RowHeightsLayout layout, void (^onChange)(NSIndexSet *changedIndexes)) {
+
+    /// Measures `items` right away and calls `onChange` with the indexes (into `items`) whose height changed. Main thread only.
+    ///     `levels` and `flags` are parallel to `items`. For the few rows on screen – doesn't affect a background pass.
+
+    assert(NSThread.isMainThread);
+
+    auto changed = [NSMutableIndexSet new];
+    for (NSInteger i = 0; i < (NSInteger)items.count; i++) {
+        CGFloat h = _rowHeights_measureRow(rh, items[i], levels[i], flags[i], layout, nil);
+        if (h != rowHeights_get(rh, items[i])) {
+            [rh->heights setObject: @(h) forKey: items[i]];
+            [changed addIndex: i];
+        }
+    }
+    if (changed.count) onChange(changed);
+}
+
+void rowHeights_measureInBackground(RowHeights *rh, NSArray<NSXMLElement *> *topLevelItems, BOOL isComplete, RowHeightsFlags (^getFlags)(NSXMLElement *item), RowHeightsLayout layout, void (^onChange)(NSArray<NSXMLElement *> *changedItems)) {
+
+    /// Measures `topLevelItems` and their children on `rh->queue`, and calls `onChange` on the main thread with the items whose height changed. Main thread only.
+    ///     `getFlags` is called on `rh->queue` – it must only read things that don't change while the table is shown.
+    ///     `isComplete`: `topLevelItems` are all the displayed rows. Then the heights of everything else are dropped afterwards.
+    ///         Otherwise, they're just the rows that are new or were forgotten. Don't start one of those while `rh->isMeasuring` – it cancels the pending pass, and that pass's rows would never be measured.
+
+    assert(NSThread.isMainThread);
+    assert(isComplete || !rh->isMeasuring);
+
+    NSUInteger generation = __atomic_add_fetch(&rh->generation, 1, __ATOMIC_RELAXED);
+    [rh->forgottenDuringPass removeAllObjects];
+    rh->isMeasuring = YES;
+
+    /// Snapshot
+    RowStore *store = rowStore_lookup(topLevelItems.firstObject, NULL);
+    NSArray<NSString *> *targets = store ? [store->targets copy] : nil; /// Only the @"target" column can change while we're in the background.
+    NSArray<NSXMLElement *> *topLevelCopy = [topLevelItems copy];
+
+    dispatch_async(rh->queue, ^{
+
+        CFAbsoluteTime t0 = CFAbsoluteTimeGetCurrent();
+
+        /// Same rows as the outlineView – everything is expanded (See `-[TableView reloadData]`)
+        auto items = [NSMutableArray<NSXMLElement *> arrayWithCapacity: topLevelCopy.count];
+        for (NSXMLElement *item in topLevelCopy) {
+            [items addObject: item];
+            [items addObjectsFromArray: rowModel_getChildren(item)];
+        }
+
+        NSInteger n = items.count;
+        CGFloat *results = malloc(MAX(1, n) * sizeof(CGFloat));
+        for (NSInteger i = 0; i < n; i++) {
+            if ((i & 1023) == 0 && __atomic_load_n(&rh->generation, __ATOMIC_RELAXED) != generation) { /// A newer pass started
+                free(results);
+                return;
+            }
+            @autoreleasepool {
+                NSInteger level = rowModel_getParent(items[i]) ? 1 : 0;
+                results[i] = _rowHeights_measureRow(rh, items[i], level, getFlags(items[i]), layout, targets);
+            }
+        }
+
+        mflog(@"Measured %ld row heights in %.0f ms", n, (CFAbsoluteTimeGetCurrent() - t0) * 1000);
+
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (rh->generation == generation) {
+                rh->isMeasuring = NO;
+                auto newHeights = isComplete ? [NSMapTable mapTableWithKeyOptions: NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality valueOptions: NSPointerFunctionsStrongMemory] : rh->heights;
+                auto changed = [NSMutableArray<NSXMLElement *> new];
+                for (NSInteger i = 0; i < n; i++) {
+                    NSNumber *old = [rh->heights objectForKey: items[i]];
+                    if ([rh->forgottenDuringPass containsObject: items[i]]) { /// Measured from the old @"target" – leave it to the synchronous pass
+                        if (old) [newHeights setObject: old forKey: items[i]];
+                        continue;
+                    }
+                    [newHeights setObject: @(results[i]) forKey: items[i]];
+                    if (!old || old.doubleValue != results[i]) [changed addObject: items[i]];
+                }
+                rh->heights = newHeights;
+                if (changed.count) onChange(changed);
+            }
+            free(results);
+        });
+    });
+}
@@ -0,0 +1,109 @@
+//
+//  RowStore.h
+//  mf-xcloc-editor
+//
+//  Created by Noah Nübling on 10/17/26.
+//
+
+    typedef NS_ENUM(uint8_t, MFTransUnitState) { /// Same order as `_stateOrder` [Oct 2026]
+        MFTransUnitState_New,
+        MFTransUnitState_NeedsReview,
+        MFTransUnitState_Translated,
+        MFTransUnitState_DontTranslate,
+        MFTransUnitState_Unknown,       /// Raw string is kept in `unknownStates` so we don't lose it.
+    };
+
+    typedef NS_OPTIONS(uint8_t, MFRowIssue) { /// Found by `Validator.m` [Oct 2026]
+        MFRowIssue_None                 = 0,
+        MFRowIssue_MissingSpecifier     = 1 << 0,   /// Source has a format specifier that the target doesn't
+        MFRowIssue_ExtraSpecifier       = 1 << 1,   /// Target has a format specifier that the source doesn't – reads an argument that isn't there
+        MFRowIssue_MismatchedSpecifier  = 1 << 2,   /// Same argument, different type (`%@` vs `%d`) – crashes
+        MFRowIssue_PluralVariable       = 1 << 3,   /// A `%#@var@` was removed or renamed – the variants can't be found anymore
+        MFRowIssue_EmptyVariant         = 1 << 4,   /// A pluralizable variant has no target, while its siblings do
+    };
+
+    typedef struct { NSInteger translated; NSInteger total; } MFProgress; /// Plural parents aren't counted – their variants are. (See `stateOfRowModel:`)
+
+    @class SearchIndex;
+    @class EditJournal;
+    @class StringTable;
+    @class SortKeyColumn;
+    @class TranslationMemory;
+
+    @interface RowStore : NSObject
+        {
+            @public
+            NSInteger count;
+            NSInteger _capacity;
+
+            /// Columns
+            ///     One array per column, indexed by `row`. Missing values (e.g. no `<note>`) are stored as NSNull. [Oct 2026]
+            NSMutableArray<NSString *> *ids;
+            NSMutableArray<NSString *> *sources;
+            NSMutableArray<NSString *> *targets;
+            NSMutableArray<NSString *> *notes;
+            MFTransUnitState *states;
+            int32_t *fileIndexes;                                           /// Index of the `<file>` in the xliff (Not the index in `SourceList->files` – that one has the extra `kMFPath_AllDocuments` and `@"separator"` items)
+            NSInteger *fileStartRows;                                       /// First row of each file. The rows of a file are contiguous (document order), so a row's position within its file is `row - fileStartRows[fileIndexes[row]]` (See `rowStore_getRowInFile()`) [Oct 2026]
+            NSInteger *parentRow;                                           /// -1 for non-variants
+            bool *isPluralParent;
+            NSMutableDictionary<NSNumber *, NSString *> *unknownStates;
+
+            /// Progress
+            ///     Counted once in `rowStore_finish()`, then kept up to date by `rowStore_setCellModel()` – so showing the progress of a file is O(1), no matter how many rows it has. [Oct 2026]
+            MFProgress *progressByFile;                                     /// Indexed like `fileIndexes`
+            MFProgress progress;                                            /// All files
+            NSInteger fileCount;
+
+            /// Validation
+            ///     Filled by `rowStore_validateAll()` in `rowStore_finish()`, then kept up to date by `rowStore_validateRow()` – same as the progress. (See `Validator.m`) [Oct 2026]
+            MFRowIssue *issues;                                             /// Per row. Plural parents only have their own issues here – see `rowStore_getIssues()` for what they show.
+            NSInteger *issueCountByFile;                                    /// Rows with issues. Indexed like `fileIndexes`
+            bool *fileHasFormatStrings;                                     /// Per file. Only `.strings`, `.stringsdict` and `.xcstrings` go through `String(format:)` – the specifiers of the others (IB, Info.plist) aren't checked. Indexed like `fileIndexes`
+            NSInteger issueCount;                                           /// All files
+
+            /// Relationships
+            NSArray<NSArray<NSXMLElement *> *> *children;                   /// Pluralizable variants of each row. Empty array for non-parents.
+            NSArray<NSDictionary<NSString *, NSNumber *> *> *rowForID;      /// One dict per `<file>`. ids are only unique within a file (e.g. `CFBundleName` appears in every `InfoPlist.strings`) [Oct 2026]
+
+            /// Caches
+            ///     Filled lazily by `TableView.m`, cleared by `rowStore_setCellModel()` [Oct 2026]
+            NSMutableArray<NSString *> *searchStrings;                      /// See `_rowModel_makeSearchString()`. NSNull until computed. Filled by the filter pass (See `filterQuery_run()`) and `_buildRowStoreCachesInBackground()`.
+            NSMutableIndexSet *unsavedRows;                                 /// Rows edited since the last save. Lets `xliff_serialize()` write back only what changed.
+            NSUInteger editCount;                                           /// Bumped on every edit. Lets callers tell whether results derived from the store are stale.
+            NSArray<NSString *> *displayNotes;                              /// See `rowModel_getDisplayNote()`. nil until `_buildRowStoreCachesInBackground()` has filled it. Main thread only – the background job works on its own copy.
+            SearchIndex *searchIndex;                                       /// nil until `_buildRowStoreCachesInBackground()` finishes
+            BOOL isBuildingCaches;
+            NSMutableIndexSet *searchIndexDirtyRows;                        /// Top-level rows whose searchString changed after the `searchIndex` snapshot was taken. Always checked when filtering.
+            NSMutableDictionary<NSString *, SortKeyColumn *> *sortKeys;     /// columnID -> collated ranks. Built on demand by `rowStore_buildSortKeys()`, updated in place on edits. (See `SortKeys.m`)
+            NSMutableDictionary<NSString *, NSMutableArray *> *sortKeysWaiters; /// columnID -> completion blocks, while that column is building in the background
+            NSMutableIndexSet *sortKeysDirtyRows;                           /// Rows whose @"target" was edited while the @"target" sort keys were building
+            TranslationMemory *_Nullable translationMemory;                 /// nil until `_buildTranslationMemoryInBackground()` finishes. Then `rowStore_setCellModel()` swaps a row's pair whenever its translated target changes (See `translationMemory_update()`)
+            BOOL isBuildingTranslationMemory;
+
+            /// Sharing
+            StringTable *_Nullable strings;                                 /// ids, sources, notes and displayNotes are interned here – shared with the other languages of the project. nil for DOM-loaded xliffs. (See `StringTable.m`) [Oct 2026]
+
+            /// Persistence
+            EditJournal *_Nullable journal;                                 /// Set by `XclocDocument` once the journal is open. Every edit is appended to it in `rowStore_setCellModel()` [Oct 2026]
+
+            /// DOM back-pointers
+            ///     Only needed to write edits back into the `NSXMLDocument` (See `_rowModel_setCellModel`) – Reading should always go through the columns. [Oct 2026]
+            NSArray<NSXMLElement *> *transUnits;
+        }
+    @end
+
+    RowStore *RowStore_Make(NSArray<NSArray<NSXMLElement *> *> *transUnitsByFile, NSArray<NSString *> *filePaths);
+    RowStore *RowStore_Begin(void);
+    void rowStore_append(RowStore *s, NSXMLElement *transUnit, int32_t fileIndex, NSString *transUnitID, NSString *source, NSString *target, NSString *note, NSString *state);
+    void rowStore_finish(RowStore *s, NSArray<NSString *> *filePaths);
+    RowStore *_Nullable rowStore_lookup(NSXMLElement *transUnit, NSInteger *outRow);
+    NSString *rowStore_getCellModel(RowStore *store, NSInteger row, NSString *columnID);
+    void rowStore_setCellModel(RowStore *store, NSInteger row, NSString *columnID, NSString *newValue);
+    MFProgress rowStore_getProgress(RowStore *store, NSInteger fileIndex);
+    NSInteger rowStore_getRowInFile(RowStore *store, NSInteger row);
+    void rowStore_replaceTransUnit(RowStore *store, NSInteger row, NSXMLElement *transUnit);
+    void rowStore_validateAll(RowStore *store);
+    void rowStore_validateRow(RowStore *store, NSInteger row);
+    MFRowIssue rowStore_getIssues(RowStore *store, NSInteger row);
+    NSInteger rowStore_getIssueCount(RowStore *store, NSInteger fileIndex);
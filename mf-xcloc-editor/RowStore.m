@@ -0,0 +1,319 @@
+//
+//  RowStore.m
+//  mf-xcloc-editor
+//
+//  Created by Noah Nübling on 10/17/26.
+//
+
+/// Flat, column-wise copy of the transUnits of the loaded xliff. Built once by the loaders in `Xliff.m` [Oct 2026]
+///
+/// Why:
+///     - Filtering, sorting, progress-counting and cell-rendering all go through `rowModel_getCellModel()`. Before this, every call walked the children of the `NSXMLElement` by name and boxed a new NSString – a single sort on 40k rows did millions of DOM walks.
+///     - `bigUpdateAndStuff_OnlyUpdateSorting:` also rebuilt the plural parent/child map on every filter-keystroke and every file-switch, scanning all transUnits for every `|==|` child. That's quadratic and blocked the main thread for seconds.
+///
+/// Invalidation:
+///     We only ever edit @"target" and @"state", and those edits go through `_rowModel_setCellModel()`, which updates the DOM and the store together.
+///     Everything else (ids, sources, parent/child relationships) can only change when the xml is reloaded – which always builds a new store.
+///
+/// Terminology: A `row` is the index of a transUnit inside the store's columns. (Not to be confused with the rows of the `TableView`) [Oct 2026]
+
+@interface RowStoreRef : NSObject
+    {
+        /// Attached to each transUnit, so the `rowModel_` functions in `RowUtils.h` can find the store without taking extra args. [Oct 2026]
+        @public
+        __weak RowStore *store; /// Weak – transUnits can outlive the store in the undo stack after a revert.
+        NSInteger row;
+    }
+@end
+@implementation RowStoreRef @end
+
+static char kRowStoreRefKey = 0;
+
+@implementation RowStore
+
+    - (void) dealloc {
+        free(self->states);
+        free(self->fileIndexes);
+        free(self->parentRow);
+        free(self->isPluralParent);
+        free(self->progressByFile);
+        free(self->issues);
+        free(self->issueCountByFile);
+        free(self->fileHasFormatStrings);
+        free(self->fileStartRows);
+    }
+
+@end
+
+#pragma mark - State enum
+
+    static MFTransUnitState MFTransUnitState_FromString(NSString *state) {
+        if ((0)) {}
+        else if ([state isEqual: kMFTransUnitState_New])            return MFTransUnitState_New;
+        else if ([state isEqual: kMFTransUnitState_NeedsReview])    return MFTransUnitState_NeedsReview;
+        else if ([state isEqual: kMFTransUnitState_Translated])     return MFTransUnitState_Translated;
+        else if ([state isEqual: kMFTransUnitState_DontTranslate])  return MFTransUnitState_DontTranslate;
+        else                                                        return MFTransUnitState_Unknown;
+    }
+    static NSString *MFTransUnitState_ToString(RowStore *store, NSInteger row) {
+        switch (store->states[row]) {
+            case MFTransUnitState_New:              return kMFTransUnitState_New;
+            case MFTransUnitState_NeedsReview:      return kMFTransUnitState_NeedsReview;
+            case MFTransUnitState_Translated:       return kMFTransUnitState_Translated;
+            case MFTransUnitState_DontTranslate:    return kMFTransUnitState_DontTranslate;
+            case MFTransUnitState_Unknown:          return store->unknownStates[@(row)];
+        }
+    }
+
+#pragma mark - Building
+
+    /// Building happens in 3 steps, so loaders can fill the store while they're still parsing (See `Xliff.m`) [Oct 2026]
+    ///     `RowStore_Begin()` -> `rowStore_append()` for each transUnit in document order -> `rowStore_finish()`
+
+RowStore *RowStore_Begin(void) {
+    
+    auto s = [RowStore new];
+    s->ids              = [NSMutableArray new];
+    s->sources          = [NSMutableArray new];
+    s->targets          = [NSMutableArray new];
+    s->notes            = [NSMutableArray new];
+    s->unknownStates    = [NSMutableDictionary new];
+    s->searchStrings    = [NSMutableArray new];
+    s->searchIndexDirtyRows = [NSMutableIndexSet new];
+    s->sortKeysDirtyRows = [NSMutableIndexSet new];
+    s->unsavedRows      = [NSMutableIndexSet new];
+    s->transUnits       = [NSMutableArray new];
+    return s;
+}
+
+void rowStore_append(RowStore *s, NSXMLElement *transUnit, int32_t fileIndex, NSString *transUnitID, NSString *source, NSString *target, NSString *note, NSString *state) {
+    
+    /// Values should already be normalized the way `_rowModel_getCellModel_DOM()` returns them. [Oct 2026]
+    
+    NSInteger row = s->count;
+    
+    if (row == s->_capacity) { /// Grow the C columns
+        s->_capacity        = MAX(1024, s->_capacity * 2);
+        s->states           = realloc(s->states,         s->_capacity * sizeof(MFTransUnitState));
+        s->fileIndexes      = realloc(s->fileIndexes,    s->_capacity * sizeof(int32_t));
+        s->parentRow        = realloc(s->parentRow,      s->_capacity * sizeof(NSInteger));
+        s->isPluralParent   = realloc(s->isPluralParent, s->_capacity * sizeof(bool));
+    }
+    
+    #define orNull(x) ((x) ?: (id)[NSNull null])
+    
+    [s->ids     addObject: orNull(transUnitID)];
+    [s->sources addObject: orNull(source)];
+    [s->targets addObject: orNull(target)];
+    [s->notes   addObject: orNull(note)];
+    [s->searchStrings addObject: [NSNull null]];
+    s->states[row] = MFTransUnitState_FromString(state);
+    if (s->states[row] == MFTransUnitState_Unknown) s->unknownStates[@(row)] = state;
+    s->fileIndexes[row]    = fileIndex;
+    s->isPluralParent[row] = [source containsString: @"%#@"]; /// Detects the `%#@formatSstring@` of pluralizable strings
+    s->parentRow[row]      = -1;
+    
+    #undef orNull
+    
+    auto ref = [RowStoreRef new];
+    ref->store = s;
+    ref->row = row;
+    objc_setAssociatedObject(transUnit, &kRowStoreRefKey, ref, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    
+    [(NSMutableArray *)s->transUnits addObject: transUnit];
+    s->count++;
+}
+
+void rowStore_finish(RowStore *s, NSArray<NSString *> *filePaths) {
+    
+    /// `filePaths`: The `original` of each `<file>`, indexed like `fileIndexes`
+    
+    NSInteger n = s->count;
+    
+    /// Index the ids
+    auto rowForID = [NSMutableArray<NSMutableDictionary *> new];
+    for (NSInteger row = 0; row < n; row++) {
+        while (rowForID.count <= s->fileIndexes[row]) [rowForID addObject: [NSMutableDictionary new]];
+        auto d = rowForID[s->fileIndexes[row]];
+        NSString *transUnitID = s->ids[row];
+        if (d[transUnitID]) mflog(@"Duplicate transUnit id '%@' – using the first one", transUnitID); /// Xcode shouldn't export this [Oct 2026]
+        else                d[transUnitID] = @(row);
+    }
+    s->rowForID = rowForID;
+    
+    /// Link pluralizable variants to their parents
+    ///     The `|==|` separator is found in the ids of the variants. The part before it is the id of the parent, which is in the same `<file>`. [Oct 2026]
+    auto children = [NSMutableArray<NSMutableArray *> arrayWithCapacity: n];
+    for (NSInteger row = 0; row < n; row++) [children addObject: [NSMutableArray new]];
+    
+    for (NSInteger row = 0; row < n; row++) {
+        NSString *transUnitID = s->ids[row];
+        NSRange sep = [transUnitID rangeOfString: @"|==|"];
+        if (sep.location == NSNotFound) continue;
+        NSNumber *p = rowForID[s->fileIndexes[row]][[transUnitID substringToIndex: sep.location]];
+        if (!p) continue;
+        assert(s->isPluralParent[p.integerValue]); /// Make sure the `%#@` detection works.
+        s->parentRow[row] = p.integerValue;
+        [children[p.integerValue] addObject: s->transUnits[row]];
+    }
+    s->children = children;
+    
+    /// Find where each file starts
+    for (NSInteger row = 0; row < n; row++) s->fileCount = MAX(s->fileCount, s->fileIndexes[row] + 1);
+    s->fileStartRows = malloc(MAX(1, s->fileCount) * sizeof(NSInteger));
+    for (NSInteger row = n - 1; row >= 0; row--) {
+        assert(row == 0 || s->fileIndexes[row - 1] <= s->fileIndexes[row]); /// Loaders append file by file
+        s->fileStartRows[s->fileIndexes[row]] = row;
+    }
+    
+    /// Count progress
+    ///     Same rules as the `rowStore_setCellModel()` updates – plural parents don't count.
+    s->progressByFile = calloc(MAX(1, s->fileCount), sizeof(MFProgress));
+    for (NSInteger row = 0; row < n; row++) {
+        if (s->isPluralParent[row]) continue;
+        bool isTranslated = s->states[row] == MFTransUnitState_Translated;
+        s->progressByFile[s->fileIndexes[row]].translated += isTranslated;
+        s->progressByFile[s->fileIndexes[row]].total      += 1;
+        s->progress.translated += isTranslated;
+        s->progress.total      += 1;
+    }
+    
+    /// Validate
+    ///     Needs the plural relationships from above. (See `Validator.m`)
+    s->fileHasFormatStrings = calloc(MAX(1, s->fileCount), sizeof(bool));
+    for (NSInteger i = 0; i < s->fileCount && i < (NSInteger)filePaths.count; i++) {
+        NSString *ext = filePaths[i].pathExtension.lowercaseString;
+        s->fileHasFormatStrings[i] = [ext isEqual: @"strings"] || [ext isEqual: @"stringsdict"] || [ext isEqual: @"xcstrings"];
+    }
+    rowStore_validateAll(s);
+}
+
+RowStore *RowStore_Make(NSArray<NSArray<NSXMLElement *> *> *transUnitsByFile, NSArray<NSString *> *filePaths) {
+    
+    /// Build the store from `NSXMLElement`s that are part of a DOM.
+    ///     This is the only place (aside from the DOM fallback in `rowModel_getCellModel()`) that should read the `NSXMLElement`s. [Oct 2026]
+    
+    RowStore *s = RowStore_Begin();
+    for (int32_t fileIndex = 0; fileIndex < transUnitsByFile.count; fileIndex++) {
+        for (NSXMLElement *transUnit in transUnitsByFile[fileIndex]) {
+            rowStore_append(s, transUnit, fileIndex,
+                _rowModel_getCellModel_DOM(transUnit, @"id"),
+                _rowModel_getCellModel_DOM(transUnit, @"source"),
+                _rowModel_getCellModel_DOM(transUnit, @"target"),
+                _rowModel_getCellModel_DOM(transUnit, @"note"),
+                _rowModel_getCellModel_DOM(transUnit, @"state")
+            );
+        }
+    }
+    rowStore_finish(s, filePaths);
+    return s;
+}
+
+#pragma mark - Access
+
+RowStore *_Nullable rowStore_lookup(NSXMLElement *transUnit, NSInteger *outRow) {
+
+    /// Returns nil if the transUnit doesn't belong to a (live) store [Oct 2026]
+
+    if (!transUnit) return nil;
+    RowStoreRef *ref = objc_getAssociatedObject(transUnit, &kRowStoreRefKey);
+    if (!ref) return nil;
+    RowStore *store = ref->store;
+    if (store && outRow) *outRow = ref->row;
+    return store;
+}
+
+NSString *rowStore_getCellModel(RowStore *store, NSInteger row, NSString *columnID) {
+
+    /// Mirrors `_rowModel_getCellModel_DOM()` [Oct 2026]
+
+    id result = nil;
+    if ((0)) {}
+        else if ([columnID isEqual: @"id"])        result = store->ids[row];
+        else if ([columnID isEqual: @"source"])    result = store->sources[row];
+        else if ([columnID isEqual: @"target"])    result = store->targets[row];
+        else if ([columnID isEqual: @"note"])      result = store->notes[row];
+        else if ([columnID isEqual: @"state"])     result = MFTransUnitState_ToString(store, row);
+    else assert(false);
+
+    if (result == [NSNull null]) result = nil;
+    return result;
+}
+
+void rowStore_setCellModel(RowStore *store, NSInteger row, NSString *columnID, NSString *newValue) {
+
+    /// Only call this from `_rowModel_setCellModel()` so the DOM and the store stay in sync. [Oct 2026]
+
+    if (store->journal) /// Before touching anything, so we can record the old value
+        editJournal_append(store->journal, store->fileIndexes[row], store->ids[row], columnID, rowStore_getCellModel(store, row, columnID), newValue);
+
+    #define tmPair() (store->states[row] == MFTransUnitState_Translated && !store->isPluralParent[row] ? store->targets[row] : nil) /// What the row contributes to the translation memory
+    NSString *oldTMTarget = tmPair();
+
+    store->editCount++;
+    [store->unsavedRows addIndex: row];
+
+    if ((0)) {}
+        else if ([columnID isEqual: @"target"]) {
+            store->targets[row] = newValue ?: @""; /// Matches the `?: @""` in `_rowModel_getCellModel_DOM()`
+            store->searchStrings[row] = (id)[NSNull null];
+            if (store->parentRow[row] != -1) store->searchStrings[store->parentRow[row]] = (id)[NSNull null]; /// The parent's searchString contains the children's strings.
+            [store->searchIndexDirtyRows addIndex: store->parentRow[row] != -1 ? store->parentRow[row] : row];
+            sortKeys_targetDidChange(store, row);
+        }
+        else if ([columnID isEqual: @"state"]) {
+            newValue = newValue ?: kMFTransUnitState_New; /// No `state` attribute – matches the `?: kMFTransUnitState_New` in `_rowModel_getCellModel_DOM()`
+            if (!store->isPluralParent[row]) { /// Update progress by the delta (Also runs for undo/redo – those go through here, too)
+                NSInteger delta = (NSInteger)(MFTransUnitState_FromString(newValue) == MFTransUnitState_Translated) - (NSInteger)(store->states[row] == MFTransUnitState_Translated);
+                store->progressByFile[store->fileIndexes[row]].translated += delta;
+                store->progress.translated += delta;
+            }
+            store->states[row] = MFTransUnitState_FromString(newValue);
+            if (store->states[row] == MFTransUnitState_Unknown) store->unknownStates[@(row)] = newValue;
+            else                                                [store->unknownStates removeObjectForKey: @(row)];
+        }
+    else assert(false);
+
+    rowStore_validateRow(store, row); /// After both kinds of edits – `mf_dont_translate` rows aren't checked [Oct 2026]
+
+    NSString *newTMTarget = tmPair();
+    #undef tmPair
+    if (store->translationMemory && oldTMTarget != newTMTarget && ![oldTMTarget isEqual: newTMTarget]) /// Covers both orders of setting target and state. In the background – the MinHash is too slow for bulk edits on main. [Oct 2026]
+        translationMemory_update(store->translationMemory, store->sources[row], oldTMTarget, newTMTarget);
+}
+
+MFProgress rowStore_getProgress(RowStore *store, NSInteger fileIndex) {
+    
+    /// Pass -1 for all files. O(1) [Oct 2026]
+    
+    if (fileIndex == -1) return store->progress;
+    assert(0 <= fileIndex && fileIndex < store->fileCount);
+    return store->progressByFile[fileIndex];
+}
+
+NSInteger rowStore_getRowInFile(RowStore *store, NSInteger row) {
+    
+    /// Index of the row in `Xliff->transUnitsByFile[fileIndex]`. O(1) [Oct 2026]
+    
+    return row - store->fileStartRows[store->fileIndexes[row]];
+}
+
+void rowStore_replaceTransUnit(RowStore *store, NSInteger row, NSXMLElement *transUnit) {
+    
+    /// Makes `transUnit` the rowModel of `row`, instead of the one the loader made. Used by `xliff_merge()` so rows keep their identity across a re-export. [Oct 2026]
+    ///     The caller has to swap it into `Xliff->transUnitsByFile`, too.
+    
+    NSXMLElement *old = store->transUnits[row];
+    ((NSMutableArray *)store->transUnits)[row] = transUnit;
+    
+    if (store->parentRow[row] != -1) {
+        NSMutableArray *siblings = (id)store->children[store->parentRow[row]];
+        NSUInteger i = [siblings indexOfObjectIdenticalTo: old];
+        if (i != NSNotFound) siblings[i] = transUnit;
+    }
+    
+    auto ref = [RowStoreRef new];
+    ref->store = store;
+    ref->row = row;
+    objc_setAssociatedObject(transUnit, &kRowStoreRefKey, ref, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+}
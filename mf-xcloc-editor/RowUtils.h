@@ -15,7 +15,7 @@
     #define kMFTransUnitState_New             @"new"
     #define kMFTransUnitState_NeedsReview     @"needs-review-l10n"
     #define kMFTransUnitState_NeedsReview2    @"needs-translation" /// Saw the app crash on this. Can't reproduce. May have been editing the file with Xcode. Was loca studio ja.xcloc example.. Will map this to `kMFTransUnitState_NeedsReview` just in case.
-    static auto _stateOrder = @[ /// Order of the states to be used for sorting [Oct 2025]
+    static auto _stateOrder = @[ /// Order of the states to be used for sorting [Oct 2025] || Rows with issues (See `Validator.m`) sort before all of these, and can be filtered for like a state – see `_sortKeys_getStateRank()` and `-[TableView updateFilterOnlyIssues:]` [Oct 2026]
         kMFTransUnitState_New,
         kMFTransUnitState_NeedsReview,
         kMFTransUnitState_Translated,
@@ -30,7 +30,7 @@
     #define kColID_Target   @"target"
     #define kColID_Note     @"note"
 
-     static NSString *rowModel_getCellModel(NSXMLElement *transUnit, NSString *columnID) {
+     static NSString *_rowModel_getCellModel_DOM(NSXMLElement *transUnit, NSString *columnID) { /// Reads straight from the xml. Only used to fill the `RowStore` and as a fallback. [Oct 2026]
         if ((0)) {}
             else if ([columnID isEqual: @"id"])        return xml_attr(transUnit, @"id")           .objectValue;
             else if ([columnID isEqual: @"source"])    return xml_childnamed(transUnit, @"source") .objectValue;
@@ -49,7 +49,18 @@
         else assert(false);
         return nil;
     }
-     static void _rowModel_setCellModel(NSXMLElement *transUnit, NSString *columnID, NSString *newValue) { /// This is only called from wrapper functions which use `NSUndoManager` [Oct 2025]
+     static NSString *rowModel_getCellModel(NSXMLElement *transUnit, NSString *columnID) {
+        NSInteger row;
+        RowStore *store = rowStore_lookup(transUnit, &row);
+        if (store) return rowStore_getCellModel(store, row, columnID); /// Hot path – called for every row when filtering, sorting, and counting progress [Oct 2026]
+        return _rowModel_getCellModel_DOM(transUnit, columnID);
+    }
+     static NSString *_Nullable _rowModel_getStateForUndo(NSXMLElement *transUnit) { /// Like `rowModel_getCellModel(@"state")`, but nil if the xml has no `state` attribute – which reads as `new`. Passing it back to `_rowModel_setCellModel()` removes the attribute again. [Oct 2026]
+        NSString *state = rowModel_getCellModel(transUnit, @"state");
+        if ([state isEqual: kMFTransUnitState_New] && !xml_attr((NSXMLElement *)xml_childnamed(transUnit, @"target"), @"state")) return nil;
+        return state;
+    }
+     static void _rowModel_setCellModel(NSXMLElement *transUnit, NSString *columnID, NSString *_Nullable newValue) { /// This is only called from wrapper functions which use `NSUndoManager` [Oct 2025]
         #define new_attr() [[NSXMLNode alloc] initWithKind: NSXMLAttributeKind]
         #define new_el()   [NSXMLElement new]
         
@@ -58,24 +69,254 @@
             else if ([columnID isEqual: @"state"]) {
                 if ([newValue isEqual: kMFTransUnitState_DontTranslate])
                     xml_attr(transUnit, @"translate", .fallback=new_attr()).objectValue = @"no";
+                else if (!newValue)
+                    [(NSXMLElement *)xml_childnamed(transUnit, @"target") removeAttributeForName: @"state"]; /// Back to no `state` – e.g. undoing a bulk mark of a row that never had one [Oct 2026]
                 else {
                     NSXMLElement *el = (id)xml_childnamed(transUnit, @"target", .fallback=new_el());
                     xml_attr(el, @"state", .fallback=new_attr()).objectValue = newValue;
                 }
             }
         else assert(false); /// Only handle @"target" and @"state" cause we never wanna edit the other stuff [Oct 2025]
+        
+        NSInteger row;
+        RowStore *store = rowStore_lookup(transUnit, &row);
+        if (store) rowStore_setCellModel(store, row, columnID, newValue); /// Keep the store in sync with the DOM [Oct 2026]
     };
     
     static BOOL rowModel_isPluralParent(NSXMLElement *transUnit) { /// Detects the `%#@formatSstring@` of pluralizable strings (parent row)
+        NSInteger row;
+        RowStore *store = rowStore_lookup(transUnit, &row);
+        if (store) return store->isPluralParent[row]; /// Precomputed in `rowStore_append()` – this used to be called for every row in `updateProgressInCell:withFile:` [Oct 2026]
         return [rowModel_getCellModel(transUnit, @"source") containsString: @"%#@"];
     }
     static BOOL rowModel_isPluralChild(NSXMLElement *transUnit) { /// Detects the `|==|` separator found in pluralizable variants (child rows). We also expect the children to always be preceeded by parent. [Nov 2025]]
-        return [xml_attr(transUnit, @"id").objectValue containsString: @"|==|"];
+        return [rowModel_getCellModel(transUnit, @"id") containsString: @"|==|"];
     }
+    
+    static NSArray<NSXMLElement *> *rowModel_getChildren(NSXMLElement *transUnit) { /// Pluralizable variants of a parent row. Empty for all other rows. [Oct 2026]
+        NSInteger row;
+        RowStore *store = rowStore_lookup(transUnit, &row);
+        return store ? store->children[row] : @[];
+    }
+    static NSXMLElement *_Nullable rowModel_getParent(NSXMLElement *transUnit) { /// Inverse of `rowModel_getChildren()`
+        NSInteger row;
+        RowStore *store = rowStore_lookup(transUnit, &row);
+        if (!store || store->parentRow[row] == -1) return nil;
+        return store->transUnits[store->parentRow[row]];
+    }
+    static MFRowIssue rowModel_getIssues(NSXMLElement *transUnit) { /// Plural parents include the issues of their variants. None for rows that don't belong to a store. (See `Validator.m`) [Oct 2026]
+        NSInteger row;
+        RowStore *store = rowStore_lookup(transUnit, &row);
+        return store ? rowStore_getIssues(store, row) : MFRowIssue_None;
+    }
+        
+
+#pragma mark - Display & search strings
+    
+    /// Moved here from `TableView.m` so they build without AppKit (See `Model.h`) [Oct 2026]
+    
+    NSString *_rowModel_cleanUpNote(NSString *note) {
+        
+        /// Remove redundant stuff from IB-generated notes
+        ///     This is slow (plist parsing), so don't call it directly – use `rowModel_getDisplayNote()` which reads the results from the `RowStore`. [Oct 2026]
+        
+        static NSSet<NSSet *> *ibNoteKeySets; /// Complex validation is just a sanity check [Oct 2025]
+        static dispatch_once_t onceToken;
+        dispatch_once(&onceToken, ^{
+            ibNoteKeySets = toset(@[
+                toset(@[         @"Class", @"ObjectID", @"title"]),
+                toset(@[         @"Class", @"ObjectID", @"ibShadowedToolTip"]),
+                toset(@[         @"Class", @"ObjectID", @"placeholderString"]),
+                toset(@[         @"Class", @"ObjectID", @"label"]),
+                toset(@[@"Note", @"Class", @"ObjectID", @"title"]),
+                toset(@[@"Note", @"Class", @"ObjectID", @"ibShadowedToolTip"]),
+                toset(@[@"Note", @"Class", @"ObjectID", @"placeholderString"]),
+                toset(@[@"Note", @"Class", @"ObjectID", @"label"]),
+            ]);
+        });
         
+        if ([note rangeOfString: @"ObjectID = "].location == NSNotFound) return note; /// Fast path – every IB note has an ObjectID (e.g. `Class = "UIButton"; normalTitle = "Adopt"; ObjectID = "dI7-PE-hkI";` – no braces). Saves us the plist parse for plain-text comments. [Oct 2026]
+        
+        NSDictionary *notesDict = [NSPropertyListSerialization /// The Notes generated by IB are old-style plists with the keys directly at the root. Old Xcode .strings files had the same format IIRC. [Oct 2025]
+            propertyListWithData: [note dataUsingEncoding: NSUTF8StringEncoding]
+            options: 0
+            format: NULL
+            error: nil
+        ];
+        if (!isclass(notesDict, NSDictionary)) {
+            if (notesDict) mflog(@"Found non-NSDictionary plist notes: %@", notesDict); /// If the comment is a plain string without quotes, that is also a valid plist [Oct 2025]
+            return note;
+        }
+        
+        if ([ibNoteKeySets containsObject: toset(notesDict.allKeys)])
+            return notesDict[@"Note"] ?: @""; /// Remove everything except @"Note" ... Actually the @"Class" values (e.g. NSMenuItem) may give somewhat useful context, too. Even the uiString-keys (e.g. `placeholderString`) is somewhat useful – Maybe we should add them back? .. But shouldn't be necessary for MMF since we have lots of comments and screenshots.[Nov 2025]
+        
+        assert(false);
+        return note;
+    }
+    
+    NSString *rowModel_getDisplayNote(NSXMLElement *transUnit) {
+        
+        /// The @"note" with IB-generated noise removed.
+        ///     Computed for all rows in the background after loading (See `_buildRowStoreCachesInBackground()`). Only falls back to parsing on the main thread if that hasn't finished yet. [Oct 2026]
+        
+        NSInteger row;
+        RowStore *store = rowStore_lookup(transUnit, &row);
+        if (store && store->displayNotes) {
+            id result = store->displayNotes[row];
+            return result == [NSNull null] ? nil : result;
+        }
+        return stringTable_displayNote(store ? store->strings : nil, rowModel_getCellModel(transUnit, @"note"), _rowModel_cleanUpNote); /// Another language of the project may already have cleaned this note up [Oct 2026]
+    }
+    
+    NSString *_rowModel_getUIString_FromCellModel(NSXMLElement *transUnit, NSString *columnID, NSString *cellModel) {
+        
+        /// Split out of `rowModel_getUIString()` so the searchStrings can be built on a background thread from a snapshot of the @"target" column. (See `_buildRowStoreCachesInBackground()`) [Oct 2026]
+        ///     Only reads immutable stuff from the `RowStore` (ids and plural relationships) – keep it that way.
+        ///     For the @"note" column, pass in the result of `rowModel_getDisplayNote()`.
+        
+        #define iscol(colid) [columnID isEqual: (colid)]
+        
+        NSString *uiString = cellModel;
+        
+        /// Note: IB-generated notes are cleaned up before they get here. (See `rowModel_getDisplayNote()`) [Oct 2026]
+        
+        /// Handle pluralizable strings
+        {
+            if (rowModel_isPluralParent(transUnit)) {
+                if ((0)) {}
+                else if (iscol(@"id"))       {}
+                else if (iscol(@"source"))   uiString = @"(pluralizable)";
+                else if (iscol(@"target")) { uiString = @"(pluralizable)"; } /// We never want the `%#@formatSstring@` to be changed by the translators, so we override it.
+                else if (iscol(@"state"))    { if ((0)) uiString = @"(pluralizable)"; }
+                else if (iscol(@"note"))     {}
+                else                         assert(false);
+            }
+
+            if (rowModel_isPluralChild(transUnit)) {
+
+                if (iscol(@"id")) {
+                    
+                    NSArray *a = [rowModel_getCellModel(transUnit, @"id") componentsSeparatedByString: @"|==|"];
+                    assert(a.count == 2);
+                    
+                    NSString *substitutionPath = a[1];
+                    assert([substitutionPath hasPrefix: @"substitutions.pluralizable.plural."]);
+                    
+                    NSString *pluralVariant = [substitutionPath substringFromIndex: @"substitutions.pluralizable.plural.".length];
+                    
+                    uiString = pluralVariant; /// Just show the variant name (e.g. "one", "other") since it's a child row
+                }
+                else if (iscol(@"note"))
+                    uiString = @""; /// Delete the note cause the parent row already has it.
+            }
+        }
+        
+        return uiString;
+        #undef iscol
+    }
 
+    static NSString *_rowModel_getSearchedUIString(NSXMLElement *transUnit, NSString *columnID, NSArray<NSString *> *_Nullable targets, NSArray<NSString *> *_Nullable displayNotes) {
+        
+        /// The uiString of one of the searched columns (@"id", @"source", @"target", @"note") – what the filter matches and highlights. [Oct 2026]
+        ///     Pass `targets` and `displayNotes` to read from snapshots instead of the live `RowStore` – makes this safe to call off the main thread.
+        
+        NSInteger row;
+        NSString *cellModel;
+        if ((0)) {}
+        else if ([columnID isEqual: @"target"]) cellModel = (targets && rowStore_lookup(transUnit, &row)) ? targets[row] : rowModel_getCellModel(transUnit, @"target");
+        else if ([columnID isEqual: @"note"]) {
+            if (displayNotes && rowStore_lookup(transUnit, &row)) { id n = displayNotes[row]; cellModel = n == [NSNull null] ? nil : n; }
+            else cellModel = rowModel_getDisplayNote(transUnit);
+        }
+        else cellModel = rowModel_getCellModel(transUnit, columnID);
+        
+        return _rowModel_getUIString_FromCellModel(transUnit, columnID, cellModel); /// Using the uiStrings instead of `rowModel_getCellModel` cause of the filtering we do on the IB-generated @"note"-column strings [Nov 2025]
+    }
+    
+    NSString *_rowModel_makeSearchString(NSXMLElement *transUnit, NSArray<NSString *> *_Nullable targets, NSArray<NSString *> *_Nullable displayNotes) {
+        
+        /// Pass `targets` and `displayNotes` to read from snapshots instead of the live `RowStore` – makes this safe to call off the main thread. [Oct 2026]
+        
+        #define combinedRowString(transUnit) stringf(@"%@\n%@\n%@\n%@", \
+            _rowModel_getSearchedUIString(transUnit, @"id",     targets, displayNotes), \
+            _rowModel_getSearchedUIString(transUnit, @"source", targets, displayNotes), \
+            _rowModel_getSearchedUIString(transUnit, @"target", targets, displayNotes), \
+            _rowModel_getSearchedUIString(transUnit, @"note",   targets, displayNotes) /** Note how we're omitting @"state" */\
+        )
+        
+        auto combinedTransUnitString = [NSMutableString new];
+        [combinedTransUnitString appendString: combinedRowString(transUnit)];
+        for (NSXMLElement *childTransUnit in rowModel_getChildren(transUnit)) {
+            [combinedTransUnitString appendString: @"\n"];
+            [combinedTransUnitString appendString: combinedRowString(childTransUnit)];
+        }
+        #undef combinedRowString
+        
+        return [combinedTransUnitString copy];
+    }
+
+#pragma mark - Filtering
+    
+    /// Shared by the app and `xcloc-tool`, so both filter the same way [Oct 2026]
+    ///     (Progress is counted by the `RowStore` – See `rowStore_getProgress()`)
+    
+    static NSStringCompareOptions rowModel_filterOptions(BOOL isRegex, BOOL isCaseSensitive) { /// Maps the options of the Filter menu (See `-[AppDelegate updateFilterStuff:]`)
+        NSStringCompareOptions options = 0;
+        if (!isCaseSensitive) options |= NSCaseInsensitiveSearch;
+        if (isRegex)          options |= NSRegularExpressionSearch;
+        return options;
+    }
+    static NSRegularExpression *_Nullable rowModel_filterRegex(NSString *filterString, NSStringCompareOptions options) { /// Compile once per query, not once per row – `rangeOfString:options:` with `NSRegularExpressionSearch` builds a new regex every call. nil if `options` isn't a regex search or the pattern is invalid [Oct 2026]
+        if (!(options & NSRegularExpressionSearch) || !filterString.length) return nil;
+        return [NSRegularExpression regularExpressionWithPattern: filterString options: (options & NSCaseInsensitiveSearch) ? NSRegularExpressionCaseInsensitive : 0 error: nil];
+    }
+    static BOOL rowModel_searchStringMatches(NSString *searchString, NSString *filterString, NSStringCompareOptions options, NSRegularExpression *_Nullable regex) { /// `searchString` from `_rowModel_makeSearchString()` or the cache in the `RowStore`. `regex` from `rowModel_filterRegex()`. Thread-safe.
+        if (options & NSRegularExpressionSearch)
+            return regex && [regex rangeOfFirstMatchInString: searchString options: 0 range: NSMakeRange(0, searchString.length)].location != NSNotFound; /// Invalid regex matches nothing, like `rangeOfString:options:` did
+        return [searchString rangeOfString: filterString options: options].location != NSNotFound;
+    }
+    static NSArray<NSValue *> *_Nullable rowModel_filterMatchRanges(NSString *uiString, NSString *filterString, NSStringCompareOptions options, NSRegularExpression *_Nullable regex) { /// All the ranges in `uiString` that match `filterString` – these become the `filter-highlights`. Thread-safe. [Oct 2026]
+        
+        if (!uiString.length) return nil;
+        if ((options & NSRegularExpressionSearch) && !regex) return nil; /// Invalid regex
+        
+        auto result = [NSMutableArray<NSValue *> new];
+        if (regex) {
+            [regex enumerateMatchesInString: uiString options: 0 range: NSMakeRange(0, uiString.length) usingBlock: ^(NSTextCheckingResult *match, NSMatchingFlags flags, BOOL *stop) {
+                if (match.range.length) /// `.*` and friends also match zero-length stuff – nothing to highlight there.
+                    [result addObject: [NSValue valueWithRange: match.range]];
+            }];
+        }
+        else {
+            NSUInteger searchStart = 0;
+            while (searchStart < uiString.length) {
+                NSRange matchRange = [uiString rangeOfString: filterString options: options range: NSMakeRange(searchStart, uiString.length - searchStart)];
+                if (matchRange.location == NSNotFound) break;
+                [result addObject: [NSValue valueWithRange: matchRange]];
+                searchStart = NSMaxRange(matchRange); /// Never zero-length for a non-empty, non-regex `filterString`
+            }
+        }
+        return result.count ? result : nil;
+    }
+    static NSDictionary<NSString *, NSArray<NSValue *> *> *_Nullable rowModel_filterHighlights(NSXMLElement *transUnit, NSArray<NSString *> *_Nullable targets, NSArray<NSString *> *_Nullable displayNotes, NSString *filterString, NSStringCompareOptions options, NSRegularExpression *_Nullable regex) {
+        
+        /// columnID -> `rowModel_filterMatchRanges()` in the cell's uiString, for the columns of `transUnit` that have any. nil if none do. (Only the row itself – not its plural variants.) [Oct 2026]
+        ///     `targets`, `displayNotes`: See `_rowModel_getSearchedUIString()`
+        
+        NSMutableDictionary *result = nil;
+        for (NSString *columnID in @[@"id", @"source", @"target", @"note"]) { /// The columns of the searchString (@"state" isn't searched)
+            NSArray<NSValue *> *ranges = rowModel_filterMatchRanges(_rowModel_getSearchedUIString(transUnit, columnID, targets, displayNotes), filterString, options, regex);
+            if (!ranges) continue;
+            if (!result) result = [NSMutableDictionary new];
+            result[columnID] = ranges;
+        }
+        return result;
+    }
+    
 #pragma mark - Other utils shared between TableView.m and SourceList.m
 
+    #if !MF_HEADLESS /// AppKit [Oct 2026]
     static NSMutableAttributedString *make_green_checkmark(NSString *axDescription) {
         auto image = [NSImage imageWithSystemSymbolName: @"checkmark.circle" accessibilityDescription: axDescription];
         auto textAttachment = [NSTextAttachment new]; {
@@ -88,3 +329,14 @@
         } range: NSMakeRange(0, result.length)];
         return result;
     }
+    static NSMutableAttributedString *make_issue_symbol(NSString *axDescription) { /// Shown for rows with issues in the @"state" column and next to the progress in the `SourceList` (See `Validator.m`) [Oct 2026]
+        auto textAttachment = [NSTextAttachment new]; {
+            [textAttachment setImage: [NSImage imageWithSystemSymbolName: kMFStr_Issues_Symbol accessibilityDescription: axDescription]];
+        }
+        NSMutableAttributedString *result = [[NSAttributedString attributedStringWithAttachment: textAttachment] mutableCopy];
+        [result addAttributes: @{
+            NSForegroundColorAttributeName: [NSColor systemOrangeColor]
+        } range: NSMakeRange(0, result.length)];
+        return result;
+    }
+    #endif
@@ -0,0 +1,280 @@
+//
+//  Screenshots.m
+//  mf-xcloc-editor
+//
+//  Created by Noah Nübling on 10/17/26.
+//
+
+/// Finding and rendering the localization screenshots for Quick Look [Oct 2026]
+///
+///     Index: `localizedStringData.plist` lists, for each string, the screenshots it appears in and where. (Example entry in `_localizedStringsDataPlist_GetEntryForRowModel:`)
+///         We used to scan the whole plist for every cell that decides whether to show its `quick-look-button`. Now it's hashed once when the document is read.
+///
+///     Cache: Quick Look can only show files, so each (screenshot, frame) pair is rendered into an annotated JPEG in the temp dir – with a red rectangle around the string.
+///         That used to happen on the main thread when the panel asked for the item: walk `Notes/Screenshots`, read and hash the whole JPEG, decode it, draw it with `-[NSImage drawInRect:]` (slow), re-encode it.
+///         Now the screenshots of rows that get a cell are rendered ahead of time on a background queue, and the decoded screenshots are kept in a memory-bounded LRU – most screenshots contain many strings, so one decode serves many annotations.
+
+#pragma mark - Index
+
+NSDictionary<NSString *, NSArray<NSDictionary *> *> *ScreenshotIndex_Make(NSArray<NSDictionary *> *_Nullable localizedStringsDataPlist) {
+
+    /// stringKey -> plist entries with that key. Usually just one – the same key can appear in several tables though (e.g. `CFBundleName`)
+
+    auto index = [NSMutableDictionary<NSString *, NSMutableArray<NSDictionary *> *> new];
+    for (NSDictionary *entry in localizedStringsDataPlist) {
+        NSString *key = entry[@"stringKey"];
+        if (!isclass(key, NSString)) continue;
+        if (!index[key]) index[key] = [NSMutableArray new];
+        [index[key] addObject: entry];
+    }
+    return index;
+}
+
+NSDictionary *_Nullable screenshotIndex_getEntry(NSDictionary<NSString *, NSArray<NSDictionary *> *> *index, NSString *_Nullable stringKey, NSString *_Nullable tableName) {
+
+    /// Looks up by (tableName, stringKey). `tableName` is the name of the `<file>` without extension (`Localizable`, `Main`, ...) – only needed to tell apart entries with the same key.
+
+    NSArray<NSDictionary *> *entries = stringKey ? index[stringKey] : nil;
+    if (entries.count <= 1) return entries.firstObject;
+    for (NSDictionary *entry in entries)
+        if ([entry[@"tableName"] isEqual: tableName]) return entry;
+    mflog(@"%ld screenshot entries for '%@' and none is in table '%@' – using the first one", entries.count, stringKey, tableName);
+    return entries.firstObject;
+}
+
+#pragma mark - Cache
+
+#define kMFScreenshotCacheBytes     (192 * 1024 * 1024)    /// Budget for decoded screenshots. A Retina screenshot is ~20 MB decoded.
+#define kMFScreenshotPrefetchMax    32                      /// Only the most recently requested (screenshot, frame) pairs are prefetched – the ones near the viewport.
+
+@interface DecodedScreenshot : NSObject
+    {
+        @public
+        CGImageRef image;
+        double scale;       /// Pixels per point. The frames in the plist are in points.
+        NSUInteger bytes;
+    }
+@end
+@implementation DecodedScreenshot
+    - (void) dealloc {
+        CGImageRelease(self->image);
+    }
+@end
+
+@interface ScreenshotCache : NSObject
+    {
+        @public
+        NSString *xclocPath;
+        NSDictionary<NSString *, NSString *> *pathForName;              /// Screenshot filename -> path. `Notes/Screenshots` is only walked once.
+        dispatch_queue_t queue;                                         /// Serial. Everything below is only touched on it.
+        NSMutableDictionary<NSString *, DecodedScreenshot *> *decoded;  /// path -> image
+        NSMutableOrderedSet<NSString *> *lru;                           /// paths of `decoded`, least recently used first
+        NSUInteger decodedBytes;
+        NSMutableDictionary<NSArray *, NSURL *> *annotatedURLs;         /// @[name, frame] -> rendered file
+        NSMutableOrderedSet<NSArray *> *wanted;                         /// Prefetch requests, newest last
+        CGColorRef highlightColor;
+    }
+@end
+@implementation ScreenshotCache
+    - (void) dealloc {
+        CGColorRelease(self->highlightColor);
+    }
+@end
+
+ScreenshotCache *ScreenshotCache_Make(NSString *xclocPath) {
+
+    auto c = [ScreenshotCache new];
+    c->xclocPath = xclocPath;
+    c->queue = dispatch_queue_create("com.nuebling.mf-xcloc-editor.screenshots", dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_UTILITY, 0));
+    c->decoded = [NSMutableDictionary new];
+    c->lru = [NSMutableOrderedSet new];
+    c->annotatedURLs = [NSMutableDictionary new];
+    c->wanted = [NSMutableOrderedSet new];
+    c->highlightColor = CGColorRetain(NSColor.systemRedColor.CGColor); /// Resolve on the main thread – drawing happens on `queue`
+
+    auto pathForName = [NSMutableDictionary<NSString *, NSString *> new];
+    NSString *screenshotsDir = [xclocPath stringByAppendingPathComponent: @"Notes/Screenshots"];
+    for (NSString *p in findPaths(0, screenshotsDir, ^BOOL (NSString *p) { return YES; })) {
+        NSString *name = p.lastPathComponent;
+        if (!pathForName[name]) pathForName[name] = p; /// Same as the `[0]` we used to take from `findPaths()`
+    }
+    c->pathForName = pathForName;
+
+    return c;
+}
+
+    static DecodedScreenshot *_Nullable _screenshotCache_decode(ScreenshotCache *c, NSString *path) {
+
+        /// Only call on `c->queue`
+
+        DecodedScreenshot *d = c->decoded[path];
+        if (d) {
+            [c->lru removeObject: path];
+            [c->lru addObject: path];
+            return d;
+        }
+
+        CGImageSourceRef source = CGImageSourceCreateWithURL((__bridge CFURLRef)[NSURL fileURLWithPath: path], NULL);
+        if (!source) return nil;
+        CGImageRef image = CGImageSourceCreateImageAtIndex(source, 0, (__bridge CFDictionaryRef)@{ (id)kCGImageSourceShouldCacheImmediately: @YES }); /// Decode now, not when drawing
+        NSDictionary *props = CFBridgingRelease(CGImageSourceCopyPropertiesAtIndex(source, 0, NULL));
+        CFRelease(source);
+        if (!image) return nil;
+
+        d = [DecodedScreenshot new];
+        d->image = image;
+        d->scale = MAX(1.0, [props[(id)kCGImagePropertyDPIWidth] doubleValue] / 72.0); /// Same as the size `NSImage` gives it
+        d->bytes = CGImageGetBytesPerRow(image) * CGImageGetHeight(image);
+
+        c->decoded[path] = d;
+        [c->lru addObject: path];
+        c->decodedBytes += d->bytes;
+
+        /// Evict
+        while (c->decodedBytes > kMFScreenshotCacheBytes && c->lru.count > 1) {
+            NSString *oldest = c->lru.firstObject;
+            c->decodedBytes -= c->decoded[oldest]->bytes;
+            [c->decoded removeObjectForKey: oldest];
+            [c->lru removeObjectAtIndex: 0];
+        }
+
+        return d;
+    }
+
+    static NSURL *_Nullable _screenshotCache_render(ScreenshotCache *c, NSString *name, NSString *frameString) {
+
+        /// Returns the file with the screenshot and a red rectangle around `frame`. Only call on `c->queue`
+
+        NSArray *key = @[name, frameString];
+        if (c->annotatedURLs[key]) return c->annotatedURLs[key];
+
+        NSString *imagePath = c->pathForName[name];
+        if (!imagePath) {
+            mflog(@"No screenshot named '%@' in %@", name, c->xclocPath);
+            return nil;
+        }
+
+        /// Get `annotatedImagePath`
+        ///     The temp dir persists across launches, so this also works as a disk cache.
+        ///     Fingerprint: Screenshot filenames aren't unique across xclocs (e.g. the same screenshot names in every language of `Mac Mouse Fix.xcloc`). We used to hash the whole file for this – path, size and date are enough, and don't need a read.
+        ///         SHA-256 of those, not `-[NSString hash]` – that one isn't meant to be stable across launches or collision-resistant, and a collision here would show the wrong screenshot.
+        NSDictionary *attrs = [[NSFileManager defaultManager] attributesOfItemAtPath: imagePath error: nil];
+        NSData *fingerprintInput = [stringf(@"%@|%@|%@", imagePath, attrs[NSFileSize], @([attrs[NSFileModificationDate] timeIntervalSinceReferenceDate])) dataUsingEncoding: NSUTF8StringEncoding];
+        unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+        CC_SHA256(fingerprintInput.bytes, (CC_LONG)fingerprintInput.length, digest);
+        auto fingerprint = [NSMutableString stringWithCapacity: 16];
+        for (int i = 0; i < 8; i++) [fingerprint appendFormat: @"%02x", digest[i]]; /// 64 bits are plenty for a temp dir, and keep the filenames short
+        NSString *annotatedImagePath = [[[[NSFileManager defaultManager] temporaryDirectory] path] stringByAppendingPathComponent: stringf(@"/mf-xcloc-editor/annotated-screenshots/%@ --- (%@) %@.jpeg",
+            [name stringByDeletingPathExtension], fingerprint, frameString
+        )];
+
+        if (![[NSFileManager defaultManager] fileExistsAtPath: annotatedImagePath]) {
+
+            DecodedScreenshot *d = _screenshotCache_decode(c, imagePath);
+            if (!d) {
+                mflog(@"Couldn't decode screenshot at %@", imagePath);
+                return nil;
+            }
+
+            /// Draw
+            size_t w = CGImageGetWidth(d->image), h = CGImageGetHeight(d->image);
+            CGColorSpaceRef colorSpace = CGColorSpaceCreateWithName(kCGColorSpaceSRGB);
+            CGContextRef ctx = CGBitmapContextCreate(NULL, w, h, 8, 0, colorSpace, kCGImageAlphaNoneSkipFirst | kCGBitmapByteOrder32Little);
+            CGColorSpaceRelease(colorSpace);
+            if (!ctx) return nil;
+
+            CGContextDrawImage(ctx, CGRectMake(0, 0, w, h), d->image);
+
+            NSRect frame = NSRectFromString(frameString); /// Top-left origin, in points
+            CGRect frame_px = CGRectMake(
+                frame.origin.x * d->scale,
+                h - (frame.origin.y + frame.size.height) * d->scale,
+                frame.size.width  * d->scale,
+                frame.size.height * d->scale
+            );
+            CGContextSetStrokeColorWithColor(ctx, c->highlightColor);
+            CGContextStrokeRectWithWidth(ctx, frame_px, 3.0 * d->scale);
+
+            CGImageRef annotated = CGBitmapContextCreateImage(ctx);
+            CGContextRelease(ctx);
+
+            /// Write
+            ///     To a temp file first, so Quick Look never sees a half-written image
+            [[NSFileManager defaultManager] createDirectoryAtPath: [annotatedImagePath stringByDeletingLastPathComponent] withIntermediateDirectories: YES attributes: nil error: nil];
+            NSString *tempPath = stringf(@"%@.%@.tmp", annotatedImagePath, NSUUID.UUID.UUIDString);
+            CGImageDestinationRef dest = CGImageDestinationCreateWithURL((__bridge CFURLRef)[NSURL fileURLWithPath: tempPath], (__bridge CFStringRef)@"public.jpeg", 1, NULL);
+            BOOL success = NO;
+            if (dest) {
+                CGImageDestinationAddImage(dest, annotated, (__bridge CFDictionaryRef)@{
+                    (id)kCGImagePropertyDPIWidth:  @(72.0 * d->scale), /// Keep the point size of the original
+                    (id)kCGImagePropertyDPIHeight: @(72.0 * d->scale),
+                });
+                success = CGImageDestinationFinalize(dest);
+                CFRelease(dest);
+            }
+            CGImageRelease(annotated);
+            if (!success || rename(tempPath.fileSystemRepresentation, annotatedImagePath.fileSystemRepresentation) != 0) {
+                mflog(@"Writing annotated screenshot to %@ failed", annotatedImagePath);
+                unlink(tempPath.fileSystemRepresentation);
+                return nil;
+            }
+            mflog(@"Rendered annotated screenshot %@", annotatedImagePath.lastPathComponent);
+        }
+
+        NSURL *url = [NSURL fileURLWithPath: annotatedImagePath];
+        c->annotatedURLs[key] = url;
+        return url;
+    }
+
+    static void _screenshotCache_prefetchNext(ScreenshotCache *c) {
+
+        /// Renders one wanted screenshot, then requeues itself – so a `screenshotCache_getAnnotatedImage()` from the main thread only ever waits for one render. Only call on `c->queue`
+
+        NSArray *key = c->wanted.lastObject; /// Newest first
+        if (!key) return;
+        [c->wanted removeObject: key];
+        @autoreleasepool {
+            _screenshotCache_render(c, key[0], key[1]);
+        }
+        if (c->wanted.count) dispatch_async(c->queue, ^{ _screenshotCache_prefetchNext(c); });
+    }
+
+void screenshotCache_prefetch(ScreenshotCache *c, NSArray<NSDictionary *> *_Nullable screenshotEntries) {
+
+    /// Call with the `screenshots` of a plist entry when its row gets a cell. Returns immediately.
+
+    if (!screenshotEntries.count) return;
+    dispatch_async(c->queue, ^{
+        for (NSDictionary *s in screenshotEntries) {
+            if (!isclass(s[@"name"], NSString) || !isclass(s[@"frame"], NSString)) continue;
+            NSArray *key = @[s[@"name"], s[@"frame"]];
+            if (c->annotatedURLs[key]) continue;
+            [c->wanted removeObject: key];
+            [c->wanted addObject: key];
+        }
+        while (c->wanted.count > kMFScreenshotPrefetchMax) [c->wanted removeObjectAtIndex: 0]; /// Scrolled past those
+        _screenshotCache_prefetchNext(c);
+    });
+}
+
+NSURL *_Nullable screenshotCache_getAnnotatedImage(ScreenshotCache *c, NSString *name, NSString *frameString) {
+
+    /// Blocks until the annotated screenshot is rendered – instant if it was prefetched.
+
+    __block NSURL *result = nil;
+    dispatch_sync(c->queue, ^{
+        [c->wanted removeObject: @[name, frameString]];
+        result = _screenshotCache_render(c, name, frameString);
+    });
+    return result;
+}
+
+ScreenshotCache *getScreenshotCache(XclocDocument *doc) {
+
+    /// The document's cache – made again when the document moved, since it knows the screenshots by path.
+
+    NSString *xclocPath = doc.fileURL.path.stringByStandardizingPath;
+    if (!doc->_screenshotCache || ![doc->_screenshotCache->xclocPath isEqual: xclocPath])
+        doc->_screenshotCache = ScreenshotCache_Make(xclocPath);
+    return doc->_screenshotCache;
+}
@@ -0,0 +1,233 @@
+//
+//  SearchIndex.m
+//  mf-xcloc-editor
+//
+//  Created by Noah Nübling on 10/17/26.
+//
+
+/// Trigram index over the searchStrings of a `RowStore` (See `_rowModel_makeSearchString()`) [Oct 2026]
+///
+///     Maps every 3-character substring to the sorted list of rows that contain it. A row can only match a query if it contains all of the query's trigrams – so we intersect those lists, and only run `rangeOfString:options:` on the few rows that are left.
+///     The index is built from case- and diacritic-folded strings, so it works for all combinations of `_filterOptions` – for case-sensitive queries it just returns a few extra candidates which then fail verification.
+///
+///     The index is never updated in place. Rows whose @"target" was edited after the index was built are tracked in `RowStore->searchIndexDirtyRows`, and the caller always checks those.
+///     Built in the background by `_buildRowStoreCachesInBackground()` in TableView.m
+
+typedef struct {
+    int32_t *rows;      /// Ascending
+    int32_t count;
+    int32_t capacity;
+} Postings;
+
+@interface SearchIndex : NSObject
+    {
+        @public
+        CFMutableDictionaryRef postings; /// trigram -> `Postings *` || Trigram = 3 UTF-16 units packed into a uint64, used directly as the key (NULL callbacks, so no boxing) [Oct 2026]
+    }
+@end
+
+@implementation SearchIndex
+
+    - (void) dealloc {
+        if (!self->postings) return;
+        CFIndex n = CFDictionaryGetCount(self->postings);
+        const void **values = malloc(MAX(n, 1) * sizeof(void *));
+        CFDictionaryGetKeysAndValues(self->postings, NULL, values);
+        for (CFIndex i = 0; i < n; i++) {
+            free(((Postings *)values[i])->rows);
+            free((void *)values[i]);
+        }
+        free(values);
+        CFRelease(self->postings);
+    }
+
+@end
+
+#pragma mark - Helpers
+
+    static NSString *_searchIndex_fold(NSString *string) {
+        return [string stringByFoldingWithOptions: NSCaseInsensitiveSearch | NSDiacriticInsensitiveSearch | NSWidthInsensitiveSearch locale: nil];
+    }
+
+    static void _searchIndex_forEachTrigram(NSString *folded, void (^callback)(uint64_t trigram)) {
+
+        NSUInteger len = folded.length;
+        if (len < 3) return;
+
+        unichar *buf = malloc(len * sizeof(unichar));
+        [folded getCharacters: buf range: NSMakeRange(0, len)];
+        for (NSUInteger i = 0; i + 2 < len; i++) {
+            if (!buf[i] || !buf[i+1] || !buf[i+2]) continue; /// Trigram 0 would be the NULL key. Skipping is fine, since we skip it for queries, too.
+            callback(((uint64_t)buf[i] << 32) | ((uint64_t)buf[i+1] << 16) | (uint64_t)buf[i+2]);
+        }
+        free(buf);
+    }
+
+    static NSArray<NSString *> *_Nullable _searchIndex_requiredLiterals(NSString *pattern) {
+
+        /// Literal substrings that every match of the ICU regex `pattern` has to contain.
+        ///     Only looks at the top level of the pattern – groups, character-classes and escapes like `\d` just end the current literal.
+        ///     Returns nil for anything we don't understand (alternations, inline flags, `\Q...\E`, etc.), in which case the caller falls back to scanning all rows. [Oct 2026]
+
+        auto result = [NSMutableArray<NSString *> new];
+        auto run = [NSMutableString new];
+        #define endRun() ({ if (run.length) [result addObject: [run copy]]; [run setString: @""]; })
+
+        NSUInteger len = pattern.length;
+
+        /// Skips over a `[...]` or `(...)` starting at `i`. Returns the index of the closing bracket, or NSNotFound.
+        NSUInteger (^skipBracket)(NSUInteger) = ^NSUInteger (NSUInteger i) {
+            NSInteger depth = 0;
+            unichar open = [pattern characterAtIndex: i];
+            unichar close = open == '[' ? ']' : ')';
+            for (; i < len; i++) {
+                unichar c = [pattern characterAtIndex: i];
+                if (c == '\\') { i++; continue; }
+                if (open == '[' && c == ']' && i > 0 && ([pattern characterAtIndex: i-1] == '[' || ([pattern characterAtIndex: i-1] == '^' && i > 1 && [pattern characterAtIndex: i-2] == '['))) continue; /// `[]...]` and `[^]...]` – leading `]` is literal
+                if (c == open) depth++;
+                else if (c == close) { depth--; if (depth == 0) return i; }
+            }
+            return NSNotFound;
+        };
+
+        for (NSUInteger i = 0; i < len; i++) {
+
+            unichar c    = [pattern characterAtIndex: i];
+            unichar next = i + 1 < len ? [pattern characterAtIndex: i + 1] : 0;
+
+            if (c == '?' || c == '*' || c == '{') { /// Quantifiers that make the previous char optional
+                if (run.length) [run deleteCharactersInRange: NSMakeRange(run.length - 1, 1)];
+                endRun();
+                if (c == '{') {
+                    NSRange r = [pattern rangeOfString: @"}" options: 0 range: NSMakeRange(i, len - i)];
+                    if (r.location == NSNotFound) return nil;
+                    i = r.location;
+                }
+            }
+            else if (c == '+') endRun(); /// Previous char is still required
+            else if (c == '.' || c == '^' || c == '$') endRun();
+            else if (c == '|' || c == ')') return nil;
+            else if (c == '[') {
+                endRun();
+                i = skipBracket(i);
+                if (i == NSNotFound) return nil;
+            }
+            else if (c == '(') {
+                endRun();
+                if (next == '?' && i + 2 < len) {
+                    unichar c2 = [pattern characterAtIndex: i + 2];
+                    if ((c2 < 128 && isalpha(c2)) || c2 == '-' || c2 == '#') return nil; /// Inline flags like `(?x)` could change how the rest of the pattern is parsed.
+                }
+                i = skipBracket(i);
+                if (i == NSNotFound) return nil;
+            }
+            else if (c == '\\') {
+                if (!next) return nil;
+                i++;
+                if      (next == 'n') [run appendString: @"\n"];
+                else if (next == 't') [run appendString: @"\t"];
+                else if (next == 'r') [run appendString: @"\r"];
+                else if (next < 128 && strchr("dDwWsSbBhHvVRXAZzG", next)) endRun();
+                else if (next < 128 && isalnum(next)) return nil; /// `\x41`, `\p{L}`, `\1`, `\Q`, ... – these consume more chars or aren't literals.
+                else [run appendFormat: @"%C", next];
+            }
+            else
+                [run appendFormat: @"%C", c];
+        }
+        endRun();
+        #undef endRun
+
+        return result;
+    }
+
+    static int _searchIndex_comparePostingCounts(const void *a, const void *b) {
+        return (*(Postings **)a)->count - (*(Postings **)b)->count;
+    }
+
+#pragma mark - Interface
+
+SearchIndex *SearchIndex_Make(NSArray *searchStrings) {
+
+    /// `searchStrings` is indexed by `RowStore` row. Pass NSNull for rows that shouldn't be indexed (plural variants – they're part of their parent's searchString)
+    ///     Thread-safe – doesn't touch anything but its arguments. [Oct 2026]
+
+    auto index = [SearchIndex new];
+    index->postings = CFDictionaryCreateMutable(NULL, 0, NULL, NULL);
+
+    for (int32_t row = 0; row < searchStrings.count; row++) {
+        @autoreleasepool {
+            NSString *s = searchStrings[row];
+            if (s == (id)[NSNull null]) continue;
+            _searchIndex_forEachTrigram(_searchIndex_fold(s), ^(uint64_t trigram) {
+                Postings *p = (Postings *)CFDictionaryGetValue(index->postings, (void *)trigram);
+                if (!p) {
+                    p = calloc(1, sizeof(Postings));
+                    CFDictionarySetValue(index->postings, (void *)trigram, p);
+                }
+                if (p->count && p->rows[p->count - 1] == row) return; /// Same trigram twice in one row
+                if (p->count == p->capacity) {
+                    p->capacity = MAX(4, p->capacity * 2);
+                    p->rows = realloc(p->rows, p->capacity * sizeof(int32_t));
+                }
+                p->rows[p->count++] = row;
+            });
+        }
+    }
+
+    return index;
+}
+
+NSIndexSet *_Nullable searchIndex_query(SearchIndex *index, NSString *query, NSStringCompareOptions options) {
+
+    /// Returns the rows that might match `query`. The caller still has to verify them with `rangeOfString:options:`.
+    ///     Returns nil if the index can't help (query shorter than 3 chars, or a regex without usable literals) – then the caller has to check all rows. [Oct 2026]
+
+    NSArray<NSString *> *literals = (options & NSRegularExpressionSearch) ? _searchIndex_requiredLiterals(query) : @[query];
+    if (!literals) return nil;
+
+    /// Collect the postings of all trigrams
+    __block NSInteger listCount = 0;
+    __block NSInteger listCapacity = 16;
+    __block Postings **lists = malloc(listCapacity * sizeof(Postings *));
+    __block BOOL missingTrigram = NO;
+    for (NSString *literal in literals) {
+        _searchIndex_forEachTrigram(_searchIndex_fold(literal), ^(uint64_t trigram) {
+            Postings *p = (Postings *)CFDictionaryGetValue(index->postings, (void *)trigram);
+            if (!p) { missingTrigram = YES; return; }
+            if (listCount == listCapacity) {
+                listCapacity *= 2;
+                lists = realloc(lists, listCapacity * sizeof(Postings *));
+            }
+            lists[listCount++] = p;
+        });
+    }
+
+    if (missingTrigram) { free(lists); return [NSIndexSet indexSet]; } /// No row contains this trigram
+    if (!listCount)     { free(lists); return nil; }
+
+    /// Intersect – start with the shortest list, so the working set is small from the start.
+    qsort(lists, listCount, sizeof(Postings *), _searchIndex_comparePostingCounts);
+
+    int32_t n = lists[0]->count;
+    int32_t *rows = malloc(MAX(n, 1) * sizeof(int32_t));
+    memcpy(rows, lists[0]->rows, n * sizeof(int32_t));
+
+    for (NSInteger k = 1; k < listCount && n; k++) {
+        Postings *p = lists[k];
+        int32_t i = 0, j = 0, m = 0;
+        while (i < n && j < p->count) {
+            if      (rows[i] < p->rows[j]) i++;
+            else if (rows[i] > p->rows[j]) j++;
+            else { rows[m++] = rows[i]; i++; j++; }
+        }
+        n = m;
+    }
+
+    auto result = [NSMutableIndexSet new];
+    for (int32_t i = 0; i < n; i++) [result addIndex: rows[i]];
+
+    free(rows);
+    free(lists);
+
+    return result;
+}
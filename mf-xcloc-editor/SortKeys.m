@@ -0,0 +1,349 @@
+//
+//  SortKeys.m
+//  mf-xcloc-editor
+//
+//  Created by Noah Nübling on 10/17/26.
+//
+
+/// Precomputed sort keys for the columns of a `RowStore` [Oct 2026]
+///
+///     The table used to sort by calling `rowModel_getUIString()` on both rows and `localizedStandardCompare:`-ing the results – for every comparison. For @"state" it did `indexOfObject:` on `_stateOrder`, after walking the plural variants. A sort of 40k rows made hundreds of thousands of those calls on the main thread.
+///
+///     Now each string column is collated once: the distinct uiStrings are sorted with `localizedStandardCompare:`, and each row gets the position of its uiString in that order as a number (its `rank`). Sorting then only compares numbers – and several sort descriptors are just several numbers per row.
+///     @"state" needs no collation, its rank is the position in `_stateOrder` – cheap enough to compute on every sort.
+///
+///     Invalidation: Of the string columns only @"target" can change. Edits re-rank the row in place (See `sortKeys_targetDidChange()`), so the keys never have to be rebuilt.
+///         Ranks are doubles, so an edited string that falls between two existing ones gets a rank between theirs. Only when we run out of precision (~50 inserts into the same gap) is the column renumbered.
+///     Threads: Building runs in the background (See `rowStore_buildSortKeys()`), everything else is main-thread only.
+///         To sort in the background, take a `rowStore_snapshotSortKeys()` on the main thread and pass it to `sortKeys_sortRows()`. [Oct 2026]
+
+@interface SortKeyColumn : NSObject
+    {
+        @public
+        NSString *columnID;
+        double *ranks;                              /// Per row. Plural variants aren't ranked – they're never sorted, only shown under their parent.
+        NSMutableArray<NSString *> *sortedStrings;  /// Distinct uiStrings, ascending. Strings that `localizedStandardCompare:` as equal share one entry.
+        double *sortedRanks;                        /// Parallel to `sortedStrings`. Ascending.
+        NSInteger sortedCapacity;
+    }
+@end
+@implementation SortKeyColumn
+    - (void) dealloc {
+        free(self->ranks);
+        free(self->sortedRanks);
+    }
+@end
+
+#pragma mark - Building
+
+    static NSString *_sortKeys_getUIString(RowStore *store, NSInteger row, NSString *columnID, NSArray<NSString *> *_Nullable targets) {
+
+        /// Same as `rowModel_getUIString()` but safe off the main thread – pass a snapshot of the @"target" column. [Oct 2026]
+
+        NSString *cellModel;
+        if ((0)) {}
+            else if ([columnID isEqual: @"note"])                 cellModel = stringTable_displayNote(store->strings, rowStore_getCellModel(store, row, @"note"), _rowModel_cleanUpNote);
+            else if ([columnID isEqual: @"target"] && targets)    cellModel = targets[row] == (id)[NSNull null] ? nil : targets[row];
+            else                                                  cellModel = rowStore_getCellModel(store, row, columnID);
+        return _rowModel_getUIString_FromCellModel(store->transUnits[row], columnID, cellModel) ?: @"";
+    }
+
+    static SortKeyColumn *SortKeyColumn_Make(RowStore *store, NSString *columnID, NSArray<NSString *> *_Nullable targets) {
+
+        /// Don't call for @"state" – see `_sortKeys_getStateRank()`
+
+        CFAbsoluteTime t0 = CFAbsoluteTimeGetCurrent();
+
+        NSInteger n = store->count;
+        auto uiStrings = [NSMutableArray<NSString *> arrayWithCapacity: n];
+        auto distinct = [NSMutableSet<NSString *> new];
+        for (NSInteger row = 0; row < n; row++) {
+            @autoreleasepool {
+                NSString *s = store->parentRow[row] != -1 ? @"" : _sortKeys_getUIString(store, row, columnID, targets);
+                [uiStrings addObject: s];
+                [distinct addObject: s];
+            }
+        }
+
+        /// Collate
+        ///     The only `localizedStandardCompare:` calls – and only on the distinct strings. (Sources and notes repeat a lot.)
+        NSArray<NSString *> *sorted = [distinct.allObjects sortedArrayUsingSelector: @selector(localizedStandardCompare:)];
+
+        auto c = [SortKeyColumn new];
+        c->columnID = columnID;
+        c->sortedStrings = [NSMutableArray arrayWithCapacity: sorted.count];
+        c->sortedCapacity = MAX(16, sorted.count * 2);
+        c->sortedRanks = malloc(c->sortedCapacity * sizeof(double));
+
+        auto rankForString = [NSMutableDictionary<NSString *, NSNumber *> dictionaryWithCapacity: sorted.count];
+        for (NSString *s in sorted) {
+            if (!c->sortedStrings.count || [c->sortedStrings.lastObject localizedStandardCompare: s] != NSOrderedSame) {
+                c->sortedRanks[c->sortedStrings.count] = c->sortedStrings.count;
+                [c->sortedStrings addObject: s];
+            }
+            rankForString[s] = @(c->sortedStrings.count - 1);
+        }
+
+        c->ranks = malloc(MAX(1, n) * sizeof(double));
+        for (NSInteger row = 0; row < n; row++)
+            c->ranks[row] = rankForString[uiStrings[row]].doubleValue;
+
+        mflog(@"Built sort keys for column '%@' (%ld rows, %ld distinct) in %.0f ms", columnID, n, c->sortedStrings.count, (CFAbsoluteTimeGetCurrent() - t0) * 1000);
+
+        return c;
+    }
+
+    static void _sortKeys_renumber(SortKeyColumn *c, NSInteger rowCount) {
+
+        /// Spread the ranks out to integers again, keeping their order.
+
+        double *old = malloc(MAX(1, c->sortedStrings.count) * sizeof(double));
+        memcpy(old, c->sortedRanks, c->sortedStrings.count * sizeof(double));
+        for (NSInteger i = 0; i < c->sortedStrings.count; i++) c->sortedRanks[i] = i;
+
+        for (NSInteger row = 0; row < rowCount; row++) { /// Binary search for the old rank
+            NSInteger lo = 0, hi = (NSInteger)c->sortedStrings.count - 1;
+            while (lo < hi) {
+                NSInteger mid = (lo + hi) / 2;
+                if (old[mid] < c->ranks[row]) lo = mid + 1;
+                else                          hi = mid;
+            }
+            c->ranks[row] = lo;
+        }
+        free(old);
+
+        mflog(@"Renumbered sort keys for column '%@'", c->columnID);
+    }
+
+    static void _sortKeys_rank(SortKeyColumn *c, NSInteger row, NSString *uiString, NSInteger rowCount) {
+
+        /// Give `row` the rank of `uiString`, adding it to the collation if it's new. O(log distinct) comparisons.
+
+        NSInteger lo = 0, hi = c->sortedStrings.count; /// First entry >= uiString
+        while (lo < hi) {
+            NSInteger mid = (lo + hi) / 2;
+            if ([c->sortedStrings[mid] localizedStandardCompare: uiString] == NSOrderedAscending) lo = mid + 1;
+            else                                                                                   hi = mid;
+        }
+        if (lo < c->sortedStrings.count && [c->sortedStrings[lo] localizedStandardCompare: uiString] == NSOrderedSame) {
+            c->ranks[row] = c->sortedRanks[lo];
+            return;
+        }
+
+        /// Insert
+        ///     Between the ranks of the neighbors. If there's no double between them anymore, renumber first.
+        NSInteger m = c->sortedStrings.count;
+        double below, above, rank;
+        for (int attempt = 0; ; attempt++) {
+            below = lo > 0 ? c->sortedRanks[lo - 1] : (m ? c->sortedRanks[0] - 2.0 : -1.0);
+            above = lo < m ? c->sortedRanks[lo]     : (m ? c->sortedRanks[m - 1] + 2.0 : 1.0);
+            rank = (below + above) / 2.0;
+            if ((below < rank && rank < above) || attempt > 0) break;
+            _sortKeys_renumber(c, rowCount);
+        }
+
+        if (m + 1 > c->sortedCapacity) {
+            c->sortedCapacity *= 2;
+            c->sortedRanks = realloc(c->sortedRanks, c->sortedCapacity * sizeof(double));
+        }
+        memmove(&c->sortedRanks[lo + 1], &c->sortedRanks[lo], (m - lo) * sizeof(double));
+        c->sortedRanks[lo] = rank;
+        [c->sortedStrings insertObject: uiString atIndex: lo];
+        c->ranks[row] = rank;
+    }
+
+#pragma mark - Interface
+
+void rowStore_buildSortKeys(RowStore *store, NSArray<NSString *> *columnIDs, BOOL synchronously, void (^_Nullable completion)(void)) {
+
+    /// Makes sure the sort keys of `columnIDs` exist. Main thread only.
+    ///     `synchronously == NO` builds them in the background and calls `completion` on the main thread when they're there. Builds that are already running are joined, not repeated.
+
+    assert(NSThread.isMainThread);
+
+    if (!store->sortKeys)         store->sortKeys = [NSMutableDictionary new];
+    if (!store->sortKeysWaiters)  store->sortKeysWaiters = [NSMutableDictionary new];
+
+    auto missing = [NSMutableArray<NSString *> new];
+    for (NSString *columnID in columnIDs)
+        if (![columnID isEqual: @"state"] && !store->sortKeys[columnID] && ![missing containsObject: columnID])
+            [missing addObject: columnID];
+
+    if (synchronously) {
+        for (NSString *columnID in missing)
+            store->sortKeys[columnID] = SortKeyColumn_Make(store, columnID, nil);
+        if (completion) completion();
+        return;
+    }
+
+    if (!missing.count) {
+        if (completion) completion();
+        return;
+    }
+
+    /// Wait for all the missing columns, then call `completion` once
+    __block NSInteger remaining = missing.count;
+    void (^columnDone)(void) = ^{
+        if (--remaining == 0 && completion) completion();
+    };
+
+    for (NSString *columnID in missing) {
+
+        if (store->sortKeysWaiters[columnID]) { /// Already building
+            [store->sortKeysWaiters[columnID] addObject: columnDone];
+            continue;
+        }
+        store->sortKeysWaiters[columnID] = [NSMutableArray arrayWithObject: columnDone];
+
+        NSArray<NSString *> *targets = [columnID isEqual: @"target"] ? [store->targets copy] : nil; /// Only the @"target" column can change while we're in the background.
+        if (targets) [store->sortKeysDirtyRows removeAllIndexes];
+
+        dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+            SortKeyColumn *c = SortKeyColumn_Make(store, columnID, targets);
+            dispatch_async(dispatch_get_main_queue(), ^{
+                if (!store->sortKeys[columnID]) { /// A synchronous build may have beaten us
+                    if (targets) { /// Catch up with the edits made while we were building
+                        [store->sortKeysDirtyRows enumerateIndexesUsingBlock: ^(NSUInteger row, BOOL *stop) {
+                            _sortKeys_rank(c, row, _sortKeys_getUIString(store, row, @"target", nil), store->count);
+                        }];
+                        [store->sortKeysDirtyRows removeAllIndexes];
+                    }
+                    store->sortKeys[columnID] = c;
+                }
+                NSArray *waiters = store->sortKeysWaiters[columnID];
+                [store->sortKeysWaiters removeObjectForKey: columnID];
+                for (void (^waiter)(void) in waiters) waiter();
+            });
+        });
+    }
+}
+
+void rowStore_prebuildSortKeys(RowStore *store, NSString *columnID) {
+
+    /// Synchronous, on any thread – but only while no other thread knows the store yet. (Used by the document while it's reading in the background.)
+
+    if (!store->sortKeys) store->sortKeys = [NSMutableDictionary new];
+    if (!store->sortKeys[columnID]) store->sortKeys[columnID] = SortKeyColumn_Make(store, columnID, nil);
+}
+
+void sortKeys_targetDidChange(RowStore *store, NSInteger row) {
+
+    /// Called by `rowStore_setCellModel()` after the @"target" of `row` changed.
+
+    if (store->parentRow[row] != -1 || store->isPluralParent[row]) return; /// Variants aren't ranked, and parents always show `(pluralizable)`
+
+    SortKeyColumn *c = store->sortKeys[@"target"];
+    if (c)                                      _sortKeys_rank(c, row, _sortKeys_getUIString(store, row, @"target", nil), store->count);
+    else if (store->sortKeysWaiters[@"target"]) [store->sortKeysDirtyRows addIndex: row]; /// Building – rank it when it lands
+}
+
+    static double _sortKeys_getStateRank(RowStore *store, NSInteger row) {
+
+        /// Position in `_stateOrder`. Plural parents get the state `stateOfRowModel:` shows for them. Unknown states sort last, like they did with `indexOfObject:`.
+        ///     Rows with issues sort first – before `new` [Oct 2026]
+
+        if (rowStore_getIssues(store, row)) return -1;
+        if (store->isPluralParent[row] && [store->children[row] count]) {
+            for (NSXMLElement *child in store->children[row]) {
+                NSInteger childRow;
+                rowStore_lookup(child, &childRow);
+                if (store->states[childRow] != MFTransUnitState_Translated) return MFTransUnitState_NeedsReview;
+            }
+            return MFTransUnitState_Translated;
+        }
+        return store->states[row]; /// `MFTransUnitState` has the same order as `_stateOrder`, with Unknown last
+    }
+
+    static NSArray<NSXMLElement *> *_sortKeys_sortByKeys(NSArray<NSXMLElement *> *transUnits, double *keys, NSInteger k) {
+
+        /// `keys` has `k` doubles per position in `transUnits`. Stable. Thread-safe.
+        ///     Sorting positions instead of the transUnits themselves, so the comparator doesn't have to look up the rows. (Small NSNumbers are tagged pointers – no allocations.)
+
+        NSInteger n = transUnits.count;
+        auto positions = [NSMutableArray<NSNumber *> arrayWithCapacity: n];
+        for (NSInteger i = 0; i < n; i++) [positions addObject: @(i)];
+
+        [positions sortWithOptions: NSSortStable usingComparator: ^NSComparisonResult(NSNumber *a, NSNumber *b) {
+            double *ka = &keys[a.integerValue * k];
+            double *kb = &keys[b.integerValue * k];
+            for (NSInteger d = 0; d < k; d++) {
+                if (ka[d] < kb[d]) return NSOrderedAscending;
+                if (ka[d] > kb[d]) return NSOrderedDescending;
+            }
+            return NSOrderedSame;
+        }];
+
+        auto result = [NSMutableArray<NSXMLElement *> arrayWithCapacity: n];
+        for (NSNumber *p in positions) [result addObject: transUnits[p.integerValue]];
+        return result;
+    }
+
+NSArray<NSXMLElement *> *_Nullable rowStore_sortRows(RowStore *store, NSArray<NSXMLElement *> *transUnits, NSArray<NSSortDescriptor *> *descriptors) {
+
+    /// Stable sort by all the `descriptors` (first one is the primary key). Main thread only.
+    ///     Returns nil if the keys of one of the columns haven't been built yet (See `rowStore_buildSortKeys()`).
+
+    NSInteger n = transUnits.count;
+    NSInteger k = descriptors.count;
+
+    /// Gather the keys
+    ///     One double per (row, descriptor), with the sign flipped for descending – so the comparator is just a loop of `<`.
+    double *keys = malloc(MAX(1, n * k) * sizeof(double));
+    for (NSInteger d = 0; d < k; d++) {
+        NSSortDescriptor *desc = descriptors[d];
+        SortKeyColumn *c = [desc.key isEqual: @"state"] ? nil : store->sortKeys[desc.key];
+        if (!c && ![desc.key isEqual: @"state"]) { free(keys); return nil; }
+        double sign = desc.ascending ? 1.0 : -1.0;
+        for (NSInteger i = 0; i < n; i++) {
+            NSInteger row = -1;
+            RowStore *s = rowStore_lookup(transUnits[i], &row);
+            if (s != store) { assert(false); keys[i * k + d] = 0; continue; } /// Not from this store – shouldn't happen
+            keys[i * k + d] = sign * (c ? c->ranks[row] : _sortKeys_getStateRank(store, row));
+        }
+    }
+
+    NSArray<NSXMLElement *> *result = _sortKeys_sortByKeys(transUnits, keys, k);
+    free(keys);
+    return result;
+}
+
+NSData *_Nullable rowStore_snapshotSortKeys(RowStore *store, NSArray<NSSortDescriptor *> *descriptors) {
+
+    /// The keys of all rows of `store`, for sorting on another thread with `sortKeys_sortRows()`. Main thread only. [Oct 2026]
+    ///     Same layout as in `rowStore_sortRows()`, but indexed by row instead of by position – so we don't have to know yet which rows will be sorted.
+    ///     Returns nil if the keys of one of the columns haven't been built yet.
+
+    assert(NSThread.isMainThread);
+
+    NSInteger n = store->count;
+    NSInteger k = descriptors.count;
+
+    auto data = [NSMutableData dataWithLength: MAX(1, n * k) * sizeof(double)];
+    double *keys = data.mutableBytes;
+    for (NSInteger d = 0; d < k; d++) {
+        NSSortDescriptor *desc = descriptors[d];
+        SortKeyColumn *c = [desc.key isEqual: @"state"] ? nil : store->sortKeys[desc.key];
+        if (!c && ![desc.key isEqual: @"state"]) return nil;
+        double sign = desc.ascending ? 1.0 : -1.0;
+        for (NSInteger row = 0; row < n; row++)
+            keys[row * k + d] = store->parentRow[row] != -1 ? 0 : sign * (c ? c->ranks[row] : _sortKeys_getStateRank(store, row));
+    }
+    return data;
+}
+
+NSArray<NSXMLElement *> *sortKeys_sortRows(NSData *snapshot, NSInteger k, NSArray<NSXMLElement *> *transUnits) {
+
+    /// Stable sort of `transUnits` by a `rowStore_snapshotSortKeys()` with `k` descriptors. Thread-safe. [Oct 2026]
+
+    NSInteger n = transUnits.count;
+    const double *rowKeys = snapshot.bytes;
+    double *keys = malloc(MAX(1, n * k) * sizeof(double));
+    for (NSInteger i = 0; i < n; i++) {
+        NSInteger row = -1;
+        rowStore_lookup(transUnits[i], &row);
+        memcpy(&keys[i * k], &rowKeys[row * k], k * sizeof(double));
+    }
+    NSArray<NSXMLElement *> *result = _sortKeys_sortByKeys(transUnits, keys, k);
+    free(keys);
+    return result;
+}
@@ -5,6 +5,8 @@
 //  Created by Noah Nübling on 09.06.25.
 //
 
+    @class Xliff;
+
     @interface SourceList : NSOutlineView <NSOutlineViewDataSource, NSOutlineViewDelegate>
 
         {
@@ -14,7 +16,8 @@
         }
 
 
-        - (void) setXliffDoc: (NSXMLDocument *)xliffDoc;
+        - (void) setXliff: (Xliff *)xliff;
+        - (void) applyMergedXliff: (Xliff *)xliff changedItems: (NSArray<NSXMLElement *> *)changedItems;
 
         - (void) progressHasChanged;
         - (void) showAllTransUnits;
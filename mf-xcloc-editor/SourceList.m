@@ -13,21 +13,27 @@
         @public
         NSArray<NSXMLElement *> *transUnits;
         NSString *path;
+        NSInteger fileIndex; /// Index in the xliff (See `RowStore->fileIndexes`). -1 for `kMFPath_AllDocuments` [Oct 2026]
+        NSString *uiString;  /// See `uiStringForFile:`. Filled in `setXliff:`
     }
 @end
 @implementation File @end
-File *File_Make(NSArray<NSXMLElement *> *transUnits, NSString *path) {
+File *File_Make(NSArray<NSXMLElement *> *transUnits, NSString *path, NSInteger fileIndex) {
     auto f = [File new];
     f->transUnits = transUnits;
     f->path = path;
+    f->fileIndex = fileIndex;
     return f;
 }
 
 @implementation SourceList
     {
         NSMutableArray <File *> *files;
+        NSArray<File *> *_filesByFileIndex; /// Lets `fileForTransUnit:` go straight from `RowStore->fileIndexes` to the `File` [Oct 2026]
         NSArray<NSXMLElement *> *_transUnitsFromAllFiles; /// Gives each transUnit a unique ID, which we need for undo/redo [Oct 2025]
+        RowStore *_rowStore; /// Owns the index that the `rowModel_` functions use. (They only hold weak refs.) [Oct 2026]
         BOOL justBecameFirstResponder;
+        BOOL _isApplyingMergedXliff; /// Keeps selection changes from reloading the TableView from scratch (See `applyMergedXliff:changedItems:`) [Oct 2026]
     }
 
     #pragma mark - Lifecycle
@@ -67,111 +73,47 @@ File *File_Make(NSArray<NSXMLElement *> *transUnits, NSString *path) {
 
     #pragma mark - Data
 
-    - (void) setXliffDoc: (NSXMLDocument *)xliffDoc {
+    - (void) setXliff: (Xliff *)xliff {
         
-        /// Validate doc
+        /// Note: Validation of the xliff happens in the loaders now (See `Xliff.m`) [Oct 2026]
         
-        assert( [xliffDoc.version           isEqual: @"1.0"] );
-        assert( [xliffDoc.characterEncoding isEqual: @"UTF-8"] ); /// Not sure these things make any sense validating
+        mftrace_scope("load.setXliff");
         
-        /// Validate xliff node
-        
-        NSXMLNode *xliff = [xliffDoc rootElement];
-        
-        assert( [xliff.name isEqual: @"xliff"] );
-        assert( isclass(xliff, NSXMLElement) );
-        auto attrs = xml_attrdict((NSXMLElement *)xliff);
-        
-        if ((0)) assert( [attrs[@"xmlns"].objectValue     isEqual: @"urn:oasis:names:tc:xliff:document:1.2"] );         /// Present in the xml text but not here
-        if ((0)) assert( [attrs[@"xmlns:xsi"].objectValue isEqual: @"http://www.w3.org/2001/XMLSchema-instance"] ); /// Present in the xml text but not here
-        assert( [attrs[@"version"].objectValue            isEqual: @"1.2" ] );
-        assert( [attrs[@"xsi:schemaLocation"].objectValue isEqual: @"urn:oasis:names:tc:xliff:document:1.2 http://docs.oasis-open.org/xliff/v1.2/os/xliff-core-1.2-strict.xsd"] );
-        
-        /// Validate & store xliff node children (files)
-        assert( allsatisfy(xliff.children, xliff.childCount, x, isclass(x, NSXMLElement)) );
-        assert( allsatisfy(xliff.children, xliff.childCount, x, [x.name isEqual: @"file"]) );
-        
-        /// Unwrap the transUnits
         auto transUnitsFromAllFiles = [NSMutableArray new];
         self->files = [NSMutableArray new];
-        NSString *sourceLanguage = nil;
-        NSString *targetLanguage = nil;
-        for (NSXMLElement *file in xliff.children) {
-        
-            /** Validate data
-                Should look like this:
-                ```
-                <file original="App/UI/Main/Base.lproj/Main.storyboard" source-language="en" target-language="de" datatype="plaintext">
-                    <header>
-                      <tool tool-id="com.apple.dt.xcode" tool-name="Xcode" tool-version="16.1" build-num="16B5001e"/>
-                    </header>
-                    <body>...
-                ```
-            */
-            {
-                NSDictionary<NSString *, NSXMLNode *> *attrs;
-                
-                /// Validate `<file>`
-                
-                assert(file != nil);
-                assert([file.name isEqual: @"file"]);
-                assert(file.childCount == 2);
-                assert([[file childAtIndex: 0].name isEqual: @"header"]);
-                assert([[file childAtIndex: 1].name isEqual: @"body"]);
-                assert(isclass([file childAtIndex: 0], NSXMLElement));
-                assert(isclass([file childAtIndex: 1], NSXMLElement));
-                
-                
-                attrs = xml_attrdict(file);
-                assert(attrs[@"original"].objectValue           );
-                assert(attrs[@"source-language"].objectValue    );
-                assert(attrs[@"target-language"].objectValue    );
-                assert(attrs[@"datatype"].objectValue           );
-                
-                if (!sourceLanguage) sourceLanguage = attrs[@"source-language"].objectValue;
-                else                 assert([sourceLanguage isEqual: attrs[@"source-language"].objectValue]);
-                if (!targetLanguage) targetLanguage = attrs[@"target-language"].objectValue;
-                else                 assert([targetLanguage isEqual: attrs[@"target-language"].objectValue]);
-                
-                mflog("Attributes: %@", attrs);
-                
-                /// Validate `<header>`
-                
-                NSXMLNode *header = [file childAtIndex:0];
-                assert(header.childCount == 1);
-                NSXMLNode *tool = [header childAtIndex:0];
-                assert([tool.name isEqual: @"tool"]);
-                assert( isclass(tool, NSXMLElement) );
-                attrs = xml_attrdict((NSXMLElement *)tool);
-                assert([attrs[@"tool-id"].objectValue       isEqual: @"com.apple.dt.xcode"] );
-                assert([attrs[@"tool-name"].objectValue     isEqual: @"Xcode"]              );
-                if ((0)) { /// We hope our code can support other versions, too?
-                    assert([attrs[@"tool-version"].objectValue  isEqual: @"16.1"]               );
-                    assert([attrs[@"build-num"].objectValue     isEqual: @"16B5001e"]           );
-                }
-            }
-            
-            NSArray<NSXMLElement *> *transUnits = (id)[xml_childnamed(file, @"body") children];
-            
-            NSMutableArray<NSXMLElement *> *filteredTransUnits = [NSMutableArray new]; /// Filter out transUnits with `kMFTransUnitState_DontTranslate` (Why does Xcode even export those?)  || Reimplements the logic in `rowModel_getCellModel` Maybe we should reuse that? [Oct 2025]
-            {
-                for (NSXMLElement *transUnit in transUnits) {
-                    if ([xml_attr(transUnit, @"translate").objectValue isEqual: @"no"])
-                        continue;
-                    [filteredTransUnits addObject: transUnit];
+        for (NSInteger i = 0; i < xliff->filePaths.count; i++) {
+            [self->files addObject: File_Make(xliff->transUnitsByFile[i], xliff->filePaths[i], i)];
+            [transUnitsFromAllFiles addObjectsFromArray: xliff->transUnitsByFile[i]];
+        }
+        self->_filesByFileIndex = [self->files copy];
+        
+        [self->files insertObject: (id)@"separator" atIndex: 0];
+        [self->files insertObject: File_Make(transUnitsFromAllFiles, kMFPath_AllDocuments, -1) atIndex: 0];
+        
+        /// Name the files
+        ///     Once here, instead of on every `uiStringForFile:` – that's called for every visible cell in `kMFPath_AllDocuments` and during menu validation (`kMFStr_RevealInFile`) [Oct 2026]
+        auto usedUIStrings = [NSMutableSet<NSString *> new];
+        for (File *f in self->files) {
+            if ([f isEqual: @"separator"]) continue;
+            NSString *uiString =
+                [[f->path lastPathComponent] stringByDeletingPathExtension]
+                //[f->path lastPathComponent] /// This is too cluttered and less scannable, although it makes it more understandable that you're looking at file-names. We also tried graying-out the file-extensions (d3304d8499b45eac15d7df2e8d394b548fe90b48) but it still feels cluttered. [Dec 2025]
+            ;
+            for (int i = 1;; i++) {
+                NSString *appendix = (i == 1) ? @"" : stringf(@" (%d)", i);
+                NSString *uiStringgg = stringf(@"%@%@", uiString, appendix);
+                if (![usedUIStrings containsObject: uiStringgg]) {
+                    [usedUIStrings addObject: uiStringgg];
+                    f->uiString = uiStringgg;
+                    break;
                 }
             }
-            if (filteredTransUnits.count) {
-                [self->files addObject: File_Make(filteredTransUnits, xml_attr(file, @"original").objectValue)];
-                [transUnitsFromAllFiles addObjectsFromArray: filteredTransUnits];
-            }
         }
-        [self->files insertObject: (id)@"separator" atIndex: 0];
-        [self->files insertObject: File_Make(transUnitsFromAllFiles, kMFPath_AllDocuments) atIndex: 0];
         self->_transUnitsFromAllFiles = transUnitsFromAllFiles;
+        self->_rowStore = xliff->rowStore;
         
-        self->sourceLanguage = sourceLanguage;
-        self->targetLanguage = targetLanguage;
+        self->sourceLanguage = xliff->sourceLanguage;
+        self->targetLanguage = xliff->targetLanguage;
     }
     
     - (void)reloadData {
@@ -185,6 +127,48 @@ File *File_Make(NSArray<NSXMLElement *> *transUnits, NSString *path) {
     
     #define kAllTransUnitsIndex 0
     
+    - (void) applyMergedXliff: (Xliff *)xliff changedItems: (NSArray<NSXMLElement *> *)changedItems {
+        
+        /// Shows an xliff that was merged from disk, without resetting the UI (See `XliffMerge.m`) [Oct 2026]
+        ///     If the files are the same, they're updated in place. Otherwise the list is rebuilt, and we go back to the file that was selected – if it's still there.
+        
+        File *selectedFile = self->files[self.selectedRow];
+        BOOL filesChanged = xliff->filePaths.count != self->_filesByFileIndex.count;
+        for (NSInteger i = 0; !filesChanged && i < (NSInteger)xliff->filePaths.count; i++)
+            filesChanged = ![xliff->filePaths[i] isEqual: self->_filesByFileIndex[i]->path];
+        
+        if (!filesChanged) {
+            auto transUnitsFromAllFiles = [NSMutableArray new];
+            for (NSInteger i = 0; i < (NSInteger)xliff->filePaths.count; i++) {
+                self->_filesByFileIndex[i]->transUnits = xliff->transUnitsByFile[i];
+                [transUnitsFromAllFiles addObjectsFromArray: xliff->transUnitsByFile[i]];
+            }
+            self->files[kAllTransUnitsIndex]->transUnits = transUnitsFromAllFiles;
+            self->_transUnitsFromAllFiles = transUnitsFromAllFiles;
+            self->_rowStore = xliff->rowStore;
+        }
+        else {
+            NSString *selectedPath = selectedFile->path;
+            [self setXliff: xliff];
+            NSInteger row = [self->files indexOfObjectPassingTest: ^BOOL (File *f, NSUInteger i, BOOL *stop) {
+                return ![f isEqual: @"separator"] && [f->path isEqual: selectedPath];
+            }];
+            if (row == NSNotFound) { /// The file is gone – start over like after opening
+                [self reloadData];
+                [getdoc(self)->ctrl->out_tableView reloadWithNewData: self->files[self.selectedRow]->transUnits]; /// In case the selected row didn't change
+                return;
+            }
+            self->_isApplyingMergedXliff = YES;
+            [super reloadData];
+            [self selectRowIndexes: indexset(row) byExtendingSelection: NO];
+            self->_isApplyingMergedXliff = NO;
+            selectedFile = self->files[row];
+        }
+        
+        [getdoc(self)->ctrl->out_tableView reloadWithChangedData: selectedFile->transUnits changedItems: changedItems];
+        [self progressHasChanged];
+    }
+    
     - (void) showAllTransUnits {
     
         NSInteger row = kAllTransUnitsIndex;
@@ -205,19 +189,13 @@ File *File_Make(NSArray<NSXMLElement *> *transUnits, NSString *path) {
     
     - (File *) fileForTransUnit: (NSXMLElement *)transUnit {
         
-        /// TODO:
-        ///     Maybe just look at the parent node (for performance – if that matters)
-        ///         Structure: `<file original="App/UI/Main/Base.lproj/Main.storyboard"> <body> <trans-unit> ....`)
+        /// O(1) – The `RowStore` knows the file of every row. (This used to `containsObject:` through every file, which made menu validation stutter on large documents) [Oct 2026]
+        ///     Returns nil for transUnits that aren't part of the current xliff (e.g. from the undo stack after a revert)
         
-        for (int i = 0; i < files.count; i++) {
-            if (i == 0) continue; /// Skip the allTransUnits item  [Oct 2025]
-            if ([files[i] isEqual: @"separator"]) continue;
-            
-            if ([files[i]->transUnits containsObject: transUnit]) {
-                return files[i];
-            };
-        }
-        return nil;
+        NSInteger row;
+        RowStore *store = rowStore_lookup(transUnit, &row);
+        if (!store || store != self->_rowStore) return nil;
+        return self->_filesByFileIndex[store->fileIndexes[row]];
     }
     
     - (NSString *) filenameForTransUnit: (NSXMLElement *)transUnit {
@@ -226,6 +204,8 @@ File *File_Make(NSArray<NSXMLElement *> *transUnits, NSString *path) {
     
     
     - (void) progressHasChanged {
+        
+        mftrace_scope("progressHasChanged");
 
         /// This seems to complicated for what we're doing - why two methods for this? [Oct 2025]
         for (NSInteger row = 0; row < self.numberOfRows; row++) {
@@ -243,18 +223,10 @@ File *File_Make(NSArray<NSXMLElement *> *transUnits, NSString *path) {
             /// Determine progress percent
             double progress = -1;
             {
-                NSInteger count_translated = 0;
-                NSInteger count_all = 0;
-                for  (NSXMLElement *transUnit in file->transUnits) {
-                    if (rowModel_isPluralParent(transUnit))
-                        continue; /// Ignore the isTranslated state of parentRows see `stateOfRowModel:`
-                    if ([rowModel_getCellModel(transUnit, @"state") isEqual: kMFTransUnitState_Translated])
-                        count_translated += 1;
-                    count_all += 1;
-                }
-                progress = (double)count_translated / count_all;
+                MFProgress p = rowStore_getProgress(self->_rowStore, file->fileIndex); /// O(1) – this runs for every file on every state change [Oct 2026]
+                progress = (double)p.translated / p.total;
                 
-                if ((0)) mflog(@"locprogress: %@ (%@), translated: %@, all: %@", @(progress), @((int)(progress * 100)), @(count_translated), @(count_all));
+                if ((0)) mflog(@"locprogress: %@ (%@), translated: %@, all: %@", @(progress), @((int)(progress * 100)), @(p.translated), @(p.total));
             }
             
             /// Create string
@@ -274,6 +246,21 @@ File *File_Make(NSArray<NSXMLElement *> *transUnits, NSString *path) {
                     range: NSMakeRange(0, s.length)
                 ];
             }
+            
+            /// Prepend the issue count [Oct 2026]
+            ///     O(1) too – counted by the `RowStore`. (See `Validator.m`)
+            NSInteger issueCount = rowStore_getIssueCount(self->_rowStore, file->fileIndex);
+            if (issueCount) {
+                auto issuesString = make_issue_symbol(kMFStr_Issues);
+                [issuesString appendAttributedString: attributed(stringf(@" %ld   ", issueCount))];
+                [issuesString addAttributes: @{
+                    NSFontAttributeName: [NSFont systemFontOfSize: 12],
+                    NSForegroundColorAttributeName: [NSColor systemOrangeColor],
+                } range: NSMakeRange(0, issuesString.length)];
+                [s insertAttributedString: issuesString atIndex: 0];
+            }
+            progressField.toolTip = issueCount ? kMFStr_IssueCount(issueCount) : nil;
+            
             s;
         });
     }
@@ -373,24 +360,7 @@ File *File_Make(NSArray<NSXMLElement *> *transUnits, NSString *path) {
         if (!file) return nil;
         if ([file isEqual: @"separator"]) return nil;
         
-        NSMutableArray *allUIStrings = [NSMutableArray new];
-        for (File *f in self->files) {
-            if ([f isEqual: @"separator"]) { [allUIStrings addObject: @""]; continue; }
-            NSString *uiString =
-                [[f->path lastPathComponent] stringByDeletingPathExtension]
-                //[f->path lastPathComponent] /// This is too cluttered and less scannable, although it makes it more understandable that you're looking at file-names. We also tried graying-out the file-extensions (d3304d8499b45eac15d7df2e8d394b548fe90b48) but it still feels cluttered. [Dec 2025]
-            ;
-            for (int i = 1;; i++) {
-                NSString *appendix = (i == 1) ? @"" : stringf(@" (%d)", i);
-                NSString *uiStringgg = stringf(@"%@%@", uiString, appendix);
-                if (![allUIStrings containsObject: uiStringgg]) {
-                    [allUIStrings addObject: uiStringgg];
-                    break;
-                }
-            }
-        }
-    
-        return allUIStrings[[self->files indexOfObject: file]];
+        return file->uiString; /// Computed in `setXliff:` [Oct 2026]
     }
     
     - (NSView *) outlineView: (NSOutlineView *)outlineView viewForTableColumn: (NSTableColumn *)tableColumn item: (File *)file {
@@ -473,6 +443,7 @@ File *File_Make(NSArray<NSXMLElement *> *transUnits, NSString *path) {
     - (void) outlineViewSelectionDidChange: (NSNotification *)notification {
         //runOnMain(0.0, ^{ /// Defer so our selection drawing can update first, making things feel more responsive [Nov 2025]
                             /// Update: [Dec 2025] Disable since making this non-synchronous breaks `_revealTransUnit:` > `Navigate UI`. Solution idea: Only make it sync when triggered programmatically.
+            if (self->_isApplyingMergedXliff) return;
             File *file = self->files[self.selectedRow];
             [getdoc(self)->ctrl->out_tableView reloadWithNewData: file->transUnits];
         //});
@@ -0,0 +1,100 @@
+//
+//  StringTable.m
+//  mf-xcloc-editor
+//
+//  Created by Noah Nübling on 10/17/26.
+//
+
+/// Interned strings, shared by all the .xcloc files of a project [Oct 2026]
+///
+///     Why: An export has one .xcloc per language, and the ids, sources and notes are the same in all of them. Without this, opening 17 languages kept 17 copies of every one of those strings.
+///         Now every `RowStore` in a project folder points at the same NSString instances, and only the targets and states are per-language. (See `Xliff_Stream()`)
+///
+///     Sharing: One table per folder (See `StringTable_ForProject()`). Each `RowStore` retains the table, so it lives as long as any document of the project is open.
+///     Threads: Interning is safe from any thread – the loaders run concurrently (See `XclocProject.m`). The set is split into shards with one lock each, so parallel loads don't serialize on a single lock.
+
+#define kStringTableShardCount 16 /// Power of 2
+
+@interface StringTable : NSObject
+    {
+        @public
+        NSMutableSet<NSString *> *shards[kStringTableShardCount];
+        mflock_t locks[kStringTableShardCount];
+        NSMutableDictionary<NSString *, NSString *> *displayNotes; /// note -> `_rowModel_cleanUpNote()` of it. Guarded by `displayNotesLock`.
+        mflock_t displayNotesLock;
+    }
+@end
+@implementation StringTable
+    - (instancetype) init {
+        self = [super init];
+        for (int i = 0; i < kStringTableShardCount; i++) {
+            self->shards[i] = [NSMutableSet new];
+            self->locks[i]  = MFLOCK_INIT;
+        }
+        self->displayNotes = [NSMutableDictionary new];
+        self->displayNotesLock = MFLOCK_INIT;
+        return self;
+    }
+@end
+
+StringTable *StringTable_ForProject(NSString *projectDir) {
+
+    /// Returns the table for the .xcloc files in `projectDir` – the same one for as long as one of them is loaded.
+
+    static NSMapTable<NSString *, StringTable *> *tables; /// Weak values – the `RowStore`s keep the tables alive
+    static mflock_t lock = MFLOCK_INIT;
+
+    NSString *key = projectDir.stringByStandardizingPath;
+
+    mflock(&lock);
+    if (!tables) tables = [NSMapTable strongToWeakObjectsMapTable];
+    StringTable *t = [tables objectForKey: key];
+    if (!t) {
+        t = [StringTable new];
+        [tables setObject: t forKey: key];
+    }
+    mfunlock(&lock);
+
+    return t;
+}
+
+NSString *_Nullable stringTable_intern(StringTable *_Nullable t, NSString *_Nullable s) {
+
+    /// Returns the table's instance of `s`, adding `s` if it's new. Passes through nil (and everything, if there's no table).
+
+    if (!t || !s) return s;
+
+    NSUInteger shard = s.hash & (kStringTableShardCount - 1);
+    mflock(&t->locks[shard]);
+    NSString *result = [t->shards[shard] member: s];
+    if (!result) {
+        result = [s copy]; /// Don't keep mutable strings
+        [t->shards[shard] addObject: result];
+    }
+    mfunlock(&t->locks[shard]);
+
+    return result;
+}
+
+NSString *_Nullable stringTable_displayNote(StringTable *_Nullable t, NSString *_Nullable note, NSString *_Nullable (*cleanUp)(NSString *_Nullable note)) {
+
+    /// Memoizes `cleanUp(note)` across the documents of the project. The notes are the same in every language, so only the first document to build its `displayNotes` pays for the cleanup. (See `_buildRowStoreCachesInBackground()`)
+    ///     `cleanUp` runs outside the lock – if two documents race on the same note, both compute it and the first result wins.
+
+    if (!t || !note) return cleanUp(note);
+
+    mflock(&t->displayNotesLock);
+    NSString *cached = t->displayNotes[note];
+    mfunlock(&t->displayNotesLock);
+    if (cached) return cached == (id)[NSNull null] ? nil : cached;
+
+    NSString *result = stringTable_intern(t, cleanUp(note));
+
+    mflock(&t->displayNotesLock);
+    cached = t->displayNotes[note];
+    if (!cached) t->displayNotes[note] = result ?: (id)[NSNull null];
+    mfunlock(&t->displayNotesLock);
+
+    if (cached) return cached == (id)[NSNull null] ? nil : cached;
+    return result;
+}
@@ -5,12 +5,15 @@
 //  Created by Noah Nübling on 09.06.25.
 //
 
+    @class TMSuggestion;
+
     @interface TableView : NSOutlineView
         <
             NSOutlineViewDataSource,
             NSOutlineViewDelegate,
             NSControlTextEditingDelegate,
             NSMenuItemValidation,
+            NSMenuDelegate,
             QLPreviewPanelDelegate,
             QLPreviewPanelDataSource
         >
@@ -19,11 +22,22 @@
         }
         
         - (void) reloadWithNewData: (NSArray <NSXMLElement *> *)transUnits;
+        - (void) reloadWithChangedData: (NSArray <NSXMLElement *> *)transUnits changedItems: (NSArray<NSXMLElement *> *)changedItems;
         - (void) updateFilterString: (NSString *)newFilterString;
         - (void) updateFilterOptions: (NSStringCompareOptions)options;
+        - (void) updateFilterOnlyIssues: (BOOL)onlyIssues;
         - (IBAction) togglePreviewPanel:(id)previewPanel;
         - (void) returnFocus;
         - (void) toggleIsTranslatedState: (NSXMLElement *)transUnit;
         - (BOOL) rowIsTranslated: (NSXMLElement *)transUnit;
         - (NSXMLElement *) selectedItem;
+        - (NSArray<NSXMLElement *> *) selectedItems;
+        - (NSArray<NSXMLElement *> *) displayedItems;
+        - (NSArray<NSXMLElement *> *) bulkEditableRowModels: (NSArray<NSXMLElement *> *)transUnits;
+        - (BOOL) allRowsAreTranslated: (NSArray<NSXMLElement *> *)transUnits;
+        - (NSArray<NSXMLElement *> *) bulkEditableSelection: (BOOL *_Nullable)outAllTranslated;
+        - (void) setIsTranslatedState: (BOOL)newIsTranslatedState onRowModels: (NSArray<NSXMLElement *> *)transUnits;
+        - (void) setStates: (NSArray<NSString *> *)states targets: (NSArray<NSString *> *_Nullable)targets onRowModels: (NSArray<NSXMLElement *> *)transUnits actionName: (NSString *)actionName;
+        - (NSArray<TMSuggestion *> *_Nullable) translationMemorySuggestionsForItem: (NSXMLElement *)transUnit;
+        - (void) useTranslationMemorySuggestion: (TMSuggestion *)suggestion onRowModel: (NSXMLElement *)transUnit;
     @end
@@ -11,9 +11,8 @@
 ///     https://developer.apple.com/library/archive/documentation/Cocoa/Conceptual/TableView/PopulatingView-TablesProgrammatically/PopulatingView-TablesProgrammatically.html#//apple_ref/doc/uid/10000026i-CH14-SW1
 ///
 
-static int __invocations = 0; /// Performance testing
 static int __invocation_rowheight = 0;
-static CGFloat _defaultRowHeight = 75 /*100*/; /// We return this in `heightOfRowByItem:`  || Tradeoff: higher -> faster load times, too-high -> 'fights you' when scrolling up (not just jitter), 100 'fights you' 75 is fine. [NOv 2025]
+static CGFloat _defaultRowHeight = 31; /// We return this in `heightOfRowByItem:` for rows that haven't been measured yet – only for a moment (See `RowHeights.m`). One line, the most common height. [Oct 2026] || Used to be 75 as a tradeoff for `usesAutomaticRowHeights`: higher -> faster load times, too-high -> 'fights you' when scrolling up. [Nov 2025]
 
 #pragma mark - MFQLPreviewItem
 
@@ -68,41 +67,7 @@ auto reusableViewIDs = @[ /// Include any IDs that we call `makeViewWithIdentifi
         [super drawSeparatorInRect: dirtyRect];
     }
     
-    - (void) setFrame: (NSRect)frame {
-        
-        
-        /// HACK to fix jitter when scroling up.
-        /// Purpose:
-        ///     adjust scrollPosition when system loads 'real' height of a row to prevent shifting of the rows below which is perceived as jitter.
-        /// Context:
-        ///     See `heightOfRowByItem:` and `_defaultRowHeight`
-        /// Observations: [Nov 2025, macOS Tahoe]
-        ///     I observed that the table already adjusts the scroll position when it initially loads and the view. It seems to use the `_defaultRowHeight` value we give to it often but sometimes
-        ///     it uses different values, perhaps trying to predict based on previously loaded views or something like that. It then however calls setFrame: again with the final, actual size of the view, but it *doesn't* adjust the scroll position for that second resizing.
-        ///     Once the final actual size of the row has been determined once, it always immediately uses that size when the view comes into the viewport again. reloadData: seems to reset everything.
-        ///     -> This code tries to catch the 'second resizing' case and adjust the scroll-position.
-        /// Caveats:
-        ///     - This is a workaround for what seems to be a bug in NSTableView, which is possibly triggered by our override of `heightByRowItem:` to return a constant `_defaultRowHeight` which makes loading dramatically faster for some reason (probably also due to bugs / suboptimal code in the framework)
-        ///         -> On macOS versions where these bugs aren't present, these workarounds could cause issues. But on macOS 26 Tahoe, they seem to work very well.
-        ///     - There are still sometimes small scroll-position jumps with this [Nov 2025] but it's much better than without, and am too lazy to investigate further.
-
-        if (
-            self.frame.size.height == _defaultRowHeight && frame.size.height != _defaultRowHeight &&
-            NSEqualRects(NSRectFromRect(self.frame, .height = 0), NSRectFromRect(frame, .height = 0)) /// Not sure this check is necessary, but matches what I've observed [Nov 2025]
-        ) {
-        
-            auto clipView = [[self enclosingScrollView] contentView];
-            
-            if (clipView.bounds.origin.y > self.frame.origin.y) { /// Row loaded at the top of the viewport (scrolling up)
-                auto boundsOrigin = [clipView bounds].origin;
-                boundsOrigin.y += frame.size.height - _defaultRowHeight;
-                [clipView setBoundsOrigin: boundsOrigin];
-            }
-            else ; /// Row loaded at the bottom of the viewport (scrolling down)
-        }
-            
-        [super setFrame: frame];
-    }
+    /// Note: There used to be a `setFrame:` override here that adjusted the scroll position when a row's real height came in. Not needed since the heights are measured in advance. (See `RowHeights.m`) [Oct 2026]
 
 @end
 
@@ -112,9 +77,27 @@ auto reusableViewIDs = @[ /// Include any IDs that we call `makeViewWithIdentifi
     {
         NSString *_filterString;
         NSStringCompareOptions _filterOptions;
-        NSMutableArray<NSXMLElement *> *_displayedTopLevelTransUnits; /// Main dataModel displayed by this table. Does not contain transUnits which are children || Terminology: We call these rowModels, OutlineView-Items, or transUnits – All these terms refer to the same thing [Oct 2025]
-        NSMutableDictionary<NSXMLElement *, NSArray<NSXMLElement *> *> *_childrenMap; /// Maps topLevel transUnits to their pluralizable variant children
+        BOOL _filterOnlyIssues;                         /// Only show rows with issues (See `Validator.m`) [Oct 2026]
+        NSArray<NSXMLElement *> *_lastFilter_matches;   /// Unsorted results of the last filter pass that's shown + the inputs that produced them. See `_applyFilterQuery:` [Oct 2026]
+        NSArray<NSXMLElement *> *_lastFilter_transUnits;
+        NSString *_lastFilter_string;
+        NSStringCompareOptions _lastFilter_options;
+        BOOL _lastFilter_onlyIssues;
+        NSUInteger _lastFilter_editCount;
+        NSMapTable<NSXMLElement *, NSDictionary<NSString *, NSArray<NSValue *> *> *> *_filterMatchRanges; /// transUnit -> columnID -> ranges of the `filter-highlights` in the cell's uiString. The `highlights` of the filter pass that's shown, kept up to date for edited rows (See `_updateFilterHighlightsOfItem:`) [Oct 2026]
+        NSRegularExpression *_filterRegex;              /// `_lastFilter_string` compiled once per filter pass, if it's a regex [Oct 2026]
+        NSUInteger _filterGeneration;                   /// Generation of the newest `FilterQuery`. Atomic – read by the queries in the background. [Oct 2026]
+        RowHeights *_rowHeights; /// See `RowHeights.m` [Oct 2026]
+        NSArray<NSXMLElement *> *_bulkSelection;        /// Cache of `bulkEditableSelection:` – nil if it's outdated [Oct 2026]
+        BOOL _bulkSelection_allTranslated;
+        NSIndexSet *_bulkSelection_rows;
+        RowStore *_bulkSelection_store;
+        NSUInteger _bulkSelection_editCount;
+        BOOL _rowHeightsShowFilenames;                  /// `allTransUnitsShown` as of the last background pass. When it flips, every row's `filename-field` does – so the next pass has to measure all rows.
+        NSMutableArray<NSXMLElement *> *_displayedTopLevelTransUnits; /// Main dataModel displayed by this table. Does not contain transUnits which are children (See `rowModel_getChildren()`) || Terminology: We call these rowModels, OutlineView-Items, or transUnits – All these terms refer to the same thing [Oct 2025]
         id _lastQLPanelDisplayState;
+        NSArray<TMSuggestion *> *_tmSuggestions;        /// Translation memory suggestions for `_tmSuggestionsItem` – the selected row, once the query comes back (See `_updateTranslationMemorySuggestions`) [Oct 2026]
+        NSXMLElement *_tmSuggestionsItem;
         NSString *_lastTargetCellString;
         BOOL didJustEndEditingWithReturnKey;
     }
@@ -128,6 +111,8 @@ auto reusableViewIDs = @[ /// Include any IDs that we call `makeViewWithIdentifi
         
         self.delegate   = self; /// [Jun 2025] Will this lead to retain cycles or other problems?
         self.dataSource = self;
+        
+        self.allowsMultipleSelection = YES; /// For marking many rows at once (See `setIsTranslatedState:onRowModels:`). Everything else goes by `selectedRow` – the last row that was selected. [Oct 2026]
 
         /// Listen for field editor notifications to reload source cell when editing begins/ends
         [[NSNotificationCenter defaultCenter]
@@ -260,6 +245,7 @@ auto reusableViewIDs = @[ /// Include any IDs that we call `makeViewWithIdentifi
                     /// Reload target cell
                     ///     This is only necessary to restore the `filter-highlights`, which the editing (Swapping in the field-editor) seems to remove.[Dec 2025]
                     ///     For the other (non-editable) columns we solve this by setting `.allowsEditingTextAttributes = YES` [Dec 2025]
+                    ///     The highlights come from `_filterMatchRanges`, so this doesn't run the filter again. [Oct 2026]
                     [self reloadDataForRowIndexes: indexset([self rowForView: textField__]) columnIndexes: indexset([self columnForView: textField__])];
                 }
                 endof_handleEditing: {};
@@ -272,7 +258,7 @@ auto reusableViewIDs = @[ /// Include any IDs that we call `makeViewWithIdentifi
             | NSTableViewSolidHorizontalGridLineMask
         ;
         self.style = NSTableViewStyleFullWidth;
-        self.usesAutomaticRowHeights = YES;
+        self.usesAutomaticRowHeights = NO; /// We measure the heights ourselves (See `RowHeights.m`) [Oct 2026]
         self.indentationPerLevel = 20.0;
         self.autoresizesOutlineColumn = NO; /// This makes the column-width be auto-resized according to Claude - we don't want that I think
         
@@ -281,6 +267,14 @@ auto reusableViewIDs = @[ /// Include any IDs that we call `makeViewWithIdentifi
         for (NSString *viewID in reusableViewIDs)
             [self registerNib: nib forIdentifier: viewID];
         
+        /// Set up row-height measuring
+        ///     With the fonts from the nib, so the measurements match the cells. [Oct 2026]
+        {
+            NSTableCellView *tableCell = [self makeViewWithIdentifier: @"theReusableCell_Table" owner: self];
+            NSTableCellView *idCell    = [self makeViewWithIdentifier: @"theReusableCell_TableID" owner: self];
+            self->_rowHeights = RowHeights_Make(tableCell.textField.font, ((NSTextField *)[idCell searchSubviewWithIdentifier: @"filename-field"]).font);
+        }
+        
         /// Add columns
         {
             auto mfui_tablecol = ^NSTableColumn *(NSString *identifier, NSString *title, NSInteger minWidth, NSInteger defaultWidth, NSInteger maxWidth, BOOL autoresizes) {
@@ -344,6 +338,7 @@ auto reusableViewIDs = @[ /// Include any IDs that we call `makeViewWithIdentifi
                 mfui_sepitem(),
                 mfui_item(@"reveal_in_file",     @"", @""),                                         /// UIStrings now generated in `validateMenuItem:`
             ]);
+            self.menu.delegate = self; /// Adds the translation memory suggestions in `menuNeedsUpdate:` [Oct 2026]
         }
         
         /// Sync with filter-menu-items in the mainMenu
@@ -418,7 +413,16 @@ auto reusableViewIDs = @[ /// Include any IDs that we call `makeViewWithIdentifi
     - (void) tableMenuItemClicked: (NSMenuItem *)menuItem {
         
         if ([menuItem.identifier isEqual: @"mark_for_review"]) {
-            [self toggleIsTranslatedState: [self itemAtRow: [self clickedRow]]]; /// All our menuItems are for toggling and `validateMenuItem:` makes it so we can only toggle [Oct 2025]
+            if ([self _clickedRowIsInMultipleSelection]) {
+                auto rows = [self bulkEditableRowModels: [self selectedItems]];
+                [self setIsTranslatedState: ![self allRowsAreTranslated: rows] onRowModels: rows]; /// Like Finder: Right-clicking a selected row acts on the whole selection [Oct 2026]
+            }
+            else
+                [self toggleIsTranslatedState: [self itemAtRow: [self clickedRow]]]; /// All our menuItems are for toggling and `validateMenuItem:` makes it so we can only toggle [Oct 2025]
+        }
+        
+        else if ([menuItem.identifier isEqual: @"tm_suggestion"]) {
+            [self useTranslationMemorySuggestion: menuItem.representedObject onRowModel: [self itemAtRow: [self clickedRow]]];
         }
         
         else if ([menuItem.identifier isEqual: @"reveal_in_file"]) {
@@ -437,10 +441,25 @@ auto reusableViewIDs = @[ /// Include any IDs that we call `makeViewWithIdentifi
         }
     }
     
+    - (BOOL) _clickedRowIsInMultipleSelection {
+        return self.selectedRowIndexes.count > 1 && [self.selectedRowIndexes containsIndex: [self clickedRow]];
+    }
+    
     - (BOOL) validateMenuItem: (NSMenuItem *)menuItem {
         
         NSXMLElement *transUnit = [self itemAtRow: [self clickedRow]]; /// This is a right-click menu so we use `clickedRow` instead of `selectedItem`
         
+        /// Handle review-items for the whole selection [Oct 2026]
+        if ([menuItem.identifier isEqual: @"mark_for_review"] && [self _clickedRowIsInMultipleSelection]) {
+            
+            BOOL allTranslated;
+            auto rows = [self bulkEditableSelection: &allTranslated];
+            menuItem.title = stringf(@"%@ (%ld Rows)", allTranslated ? kMFStr_MarkForReview : kMFStr_MarkAsTranslated, rows.count);
+            menuItem.image = [NSImage imageWithSystemSymbolName: allTranslated ? kMFStr_MarkForReview_Symbol : kMFStr_MarkAsTranslated_Symbol accessibilityDescription: nil];
+            
+            return rows.count > 0;
+        }
+        
         if ([[self stateOfRowModel: transUnit] isEqual: @"mf_dont_translate"]) return NO;
         
         /// Handle review-items
@@ -459,6 +478,10 @@ auto reusableViewIDs = @[ /// Include any IDs that we call `makeViewWithIdentifi
             if (rowModel_isPluralParent(transUnit)) return NO;
             else                                    return YES;
         }
+        /// Handle translation memory items
+        if ([menuItem.identifier isEqual: @"tm_suggestion"]) return YES;
+        if ([menuItem.identifier isEqual: @"tm_header"])     return NO;
+        
         /// Handle reveal-items
         if ([menuItem.identifier isEqual: @"reveal_in_file"]) {
         
@@ -477,6 +500,72 @@ auto reusableViewIDs = @[ /// Include any IDs that we call `makeViewWithIdentifi
         return NO; //[super validateMenuItem: menuItem]; /// Throws unrecognizedselector exception [Dec 2025]
     }
     
+    - (void) menuNeedsUpdate: (NSMenu *)menu {
+        
+        /// Appends the translation memory suggestions for the clicked row [Oct 2026]
+        
+        if (menu != self.menu) return;
+        
+        for (NSMenuItem *item in [menu.itemArray copy])
+            if ([item.identifier hasPrefix: @"tm_"]) [menu removeItem: item];
+        
+        NSXMLElement *transUnit = [self itemAtRow: [self clickedRow]];
+        if (!transUnit || [self _clickedRowIsInMultipleSelection]) return;
+        
+        NSArray<TMSuggestion *> *suggestions = [self translationMemorySuggestionsForItem: transUnit];
+        if (suggestions) { [self _appendTranslationMemorySuggestions: suggestions toMenu: menu]; return; }
+        
+        /// Not looked up yet – e.g. right-clicking a row that isn't selected
+        ///     Show that we're looking, and fill in the results while the menu is open. A lookup in a big memory takes long enough to notice if the menu waited for it.
+        BOOL isLookingUp = [self _lookUpTranslationMemorySuggestionsForItem: transUnit completion: ^(NSArray<TMSuggestion *> *suggestions) {
+            if ([menu indexOfItemWithRepresentedObject: transUnit] == -1) return; /// The menu was closed and updated for another row in the meantime
+            for (NSMenuItem *item in [menu.itemArray copy])
+                if ([item.identifier hasPrefix: @"tm_"]) [menu removeItem: item];
+            if ([self itemAtRow: [self clickedRow]] == transUnit)
+                [self _appendTranslationMemorySuggestions: suggestions toMenu: menu];
+        }];
+        if (!isLookingUp) return;
+        
+        NSMenuItem *separator = [NSMenuItem separatorItem];
+        separator.identifier = @"tm_separator";
+        [menu addItem: separator];
+        
+        NSMenuItem *loading = [NSMenuItem new];
+        loading.identifier = @"tm_loading";
+        loading.title = kMFStr_TranslationMemoryLoading; /// No action – so it's disabled
+        loading.representedObject = transUnit; /// Lets the completion tell whether the menu still shows this lookup
+        [menu addItem: loading];
+    }
+    
+    - (void) _appendTranslationMemorySuggestions: (NSArray<TMSuggestion *> *)suggestions toMenu: (NSMenu *)menu {
+        
+        if (!suggestions.count) return;
+        
+        NSMenuItem *separator = [NSMenuItem separatorItem];
+        separator.identifier = @"tm_separator";
+        [menu addItem: separator];
+        
+        NSMenuItem *header = [NSMenuItem new];
+        header.identifier = @"tm_header";
+        header.title = kMFStr_TranslationMemory;
+        header.image = [NSImage imageWithSystemSymbolName: kMFStr_TranslationMemory_Symbol accessibilityDescription: nil];
+        header.action = @selector(tableMenuItemClicked:); /// Disabled by `validateMenuItem:` – a section header
+        header.target = self;
+        [menu addItem: header];
+        
+        for (TMSuggestion *suggestion in suggestions) {
+            NSMenuItem *item = [NSMenuItem new];
+            item.identifier = @"tm_suggestion";
+            item.title = kMFStr_TranslationMemorySuggestion(suggestion);
+            item.toolTip = suggestion->source;
+            item.representedObject = suggestion;
+            item.action = @selector(tableMenuItemClicked:);
+            item.target = self;
+            item.indentationLevel = 1;
+            [menu addItem: item];
+        }
+    }
+    
     #pragma mark - Mouse Control
         
         /// When you click a non-selected row, you have to way to click again to start editing. Otherwise the 'double click' will do nothing.
@@ -663,11 +752,20 @@ auto reusableViewIDs = @[ /// Include any IDs that we call `makeViewWithIdentifi
     - (void) updateFilterString:  (NSString *)string              { [self _updateFilterStuff_string: string              options: self->_filterOptions]; }
     - (void) updateFilterOptions: (NSStringCompareOptions)options { [self _updateFilterStuff_string: self->_filterString options: options]; }
     
+    - (void) updateFilterOnlyIssues: (BOOL)onlyIssues { /// Not debounced – it's a menu toggle, not typing [Oct 2026]
+        if (self->_filterOnlyIssues == onlyIssues) return;
+        self->_filterOnlyIssues = onlyIssues;
+        if (!self->transUnits) return; /// Called from `init` (See `updateFilterStuff:`) – `reloadWithNewData:` does the first filter pass
+        [self bigUpdateAndStuff_OnlyUpdateSorting: NO];
+    }
+    
     - (void) _updateFilterStuff_string: (NSString *)string options: (NSStringCompareOptions)options {
         
         mflog(@"options (immediate) (%p):%lu", self, options);
         
-        mfdebounce(0.2, stringf(@"updateFilter:%p", self), ^{ /// Keep typing in filterField responsive
+        #define kMFFilterDebounceDelay 0.1 /// Only coalesces keystrokes now – the filtering runs in the background and each pass cancels the previous one (See `_startFilterQuery`) [Oct 2026] || Keep typing in filterField responsive
+        
+        mfdebounce(kMFFilterDebounceDelay, stringf(@"updateFilter:%p", self), ^{
             
             mflog(@"options (debounce) (%p): %lu", self, options);
             
@@ -677,9 +775,113 @@ auto reusableViewIDs = @[ /// Include any IDs that we call `makeViewWithIdentifi
             ) return;
             self->_filterString = string;
             self->_filterOptions = options;
-            [self bigUpdateAndStuff_OnlyUpdateSorting: NO];
+            [self _startFilterQuery];
         });
     }
+    
+    - (FilterQuery *) _makeFilterQuery {
+        
+        /// Snapshots what a filter pass needs, so it can run on any thread (See `FilterQuery`). Main thread only. [Oct 2026]
+        ///     Starts a new generation – that cancels the queries that are still running.
+        
+        auto q = FilterQuery_Make(self->transUnits ?: @[], self->_filterString ?: @"", self->_filterOptions, self->_filterOnlyIssues);
+        q->generation = __atomic_add_fetch(&self->_filterGeneration, 1, __ATOMIC_RELAXED);
+        
+        /// Narrow down the previous results if possible
+        ///     When the user types one more character, only the rows that matched the shorter filterString can match the new one. So we don't have to rescan the whole file on every keystroke.
+        ///     Not valid for regexes (`a` -> `a|b` matches more rows), and not valid if a translation was edited in the meantime (The edited row might match now.)
+        if (
+            self->_lastFilter_matches &&
+            self->_lastFilter_transUnits == self->transUnits &&
+            self->_lastFilter_editCount == q->editCount &&
+            self->_lastFilter_options == q->options &&
+            self->_lastFilter_onlyIssues == q->onlyIssues &&
+            !(q->options & NSRegularExpressionSearch) &&
+            [self->_lastFilter_string length] && [q->filterString length] &&
+            [q->filterString rangeOfString: self->_lastFilter_string options: q->options].location != NSNotFound /// New filterString contains the old one
+        ) {
+            mflog(@"Narrowing down %ld previous matches", self->_lastFilter_matches.count);
+            q->candidates = self->_lastFilter_matches;
+        }
+        
+        return q;
+    }
+    
+    - (void) _startFilterQuery {
+        
+        /// Filters the table in the background. [Oct 2026]
+        ///     Only the final list of rows comes back to the main thread – and only if no newer pass has started in the meantime.
+        ///     Tracing: "filter.query" is the pass on the workers, "filter.apply" showing its results, and "filter.latency" all of it – from here until the table shows the new rows. Cancelled passes aren't recorded. (See `Trace.m`)
+        
+        if (!self->transUnits) return;
+        
+        MFTraceSpan latency = _mftrace_beginSpan("filter.latency"); /// Ends on another thread than it began – so no `mftrace_scope()`
+        FilterQuery *q = [self _makeFilterQuery];
+        if (!q->store) { [self bigUpdateAndStuff_OnlyUpdateSorting: NO]; return; } /// Not safe off the main thread
+        
+        q->sortDescriptors = self.sortDescriptors;
+        if (q->sortDescriptors.count) q->sortKeys = rowStore_snapshotSortKeys(q->store, q->sortDescriptors);
+        
+        dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+            
+            BOOL didFinish;
+            {
+                mftrace_scope("filter.query");
+                didFinish = filterQuery_run(q, &self->_filterGeneration);
+            }
+            if (!didFinish) {
+                mflog(@"Cancelled filter query '%@'", q->filterString);
+                return;
+            }
+            
+            dispatch_async(dispatch_get_main_queue(), ^{
+                if (__atomic_load_n(&self->_filterGeneration, __ATOMIC_RELAXED) != q->generation) return; /// A newer pass started
+                if (q->store->editCount != q->editCount) { [self _startFilterQuery]; return; }              /// Edited while we were in the background – the edited rows may match differently now
+                [self _bigUpdateAndStuff_OnlyUpdateSorting: NO keepViewport: NO filterQuery: q];
+                MFTraceSpan l = latency;
+                _mftrace_endSpan(&l);
+            });
+        });
+    }
+    
+    - (void) _applyFilterQuery: (FilterQuery *)q {
+        
+        /// Makes the matches of the finished query `q` the rows of the table. Sorting and the reload are up to the caller. [Oct 2026]
+        
+        mftrace_scope("filter.apply");
+        
+        _displayedTopLevelTransUnits = [q->matches mutableCopy];
+        
+        self->_lastFilter_matches    = q->matches; /// Unsorted, so narrowing preserves the document order
+        self->_lastFilter_transUnits = q->transUnits;
+        self->_lastFilter_editCount  = q->editCount;
+        self->_lastFilter_options    = q->options;
+        self->_lastFilter_onlyIssues = q->onlyIssues;
+        self->_lastFilter_string     = q->filterString;
+        
+        /// Cache the searchStrings that the query built
+        ///     Unless something was edited since the snapshot – an edited row's string would be stale.
+        if (q->store && q->store->editCount == q->editCount) {
+            [q->builtSearchStrings enumerateKeysAndObjectsUsingBlock: ^(NSNumber *row, NSString *searchString, BOOL *stop) {
+                q->store->searchStrings[row.integerValue] = searchString;
+            }];
+        }
+        
+        /// Show the `filter-highlights` of the query
+        ///     The workers found them along with the matches (See `filterQuery_run()`) – `_getCellView()` only reads them.
+        self->_filterMatchRanges = q->highlights;
+        self->_filterRegex = q->regex;
+    }
+    
+    - (void) _updateFilterHighlightsOfItem: (NSXMLElement *)transUnit {
+        
+        /// Call after editing a row that's shown – the highlights of the filter pass are for its old cells. Just the one row, so it's fine on the main thread. [Oct 2026]
+        
+        if (!self->_lastFilter_string.length) return;
+        auto highlights = rowModel_filterHighlights(transUnit, nil, nil, self->_lastFilter_string, self->_lastFilter_options, self->_filterRegex); /// The filter that's shown – `_filterString` may be ahead while a pass runs in the background
+        if (highlights) [self->_filterMatchRanges setObject: highlights forKey: transUnit];
+        else            [self->_filterMatchRanges removeObjectForKey: transUnit];
+    }
 
     #pragma mark - Data
     
@@ -687,36 +889,55 @@ auto reusableViewIDs = @[ /// Include any IDs that we call `makeViewWithIdentifi
     - (NSXMLElement *) selectedItem {
         return [self itemAtRow: self.selectedRow];
     }
+    
+    - (NSArray<NSXMLElement *> *) selectedItems { /// Top to bottom [Oct 2026]
+        auto result = [NSMutableArray<NSXMLElement *> new];
+        [self.selectedRowIndexes enumerateIndexesUsingBlock: ^(NSUInteger row, BOOL *stop) {
+            [result addObject: [self itemAtRow: row]];
+        }];
+        return result;
+    }
+    
+    - (NSArray<NSXMLElement *> *) displayedItems { /// All rows that the filter lets through – including the ones scrolled out of view [Oct 2026]
+        return self->_displayedTopLevelTransUnits ?: @[];
+    }
 
     - (NSXMLElement *) topLevelItemContainingItem: (NSXMLElement *)searchedItem {
         if ((0))
             return [self parentForItem: searchedItem] ?: searchedItem; /// This would probably also work. But maybe `self->_displayedTopLevelTransUnits` works better in some edge-cases where the table hasn't loaded the items, yet? Not sure that's relevant. [Oct 2025]
         
-        for (NSXMLElement *u in self->_displayedTopLevelTransUnits) { /// Returns the searchedItem if it is topLevel itself
-            if ([u isEqual: searchedItem])
-                return u;
-            if ([self->_childrenMap[u] containsObject: searchedItem])
-                return u;
-        }
+        NSXMLElement *topLevel = rowModel_getParent(searchedItem) ?: searchedItem; /// Returns the searchedItem if it is topLevel itself
+        if ([self->_displayedTopLevelTransUnits indexOfObjectIdenticalTo: topLevel] != NSNotFound)
+            return topLevel;
         return nil;
     };
     
     - (void) bigUpdateAndStuff_OnlyUpdateSorting: (BOOL)onlyUpdateSorting {
+        [self _bigUpdateAndStuff_OnlyUpdateSorting: onlyUpdateSorting keepViewport: NO filterQuery: nil];
+    }
+    
+    - (void) _bigUpdateAndStuff_OnlyUpdateSorting: (BOOL)onlyUpdateSorting keepViewport: (BOOL)keepViewport filterQuery: (FilterQuery *_Nullable)finishedQuery {
         
         /// Fully update the table in a way that requires calling `reloadData`, but try to preserve the selection.
+        ///     keepViewport: For updates the user didn't ask for (See `reloadWithChangedData:changedItems:`) – keeps an edit in progress, all selected rows, and the scroll position even if the selection is off-screen. [Oct 2026]
+        ///     finishedQuery: The results of a filter pass that ran in the background (See `_startFilterQuery`). If nil, the filter pass runs right here. [Oct 2026]
         
+        mftrace_scope("bigUpdate");
         mflog(@"onlySorting %d", onlyUpdateSorting);
         
         /// Stop editing before the reload
         ///     We do this so that `MFTextField_ResignFirstResponder` is called which saves the edits that the user made, otherwise they are lost. [Nov 2025]
         ///     This happens when you edit a row and then hit Command-J (`Show in 'All Project Files'`) or click a column header to change the sorting [Nov 2025]
-        if (isclass([[self window] firstResponder], MFInvisiblesTextView)) { /// Use `MFInvisiblesTextView` instead of `NSTextView` cause the filter field also uses an NSTextView under macOS Sequoia.
+        if (isclass([[self window] firstResponder], MFInvisiblesTextView) && !keepViewport) { /// Use `MFInvisiblesTextView` instead of `NSTextView` cause the filter field also uses an NSTextView under macOS Sequoia.
             [[self window] makeFirstResponder: self];
         
         }
         
         /// Save the currently selected item and its position on-screen.
+        ///     With `keepViewport`, fall back to the topmost row on screen, so the rows the user is looking at don't move.
         auto previouslySelectedItem = [self selectedItem];
+        auto previouslySelectedItems = keepViewport ? [self selectedItems] : nil;
+        NSXMLElement *anchorItem = previouslySelectedItem;
         CGFloat previousMidYViewportOffset = 0.0;
         BOOL shouldRestore = NO;
         {
@@ -738,128 +959,91 @@ auto reusableViewIDs = @[ /// Include any IDs that we call `makeViewWithIdentifi
             };
         
             NSRect r = rectOfRowInViewport(self, [self selectedRow]);
+            if (NSEqualRects(r, NSZeroRect) && keepViewport && self.numberOfRows) {
+                NSInteger topRow = [self rowsInRect: self.visibleRect].location;
+                anchorItem = [self itemAtRow: topRow];
+                r = rectOfRowInViewport(self, topRow);
+            }
             if (!NSEqualRects(r, NSZeroRect)) {
                 shouldRestore = YES;
                 previousMidYViewportOffset = NSMidY(r);
             }
         }
         /// Do the actual updates
+        NSArray<NSXMLElement *> *previouslyDisplayed = [self->_displayedTopLevelTransUnits copy]; /// What the outlineView currently shows – see `_updateTableFromPreviouslyDisplayed:` [Oct 2026]
         {
             /// `update_rowModels`
+            FilterQuery *q = finishedQuery;
             if (!onlyUpdateSorting)
             {
-                /// Build parent-child map for pluralizable strings
-                _childrenMap = [NSMutableDictionary new];
-                NSMutableSet<NSXMLElement *> *allChildTransUnits = [NSMutableSet new];
-
-                for (NSXMLElement *transUnit in self->transUnits) {
-                    NSString *idStr = xml_attr(transUnit, @"id").objectValue;
-                    if ([idStr containsString: @"|==|"]) {
-                        /// This is a child variant
-                        NSArray *parts = [idStr componentsSeparatedByString: @"|==|"];
-                        NSString *baseKey = parts[0];
-
-                        /// Find parent with matching baseKey
-                        for (NSXMLElement *potentialParent in self->transUnits) {
-                            NSString *parentId = xml_attr(potentialParent, @"id").objectValue;
-                            if ([parentId isEqual: baseKey]) { /// Found parent
-                            
-                                assert(rowModel_isPluralParent(potentialParent)); /// Make sure our utility function works.
-                                
-                                NSMutableArray *children = (NSMutableArray *)_childrenMap[potentialParent];
-                                if (!children) {
-                                     children = [NSMutableArray new];
-                                     _childrenMap[potentialParent] = children;
-                                }
-                                [children addObject: transUnit];
-                                [allChildTransUnits addObject: transUnit];
-                                break;
-                            }
-                        }
-                    }
-                }
-
-                /// Filter
-                _displayedTopLevelTransUnits = [NSMutableArray new];
-                for (NSXMLElement *transUnit in self->transUnits) {
-
-                    { /// Validate
-                        assert(isclass(transUnit, NSXMLElement));
-                        assert([transUnit.name isEqual: @"trans-unit"]);
-                    }
-
-                    if ([allChildTransUnits containsObject: transUnit])
-                        continue; /// Skip child variants - they'll be shown as children of their parent
-
-                    if (![_filterString length])
-                        [_displayedTopLevelTransUnits addObject: transUnit];
-                    else {
-                    
-                        #define combinedRowString(transUnit) stringf(@"%@\n%@\n%@\n%@", /** Using `rowModel_getUIString` instead of `rowModel_getCellModel` cause of the filtering we do on the IB-generated @"note"-column strings [Nov 2025] */\
-                            rowModel_getUIString(self, transUnit, @"id"), \
-                            rowModel_getUIString(self, transUnit, @"source"), \
-                            rowModel_getUIString(self, transUnit, @"target"), \
-                            rowModel_getUIString(self, transUnit, @"note") /** Note how we're omitting @"state" */\
-                        )
-                        
-                        auto combinedTransUnitString = [NSMutableString new];
-                        [combinedTransUnitString appendString: combinedRowString(transUnit)];
-                        for (NSXMLElement *childTransUnit in _childrenMap[transUnit]) {
-                            [combinedTransUnitString appendString: @"\n"];
-                            [combinedTransUnitString appendString: combinedRowString(childTransUnit)];
-                        }
-                        
-                        if (
-                            [combinedTransUnitString
-                                rangeOfString: self->_filterString
-                                options: self->_filterOptions
-                            ]
-                            .location != NSNotFound
-                        ) {
-                            [(NSMutableArray *)_displayedTopLevelTransUnits addObject: transUnit];
-                        }
-                    }
+                mftrace_scope("bigUpdate.filter");
+                
+                /// Note: The parent-child map for pluralizable strings used to be built here, but it's now built once when the document is loaded. (See `RowStore.m`) [Oct 2026]
+                
+                if (!q) { /// Filter synchronously – still on all cores, but the main thread waits. (Only the filterField filters in the background, the other callers expect the table to be up to date afterwards.) [Oct 2026]
+                    mftrace_scope("filter.query");
+                    q = [self _makeFilterQuery];
+                    filterQuery_run(q, NULL);
                 }
+                [self _applyFilterQuery: q];
             }
             
             /// `update_rowModelSorting`
             {
-                mflog(@"Updating _rowToSortedRow with sortDescriptors: (only using the first one): %@", self.sortDescriptors);
+                mftrace_scope("bigUpdate.sort");
+                mflog(@"Updating _rowToSortedRow with sortDescriptors: %@", self.sortDescriptors);
             
-                NSSortDescriptor *desc = self.sortDescriptors.firstObject;
-                if (!desc) { goto endof_sorting; }
+                NSArray<NSSortDescriptor *> *descs = self.sortDescriptors;
+                if (!descs.count) { goto endof_sorting; }
                 
                 #if 0
                     NSInteger rowCount = [self numberOfRowsInTableView: self]; /// -[numberOfRows] gives wrong results while swtiching files not sure what's going on [Oct 2025]
                 #endif
                 
-                [_displayedTopLevelTransUnits sortUsingComparator: ^NSComparisonResult(NSXMLElement *i, NSXMLElement *j) {
-                    NSComparisonResult comp;
-                    if ([desc.key isEqual: @"state"])
-                        comp = (
-                            [_stateOrder indexOfObject: [self stateOfRowModel: i]] -
-                            [_stateOrder indexOfObject: [self stateOfRowModel: j]]
-                        );
-                    else
-                        comp = [
-                            rowModel_getUIString(self, i, desc.key) localizedStandardCompare:
-                            rowModel_getUIString(self, j, desc.key)
-                        ];
-                    return desc.ascending ? comp : -comp;
-                }];
+                /// Sort on the precomputed keys of the `RowStore` [Oct 2026]
+                ///     Used to only honor the first descriptor and to call `rowModel_getUIString()` + `localizedStandardCompare:` on every comparison. Now all descriptors are used (stable – ties keep their previous order), and comparisons are just numbers. (See `SortKeys.m`)
+                ///     If a column hasn't been collated yet: Do it right here for small documents. For large ones, collate in the background, leave the order as-is for now, and sort again when it's done.
+                RowStore *store = rowStore_lookup(self->transUnits.firstObject, NULL);
+                if (!store) { goto endof_sorting; }
+                
+                #define kMFSortKeysSyncMaxRows 5000 /// Collating this many rows takes a few ms
+                
+                NSArray<NSString *> *columnIDs = [descs valueForKey: @"key"];
+                if (store->count <= kMFSortKeysSyncMaxRows) rowStore_buildSortKeys(store, columnIDs, YES, nil);
+                
+                NSArray<NSXMLElement *> *sorted = (q && q->sorted && [q->sortDescriptors isEqual: descs]) ? q->sorted : rowStore_sortRows(store, _displayedTopLevelTransUnits, descs); /// Background passes have sorted already [Oct 2026]
+                if (sorted) {
+                    _displayedTopLevelTransUnits = [sorted mutableCopy];
+                }
+                else {
+                    mflog(@"Sort keys for %@ aren't ready – sorting once they're built", columnIDs);
+                    rowStore_buildSortKeys(store, columnIDs, NO, ^{
+                        if (rowStore_lookup(self->transUnits.firstObject, NULL) != store) return; /// Switched documents/reverted in the meantime
+                        if (![self.sortDescriptors isEqual: descs]) return;                      /// A newer sort is already waiting
+                        [self bigUpdateAndStuff_OnlyUpdateSorting: YES];
+                    });
+                }
             }
             endof_sorting: {}
             
             /// Do the reaload!!
-            [self reloadData];
+            ///     Only inserts and removes the rows that changed, if that's cheaper [Oct 2026]
+            {
+                mftrace_scope("bigUpdate.updateTable");
+                [self _updateTableFromPreviouslyDisplayed: previouslyDisplayed];
+            }
         }
         
-        /// Helper block
-        auto restoreAlpha = ^{
-            mfanimate(mfanimate_args(.duration = 0.25), ^{
-                self.animator.alphaValue = 1.0;
-            }, nil);
-        };
+        /// Restore all selected rows
+        ///     `_updateTableFromPreviouslyDisplayed:` keeps them – unless it had to `reloadData`.
+        if (keepViewport) {
+            auto rows = [NSMutableIndexSet new];
+            for (NSXMLElement *item in previouslySelectedItems) {
+                NSInteger row = [self rowForItem: item];
+                if (row != -1) [rows addIndex: row];
+            }
+            if (![rows isEqual: self.selectedRowIndexes]) [self selectRowIndexes: rows byExtendingSelection: NO];
+        }
         
         /// Restore the previous selection
         if (shouldRestore) {
@@ -867,35 +1051,29 @@ auto reusableViewIDs = @[ /// Include any IDs that we call `makeViewWithIdentifi
             if ((0))
                 [self expandItem: [self parentForItem: previouslySelectedItem]]; /// Not sure if necessary [Oct 2025]
             
-            NSInteger newIndex = [self rowForItem: previouslySelectedItem];
+            NSInteger newIndex = [self rowForItem: anchorItem];
             
-            mflog(@"restoring selection of item: %@ | newIndex: %ld ...", previouslySelectedItem, newIndex);
+            mflog(@"restoring selection of item: %@ | newIndex: %ld ...", anchorItem, newIndex);
             
             if (newIndex != -1) {
                 
                 /// Select
-                [self selectRowIndexes: indexset(newIndex) byExtendingSelection: NO];
-                
-                /// Fade out to hide jank
-                self.alphaValue = 0.0;
+                if (!keepViewport) [self selectRowIndexes: indexset(newIndex) byExtendingSelection: NO];
                 
                 /// Restore position
-                ///     This is unreliable due to row-height being lazily computed and the table height changing as new rows get on-screen. As workaround, we use recursive `__restorePosition` function that tries a few times.
-                ///         Currently not overriding `noteHeightOfRowsWithIndexesChanged:` and using `self.usesAutomaticRowHeights = YES` [Nov 2025]
-                ///     Very old notes: Update: After switching from NSTableView to NSOutlineView, it seems to fail almost always [Oct 2025]
-                __restorePosition(0, self, previousMidYViewportOffset, newIndex, ^{
-                    mflog(@"restored selection of item: %@ | newIndex: %ld", previouslySelectedItem, newIndex);
-                    restoreAlpha();
-                });
+                ///     One scroll is enough now: The rows are measured in advance, and when their heights come in, the selected row is kept in place (See `_noteHeightOfRowsWithIndexesChanged_KeepingPosition:`) [Oct 2026]
+                ///     Used to be unreliable due to row-height being lazily computed by `usesAutomaticRowHeights` – we retried a few times (`__restorePosition()`) and faded the table out to hide the jank. [Nov 2025]
+                [self scrollPoint: (CGPoint) { .y = NSMidY([self rectOfRow: newIndex]) - previousMidYViewportOffset }]; /// `scrollPoint:` moves bounds of the enclosing clipView
+                [self _measureRowHeightsOnScreen];
             }
             else {
-                [self scrollToBeginningOfDocument: nil]; /// Is this really good? Not native macOS behavior
-                restoreAlpha(); /// This this is necessary here I think, not sure why [Nov 2025]
+                if (!keepViewport) [self scrollToBeginningOfDocument: nil]; /// Is this really good? Not native macOS behavior
+                [self _measureRowHeightsOnScreen];
             }
         }
         else {
-            [self scrollToBeginningOfDocument: nil]; /// Is this really good? Not native macOS behavior
-            restoreAlpha(); /// This this is necessary here I think, not sure why [Nov 2025]
+            if (!keepViewport) [self scrollToBeginningOfDocument: nil]; /// Is this really good? Not native macOS behavior
+            [self _measureRowHeightsOnScreen];
         }
         
         /// DEBUG
@@ -940,35 +1118,101 @@ auto reusableViewIDs = @[ /// Include any IDs that we call `makeViewWithIdentifi
         }   
     }
     
-    void __restorePosition (int iteration, TableView *self, CGFloat previousMidYViewportOffset, NSInteger newIndex, void (^completionCallback)(void)) {
+    - (void) _updateTableFromPreviouslyDisplayed: (NSArray<NSXMLElement *> *)old {
         
-        /// Helper for `bigUpdateAndStuff_OnlyUpdateSorting`.
-        ///     Define here since recursive blocks are annoying and clang doesn't support local functions. [Nov 2025]
-        ///         Also see how to do recursive blocks: http://blog.hyperjeff.net/code?id=335
-    
-        if (iteration > 5) {
-            completionCallback();
+        /// Brings the outlineView from showing `old` to showing `_displayedTopLevelTransUnits` – with a batch of removals and insertions instead of `reloadData`, so the rows that stay keep their views and heights. [Oct 2026]
+        ///     Typing in the filter field only ever removes rows (or adds them back when deleting characters), and the sort is stable – so the rows that stay are usually still in order.
+        ///     Rows that stay but changed their order (sorting) are removed and re-inserted. When that's most of the rows, `reloadData` is cheaper.
+        
+        NSArray<NSXMLElement *> *new = self->_displayedTopLevelTransUnits;
+        
+        #define kMFTableDiffMinUnchangedFraction 0.5 /// Below this, just reload
+        
+        if (!old || [self numberOfChildrenOfItem: nil] != (NSInteger)old.count) { /// Not in sync – shouldn't happen
+            [self reloadData];
             return;
         }
-        [self scrollPoint: (CGPoint) { .y = NSMidY([self rectOfRow: newIndex]) - previousMidYViewportOffset }]; /// `scrollPoint:` moves bounds of the enclosing clipView
-        runOnMain(0.0, ^{
-            if (5 > fabs(
-                [self visibleRect].origin.y -
-                (NSMidY([self rectOfRow: newIndex]) - previousMidYViewportOffset)
-            )) {
-                completionCallback();
-                return;
+        
+        /// Find the rows that stay
+        ///     The longest run of `old` that's also in `new`, in the same order (Longest increasing subsequence of the new positions, O(n log n)). Everything else is removed or inserted.
+        NSMapTable<NSXMLElement *, NSNumber *> *newIndexOf = [NSMapTable mapTableWithKeyOptions: NSPointerFunctionsOpaqueMemory | NSPointerFunctionsObjectPointerPersonality valueOptions: NSPointerFunctionsStrongMemory];
+        for (NSInteger i = 0; i < new.count; i++) [newIndexOf setObject: @(i) forKey: new[i]];
+        
+        NSInteger n = old.count;
+        NSInteger *newPos   = malloc(MAX(1, n) * sizeof(NSInteger)); /// -1 if removed
+        NSInteger *tailOld  = malloc(MAX(1, n) * sizeof(NSInteger)); /// tailOld[k]: old index of the smallest tail of an increasing run of length k+1
+        NSInteger *prevOld  = malloc(MAX(1, n) * sizeof(NSInteger));
+        NSInteger runLength = 0;
+        for (NSInteger i = 0; i < n; i++) {
+            NSNumber *p = [newIndexOf objectForKey: old[i]];
+            newPos[i] = p ? p.integerValue : -1;
+            if (newPos[i] == -1) continue;
+            NSInteger lo = 0, hi = runLength;
+            while (lo < hi) {
+                NSInteger mid = (lo + hi) / 2;
+                if (newPos[tailOld[mid]] < newPos[i]) lo = mid + 1;
+                else                                  hi = mid;
             }
-           __restorePosition(iteration+1, self, previousMidYViewportOffset, newIndex, completionCallback);
-        });
-    };
-
+            prevOld[i] = lo > 0 ? tailOld[lo - 1] : -1;
+            tailOld[lo] = i;
+            if (lo == runLength) runLength++;
+        }
+        auto staysOld = [NSMutableIndexSet new];
+        auto staysNew = [NSMutableIndexSet new];
+        for (NSInteger i = runLength ? tailOld[runLength - 1] : -1; i != -1; i = prevOld[i]) {
+            [staysOld addIndex: i];
+            [staysNew addIndex: newPos[i]];
+        }
+        free(newPos); free(tailOld); free(prevOld);
+        
+        if (runLength < kMFTableDiffMinUnchangedFraction * MAX(old.count, new.count)) {
+            mflog(@"Reloading table (%ld of %ld rows stay)", runLength, new.count);
+            [self reloadData];
+            return;
+        }
+        
+        auto removals = [NSMutableIndexSet indexSetWithIndexesInRange: NSMakeRange(0, old.count)];
+        [removals removeIndexes: staysOld];
+        auto insertions = [NSMutableIndexSet indexSetWithIndexesInRange: NSMakeRange(0, new.count)];
+        [insertions removeIndexes: staysNew];
+        
+        mflog(@"Updating table: %ld removed, %ld inserted, %ld stay", removals.count, insertions.count, runLength);
+        
+        /// Apply
+        ///     Removal indexes are positions in `old`. After removing, the table shows exactly the rows that stay, so the insertion indexes (positions in `new`) line up.
+        [self beginUpdates];
+        [self removeItemsAtIndexes: removals inParent: nil withAnimation: NSTableViewAnimationEffectNone];
+        [self insertItemsAtIndexes: insertions inParent: nil withAnimation: NSTableViewAnimationEffectNone];
+        [self endUpdates];
+        
+        [insertions enumerateIndexesUsingBlock: ^(NSUInteger i, BOOL *stop) { /// Same as `reloadData` – everything is expanded
+            if ([rowModel_getChildren(new[i]) count]) [self expandItem: new[i]];
+        }];
+        
+        /// Refresh the cells that stayed on screen
+        ///     Their `filter-highlights` and `filename-field` depend on the filter string and the selected file. (Only the visible ones have views, so this is cheap.)
+        ///     Not the row that's being edited – that would end the edit. (Only happens for `reloadWithChangedData:changedItems:`, everything else ends editing first) [Oct 2026]
+        auto visibleRows = [NSMutableIndexSet indexSetWithIndexesInRange: [self rowsInRect: self.visibleRect]];
+        if (isclass(self.window.firstResponder, MFInvisiblesTextView)) [visibleRows removeIndex: self.selectedRow];
+        [self reloadDataForRowIndexes: visibleRows columnIndexes: [NSIndexSet indexSetWithIndexesInRange: NSMakeRange(0, self.numberOfColumns)]];
+        
+        /// Measure the rows that are new
+        ///     The ones that stay keep their heights – unless their flags changed, then this measures everything. (See `_measureRowHeightsInBackground:`)
+        [self _measureRowHeightsOnScreen];
+        [self _measureRowHeightsInBackground: [new objectsAtIndexes: insertions]];
+        
+        #undef kMFTableDiffMinUnchangedFraction
+    }
+    
     - (void) reloadWithNewData: (NSArray <NSXMLElement *> *)transUnits {
         
         /// Called by SourceList, when switching files
         
         self->transUnits = transUnits;
         [self bigUpdateAndStuff_OnlyUpdateSorting: NO];
+        
+        _buildRowStoreCachesInBackground(rowStore_lookup(transUnits.firstObject, NULL)); /// No-op if it's already built [Oct 2026]
+        _buildTranslationMemoryInBackground(self, rowStore_lookup(transUnits.firstObject, NULL));
             
         /// Update column names (weird place to do this) [Oct 2025]
         {
@@ -984,13 +1228,53 @@ auto reusableViewIDs = @[ /// Include any IDs that we call `makeViewWithIdentifi
 
     }
     
+    - (void) reloadWithChangedData: (NSArray <NSXMLElement *> *)transUnits changedItems: (NSArray<NSXMLElement *> *)changedItems {
+        
+        /// Called by SourceList, when the xliff was changed on disk and merged into the open one (See `XliffMerge.m`) [Oct 2026]
+        ///     Unlike `reloadWithNewData:`, this keeps the selection, the scroll position and an edit that's in progress:
+        ///     The rows that are still there are the same objects as before, so only the added and removed rows are inserted / removed, and only the changed rows are reloaded.
+        
+        mftrace_scope("reload.changedData");
+        
+        RowStore *store = rowStore_lookup(transUnits.firstObject, NULL);
+        NSInteger editedRow = isclass(self.window.firstResponder, MFInvisiblesTextView) ? self.selectedRow : -1;
+        
+        /// Forget what we derived from the old cells
+        for (NSXMLElement *item in changedItems) {
+            [self _updateFilterHighlightsOfItem: item];
+            rowHeights_forget(self->_rowHeights, item);
+        }
+        
+        /// Insert / remove rows
+        self->transUnits = transUnits;
+        [self _bigUpdateAndStuff_OnlyUpdateSorting: NO keepViewport: YES filterQuery: nil];
+        
+        /// Reload the changed rows
+        ///     With their variants, which may have been added or removed. Not the row that's being edited – the user's edit wins once they commit it.
+        for (NSXMLElement *item in changedItems) {
+            NSInteger row = [self rowForItem: item];
+            if (row == -1 || row == editedRow) continue;
+            if (editedRow != -1 && [self parentForItem: [self itemAtRow: editedRow]] == item) [self reloadItem: item reloadChildren: NO];
+            else                                                                                 [self reloadItem: item reloadChildren: YES];
+            if ([rowModel_getChildren(item) count]) [self expandItem: item];
+        }
+        [self _measureRowHeightsOnScreen];
+        [self _measureRowHeightsInBackground: changedItems]; /// Added rows were measured by `_updateTableFromPreviouslyDisplayed:`
+        
+        /// The new store needs its own caches
+        _buildRowStoreCachesInBackground(store);
+        _buildTranslationMemoryInBackground(self, store);
+        [self _updateTranslationMemorySuggestions];
+    }
+    
     - (NSString *) stateOfRowModel: (NSXMLElement *)transUnit {
         
         /// Define parent node state in terms of their children
         ///     don't call `rowModel_getCellModel(..., @"state")`, directly
         
-        if (_childrenMap[transUnit].count) {
-            for (NSXMLElement *ch in _childrenMap[transUnit]) {
+        auto children = rowModel_getChildren(transUnit);
+        if (children.count) {
+            for (NSXMLElement *ch in children) {
                 if (![rowModel_getCellModel(ch, @"state") isEqual: kMFTransUnitState_Translated])
                     return kMFTransUnitState_NeedsReview;
             }
@@ -1059,6 +1343,246 @@ auto reusableViewIDs = @[ /// Include any IDs that we call `makeViewWithIdentifi
         }
         
     }
+    #pragma mark - Editing (Bulk)
+    
+    - (NSArray<NSXMLElement *> *) bulkEditableRowModels: (NSArray<NSXMLElement *> *)transUnits {
+        
+        /// The rows whose state a bulk edit would change, for a selection or `displayedItems` [Oct 2026]
+        ///     Plural parents stand for their variants (Their state is derived from them – see `stateOfRowModel:`). Rows that are `mf_dont_translate` are left out.
+        
+        auto result = [NSMutableArray<NSXMLElement *> new];
+        auto seen = [NSHashTable hashTableWithOptions: NSPointerFunctionsOpaqueMemory | NSPointerFunctionsObjectPointerPersonality]; /// A selected variant may also be covered by its selected parent
+        
+        auto add = ^(NSXMLElement *transUnit) {
+            if ([seen containsObject: transUnit]) return;
+            [seen addObject: transUnit];
+            if ([rowModel_getCellModel(transUnit, @"state") isEqual: kMFTransUnitState_DontTranslate]) return;
+            [result addObject: transUnit];
+        };
+        for (NSXMLElement *transUnit in transUnits) {
+            auto children = rowModel_getChildren(transUnit);
+            if (children.count) for (NSXMLElement *ch in children) add(ch);
+            else                                                  add(transUnit);
+        }
+        return result;
+    }
+    
+    - (BOOL) allRowsAreTranslated: (NSArray<NSXMLElement *> *)transUnits {
+        for (NSXMLElement *transUnit in transUnits)
+            if (![self rowIsTranslated: transUnit]) return NO;
+        return YES;
+    }
+    
+    - (NSArray<NSXMLElement *> *) bulkEditableSelection: (BOOL *_Nullable)outAllTranslated {
+        
+        /// `bulkEditableRowModels:` of the selection, and whether `allRowsAreTranslated:` – cached until the selection changes or the rows are edited. [Oct 2026]
+        ///     Menu validation asks for this on every key equivalent and every time a menu opens. With a big selection (Command-A), going over it each time added up.
+        
+        RowStore *store = rowStore_lookup([self selectedItem], NULL);
+        if (
+            !self->_bulkSelection ||
+            self->_bulkSelection_store != store ||
+            self->_bulkSelection_editCount != (store ? store->editCount : 0) ||
+            ![self->_bulkSelection_rows isEqual: self.selectedRowIndexes]
+        ) {
+            self->_bulkSelection                = [self bulkEditableRowModels: [self selectedItems]];
+            self->_bulkSelection_allTranslated  = [self allRowsAreTranslated: self->_bulkSelection];
+            self->_bulkSelection_rows           = [self.selectedRowIndexes copy];
+            self->_bulkSelection_store          = store;
+            self->_bulkSelection_editCount      = store ? store->editCount : 0;
+        }
+        if (outAllTranslated) *outAllTranslated = self->_bulkSelection_allTranslated;
+        return self->_bulkSelection;
+    }
+    
+    - (void) setIsTranslatedState: (BOOL)newIsTranslatedState onRowModels: (NSArray<NSXMLElement *> *)transUnits {
+        
+        /// Bulk version of `setIsTranslatedState:onRowModel:` – e.g. for marking every row that matches the filter as translated. [Oct 2026]
+        
+        auto newState = newIsTranslatedState ? kMFTransUnitState_Translated : kMFTransUnitState_NeedsReview;
+        
+        auto rows = [NSMutableArray<NSXMLElement *> new];
+        for (NSXMLElement *transUnit in [self bulkEditableRowModels: transUnits])
+            if ([self rowIsTranslated: transUnit] != newIsTranslatedState) [rows addObject: transUnit]; /// Leave the other rows alone – so undo doesn't touch them either
+        if (!rows.count) return;
+        
+        auto states = [NSMutableArray<NSString *> arrayWithCapacity: rows.count];
+        for (NSInteger i = 0; i < (NSInteger)rows.count; i++) [states addObject: newState];
+        
+        [self setStates: states targets: nil onRowModels: rows actionName: stringf(@"%@ (%ld Rows)", newIsTranslatedState ? kMFStr_MarkAsTranslated : kMFStr_MarkForReview, rows.count)];
+    }
+    
+    - (void) setStates: (NSArray<NSString *> *)states targets: (NSArray<NSString *> *_Nullable)targets onRowModels: (NSArray<NSXMLElement *> *)transUnits actionName: (NSString *)actionName {
+        
+        /// Applies the states (and, if given, the targets) of many rows in one go. [Oct 2026]
+        ///     Going through `setIsTranslatedState:onRowModel:` / `setTranslation:` row by row registered one undo invocation, reloaded the row, recounted the progress of every file and scheduled a save – per row.
+        ///     Here it's one undo invocation (holding the old values of all the rows), one reload of the affected rows that are on screen, one `progressHasChanged` and one save.
+        ///     Also what undo and redo call – so they're batched, too.
+        ///     An `NSNull` in `states` removes the row's `state` attribute – that's how undo restores rows that never had one (See `_rowModel_getStateForUndo()`)
+        
+        mftrace_scope("edit.bulk");
+        mftrace_count("edit.bulk.rows", transUnits.count);
+        
+        assert(states.count == transUnits.count);
+        assert(!targets || targets.count == transUnits.count);
+        if (!transUnits.count) return;
+        
+        /// Register undo / redo
+        {
+            auto oldStates  = [NSMutableArray<NSString *> arrayWithCapacity: transUnits.count];
+            auto oldTargets = !targets ? nil : [NSMutableArray<NSString *> arrayWithCapacity: transUnits.count];
+            for (NSXMLElement *transUnit in transUnits) {
+                [oldStates addObject: _rowModel_getStateForUndo(transUnit) ?: (id)[NSNull null]];
+                [oldTargets addObject: rowModel_getCellModel(transUnit, @"target") ?: @""];
+            }
+            auto undoManager = [getdoc(self) undoManager];
+            [[undoManager prepareWithInvocationTarget: self] setStates: oldStates targets: oldTargets onRowModels: transUnits actionName: actionName];
+            [undoManager setActionName: actionName];
+        }
+        
+        /// Update datamodel
+        for (NSInteger i = 0; i < (NSInteger)transUnits.count; i++) {
+            if (targets) {
+                _rowModel_setCellModel(transUnits[i], @"target", targets[i]);
+                [self _updateFilterHighlightsOfItem: transUnits[i]]; /// See `setTranslation:`
+                rowHeights_forget(self->_rowHeights, transUnits[i]);
+            }
+            _rowModel_setCellModel(transUnits[i], @"state", states[i] != (id)[NSNull null] ? states[i] : nil);
+        }
+        
+        /// Save to disk
+        [getdoc(self) writeTranslationDataToFile];
+        
+        /// Update progress UI
+        [getdoc(self)->ctrl->out_sourceList progressHasChanged];
+        
+        /// Reload cells
+        ///     Only the rows on screen have views. The others are made fresh when they're scrolled into view.
+        ///     Includes the parents – the state they display depends on their variants (See `setIsTranslatedState:onRowModel:`)
+        ///     When targets change, also the sibling variants – their issues depend on each other's targets (See `Validator.m`) [Oct 2026]
+        {
+            NSRange visible = [self rowsInRect: self.visibleRect];
+            auto rows = [NSMutableIndexSet new];
+            for (NSXMLElement *transUnit in transUnits) {
+                NSXMLElement *parent = rowModel_getParent(transUnit);
+                NSArray<NSXMLElement *> *items = @[transUnit, parent ?: transUnit];
+                if (targets && parent) items = [items arrayByAddingObjectsFromArray: rowModel_getChildren(parent)];
+                for (NSXMLElement *item in items) {
+                    NSInteger row = [self rowForItem: item];
+                    if (row != -1 && NSLocationInRange(row, visible)) [rows addIndex: row];
+                }
+            }
+            auto cols = [NSMutableIndexSet indexSetWithIndex: [self columnWithIdentifier: @"state"]];
+            if (targets) [cols addIndex: [self columnWithIdentifier: @"target"]];
+            [self reloadDataForRowIndexes: rows columnIndexes: cols];
+        }
+        
+        /// Update row heights
+        if (targets) {
+            [self _measureRowHeightsOnScreen];
+            [self _measureRowHeightsInBackground: transUnits]; /// Only the ones we forgot above
+        }
+        
+        /// Show the rows to the user when undoing / redoing
+        ///     Unlike `_revealTransUnit:`, this doesn't clear the filter or switch files – the rows that aren't displayed just stay out of view.
+        auto undoManager = [getdoc(self) undoManager];
+        if (undoManager.isUndoing || undoManager.isRedoing) {
+            auto rows = [NSMutableIndexSet new];
+            for (NSXMLElement *transUnit in transUnits) {
+                NSInteger row = [self rowForItem: transUnit];
+                if (row != -1) [rows addIndex: row];
+            }
+            if (rows.count) {
+                [self selectRowIndexes: rows byExtendingSelection: NO];
+                [self scrollRowToVisible: rows.firstIndex];
+            }
+        }
+    }
+    
+    #pragma mark - Translation Memory
+    
+    - (void) _updateTranslationMemorySuggestions {
+        
+        /// Looks up suggestions for the selected row, off the main thread – so arrowing through the rows or typing never waits for it. [Oct 2026]
+        ///     Shown in the row's target cell once they're back (See `_getCellView()`), and in the right-click menu.
+        
+        NSXMLElement *oldItem = self->_tmSuggestionsItem;
+        self->_tmSuggestions = nil;
+        self->_tmSuggestionsItem = nil;
+        [self _reloadTargetCellOfItem: oldItem];
+        
+        NSXMLElement *transUnit = [self selectedItem];
+        [self _lookUpTranslationMemorySuggestionsForItem: transUnit completion: ^(NSArray<TMSuggestion *> *suggestions) {
+            if ([self selectedItem] != transUnit) return;
+            self->_tmSuggestions = suggestions;
+            self->_tmSuggestionsItem = transUnit;
+            [self _reloadTargetCellOfItem: transUnit];
+        }];
+    }
+    
+    - (BOOL) _lookUpTranslationMemorySuggestionsForItem: (NSXMLElement *_Nullable)transUnit completion: (void (^)(NSArray<TMSuggestion *> *suggestions))completion {
+        
+        /// Looks up the suggestions for `transUnit` on a serial background queue and calls `completion` with them on the main thread. [Oct 2026]
+        ///     Returns NO – and never calls `completion` – for rows that don't get suggestions.
+        
+        static dispatch_queue_t queue;
+        static dispatch_once_t onceToken;
+        dispatch_once(&onceToken, ^{
+            queue = dispatch_queue_create("com.mf.xcloc-editor.translation-memory", dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_USER_INITIATED, 0));
+        });
+        
+        RowStore *store = rowStore_lookup(transUnit, NULL);
+        if (!transUnit || !store || !store->translationMemory || rowModel_isPluralParent(transUnit)) return NO;
+        if ([rowModel_getCellModel(transUnit, @"state") isEqual: kMFTransUnitState_DontTranslate]) return NO;
+        
+        TranslationMemory *tm = store->translationMemory;
+        NSString *source = rowModel_getCellModel(transUnit, @"source");
+        NSString *target = rowModel_getCellModel(transUnit, @"target");
+        
+        dispatch_async(queue, ^{
+            NSArray<TMSuggestion *> *suggestions;
+            {
+                mftrace_scope("tm.suggest");
+                suggestions = translationMemory_suggest(tm, source, target, 5);
+            }
+            dispatch_async(dispatch_get_main_queue(), ^{
+                completion(suggestions);
+            });
+        });
+        return YES;
+    }
+    
+    - (void) _reloadTargetCellOfItem: (NSXMLElement *)transUnit {
+        
+        if (!transUnit) return;
+        NSInteger row = [self rowForItem: transUnit];
+        if (row == -1) return;
+        
+        NSTableCellView *cell = [self viewAtColumn: [self columnWithIdentifier: @"target"] row: row makeIfNecessary: NO];
+        if (!cell) return;
+        if ([cell.textField currentEditor]) { /// Don't reload while it's being edited – that would end editing. Just swap the placeholder.
+            cell.textField.placeholderString = transUnit == self->_tmSuggestionsItem && self->_tmSuggestions.count ? self->_tmSuggestions[0]->target : nil;
+            return;
+        }
+        [self reloadDataForRowIndexes: indexset(row) columnIndexes: indexset([self columnWithIdentifier: @"target"])];
+    }
+    
+    - (NSArray<TMSuggestion *> *_Nullable) translationMemorySuggestionsForItem: (NSXMLElement *)transUnit {
+        
+        /// The suggestions for `transUnit` from the last lookup of the selected row (See `_updateTranslationMemorySuggestions`). nil if there are none for it, yet.
+        ///     Never looks up synchronously – this is called by `validateMenuItem:`, and a lookup in a big memory would block the menu. Other rows are looked up by `menuNeedsUpdate:` while the menu is open.
+        
+        if (transUnit == self->_tmSuggestionsItem) return self->_tmSuggestions ?: @[];
+        if (transUnit == [self selectedItem] && !rowModel_isPluralParent(transUnit)) return @[]; /// Lookup is in flight – the row's own one is coming, no need for another
+        return nil;
+    }
+    
+    - (void) useTranslationMemorySuggestion: (TMSuggestion *)suggestion onRowModel: (NSXMLElement *)transUnit {
+        [self.window makeFirstResponder: self]; /// End editing first – otherwise `controlTextDidEndEditing:` would write the textField's content over the suggestion. (See `_revealTransUnit:`)
+        [self setTranslation: suggestion->target alsoModifyIsTranslated: NO isTranslated: NO onRowModel: transUnit]; /// Leaves the state alone – the translator still has to review it
+        if (transUnit == [self selectedItem]) [self _updateTranslationMemorySuggestions];
+    }
+    
     - (void) setTranslation: (NSString *)newString alsoModifyIsTranslated: (BOOL)modifyIsTranslated isTranslated: (BOOL)isTranslated onRowModel: (NSXMLElement *)transUnit {
         
         /// Log
@@ -1092,6 +1616,9 @@ auto reusableViewIDs = @[ /// Include any IDs that we call `makeViewWithIdentifi
         if (modifyIsTranslated)
             _rowModel_setCellModel(transUnit, @"state", isTranslated ? kMFTransUnitState_Translated : kMFTransUnitState_NeedsReview);
         
+        /// Find the `filter-highlights` of the new translation – the cell shows them when it's reloaded below. [Oct 2026]
+        [self _updateFilterHighlightsOfItem: transUnit];
+        
         /// Save to disk
         [getdoc(self) writeTranslationDataToFile];
         
@@ -1105,6 +1632,16 @@ auto reusableViewIDs = @[ /// Include any IDs that we call `makeViewWithIdentifi
         {
             [self reloadItem: [self selectedItem] reloadChildren: NO];
             [self reloadItem: [self parentForItem: [self selectedItem]] reloadChildren: NO]; /// See `setIsTranslatedState:`
+            for (NSXMLElement *sibling in rowModel_getChildren(rowModel_getParent(transUnit))) /// Whether an empty variant is an issue depends on its siblings (See `Validator.m`) [Oct 2026]
+                if (sibling != transUnit) [self reloadItem: sibling reloadChildren: NO];
+        }
+        
+        /// Update row height
+        ///     Only the edited row can change – the parent of a plural variant always shows `(pluralizable)` [Oct 2026]
+        {
+            rowHeights_forget(self->_rowHeights, transUnit);
+            NSInteger row = [self rowForItem: transUnit];
+            if (row != -1) [self _measureRowHeightsInRows: NSMakeRange(row, 1)];
         }
     }
     
@@ -1121,6 +1658,7 @@ auto reusableViewIDs = @[ /// Include any IDs that we call `makeViewWithIdentifi
             if (!topLevel) {
                 /// Remove selection
                 ///     [Dec 2025] Necessary because `__restorePosition()` (helper of `bigUpdateAndStuff_OnlyUpdateSorting:`) will otherwise asynchronously try to restore the exact position of the selection on the screen, overriding the `scrollRowToVisible:` code below.
+                ///         [Oct 2026] `__restorePosition()` is gone, but restoring would still scroll to the old selection instead of `transUnit`.
                 if (![[self selectedItem] isEqual: transUnit]) [self selectRowIndexes: indexset() byExtendingSelection: NO];
                 /// Remove the filter
                 [getdoc(self)->ctrl->out_filterField setStringValue: @""];
@@ -1178,110 +1716,158 @@ auto reusableViewIDs = @[ /// Include any IDs that we call `makeViewWithIdentifi
 
     - (NSInteger) outlineView: (NSOutlineView *)outlineView numberOfChildrenOfItem: (id)item {
         if (!item) return [_displayedTopLevelTransUnits count]; /// Root level
-        else       return [_childrenMap[item] count];           /// Child level
+        else       return [rowModel_getChildren(item) count];   /// Child level
     }
 
     - (id) outlineView: (NSOutlineView *)outlineView child: (NSInteger)index ofItem: (id)item {
         if (!item)  return _displayedTopLevelTransUnits[index]; /// Root level
-        else        return _childrenMap[item][index];           /// Child level
+        else        return rowModel_getChildren(item)[index];   /// Child level
     }
 
     - (BOOL) outlineView: (NSOutlineView *)outlineView isItemExpandable: (id)item {
-        return [_childrenMap[item] count];
+        return [rowModel_getChildren(item) count];
     }
 
 
     NSString *rowModel_getUIString(TableView *self, NSXMLElement *transUnit, NSString *columnID) {
     
-        #define iscol(colid) [columnID isEqual: (colid)]
-        
         /// Get model value
-        NSString *uiString = rowModel_getCellModel(transUnit, columnID);
+        NSString *cellModel = [columnID isEqual: @"note"] ? rowModel_getDisplayNote(transUnit) : rowModel_getCellModel(transUnit, columnID);
         
         /// Get proper model value for @"state"
         ///     This is a bit hacky
-        if (iscol(@"state"))
-            uiString = [self stateOfRowModel: transUnit]; /// This is the only use of `self` in `rowModel_getUIString` [Nov 2025]
+        if ([columnID isEqual: @"state"])
+            cellModel = [self stateOfRowModel: transUnit]; /// This is the only use of `self` in `rowModel_getUIString` [Nov 2025]
+        
+        return _rowModel_getUIString_FromCellModel(transUnit, columnID, cellModel);
+    }
+    
+
+    void _buildRowStoreCachesInBackground(RowStore *store) {
+        
+        /// Fills the caches of the `RowStore` that are too slow to fill on the main thread – the `displayNotes` and then the `searchIndex`. Called once per `RowStore`, when the first file is displayed. [Oct 2026]
+        ///     Edits that happen while this runs are recorded in `searchIndexDirtyRows`, so the filter still finds them.
+        
+        if (!store || store->searchIndex || store->isBuildingCaches) return;
+        store->isBuildingCaches = YES;
         
-        /// Remove redundant stuff from IB-generated notes
-        if (iscol(@"note")) {
+        NSArray<NSString *> *targets = [store->targets copy]; /// Only the @"target" column can change while we're in the background.
+        [store->searchIndexDirtyRows removeAllIndexes];
+        
+        dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
             
-            NSDictionary *notesDict = [NSPropertyListSerialization /// The Notes generated by IB are old-style plists with the keys directly at the root. Old Xcode .strings files had the same format IIRC. [Oct 2025]
-                propertyListWithData: [uiString dataUsingEncoding: NSUTF8StringEncoding]
-                options: 0
-                format: NULL
-                error: nil
-            ];
-            if (!isclass(notesDict, NSDictionary)) {
-                if (notesDict) mflog(@"Found non-NSDictionary plist notes: %@", notesDict); /// If the comment is a plain string without quotes, that is also a valid plist [Oct 2025]
+            CFAbsoluteTime t0 = CFAbsoluteTimeGetCurrent();
+            
+            /// Display notes
+            auto displayNotes = [NSMutableArray arrayWithCapacity: store->count];
+            for (NSInteger row = 0; row < store->count; row++) {
+                @autoreleasepool {
+                    [displayNotes addObject: stringTable_displayNote(store->strings, rowStore_getCellModel(store, row, @"note"), _rowModel_cleanUpNote) ?: (id)[NSNull null]]; /// Shared across the languages of the project – only the first one to get here does the parsing [Oct 2026]
+                }
             }
-            else {
-                
-                if
-                (
-                    (
-                        notesDict.allKeys.count == 3 && /// Complex validation is just a sanity check [Oct 2025]
-                        (
-                            [toset(notesDict.allKeys) isEqual: toset(@[         @"Class", @"ObjectID", @"title"])] ||
-                            [toset(notesDict.allKeys) isEqual: toset(@[         @"Class", @"ObjectID", @"ibShadowedToolTip"])] ||
-                            [toset(notesDict.allKeys) isEqual: toset(@[         @"Class", @"ObjectID", @"placeholderString"])] ||
-                            [toset(notesDict.allKeys) isEqual: toset(@[         @"Class", @"ObjectID", @"label"])]
-                        )
-                    )
-                    ||
-                    (
-                        notesDict.allKeys.count == 4 &&
-                        (
-                            [toset(notesDict.allKeys) isEqual: toset(@[@"Note", @"Class", @"ObjectID", @"title"])] ||
-                            [toset(notesDict.allKeys) isEqual: toset(@[@"Note", @"Class", @"ObjectID", @"ibShadowedToolTip"])] ||
-                            [toset(notesDict.allKeys) isEqual: toset(@[@"Note", @"Class", @"ObjectID", @"placeholderString"])] ||
-                            [toset(notesDict.allKeys) isEqual: toset(@[@"Note", @"Class", @"ObjectID", @"label"])]
-                            
-                        )
-                    )
-                ) {
-                    uiString = notesDict[@"Note"] ?: @""; /// Remove everything except @"Note" ... Actually the @"Class" values (e.g. NSMenuItem) may give somewhat useful context, too. Even the uiString-keys (e.g. `placeholderString`) is somewhat useful – Maybe we should add them back? .. But shouldn't be necessary for MMF since we have lots of comments and screenshots.[Nov 2025]
+            dispatch_async(dispatch_get_main_queue(), ^{
+                store->displayNotes = displayNotes;
+            });
+            
+            mflog(@"Built displayNotes for %ld rows in %.0f ms", store->count, (CFAbsoluteTimeGetCurrent() - t0) * 1000);
+            
+            /// Search index
+            auto searchStrings = [NSMutableArray arrayWithCapacity: store->count];
+            for (NSInteger row = 0; row < store->count; row++) {
+                @autoreleasepool {
+                    if (store->parentRow[row] != -1) [searchStrings addObject: [NSNull null]]; /// Plural variants are part of their parent's searchString
+                    else                             [searchStrings addObject: _rowModel_makeSearchString(store->transUnits[row], targets, displayNotes)];
                 }
-                else
-                    assert(false);
             }
-        }
+            SearchIndex *index = SearchIndex_Make(searchStrings);
+            
+            mflog(@"Built SearchIndex for %ld rows in %.0f ms", store->count, (CFAbsoluteTimeGetCurrent() - t0) * 1000);
+            
+            dispatch_async(dispatch_get_main_queue(), ^{
+                store->searchIndex = index;
+                store->isBuildingCaches = NO;
+                for (NSInteger row = 0; row < store->count; row++) { /// Also fill the searchString cache while we're at it.
+                    if (store->searchStrings[row] == (id)[NSNull null] && ![store->searchIndexDirtyRows containsIndex: row])
+                        store->searchStrings[row] = searchStrings[row];
+                }
+            });
+        });
+    }
+
+    void _buildTranslationMemoryInBackground(TableView *self, RowStore *store) {
+        
+        /// Fills `store->translationMemory` with the translated rows of the document – and of the other open documents with the same target language. [Oct 2026]
+        ///     The other documents' later edits only go into their own memory.
         
-        /// Handle pluralizable strings
+        if (!store || store->translationMemory || store->isBuildingTranslationMemory) return;
+        store->isBuildingTranslationMemory = YES;
+        
+        /// Snapshot on the main thread
+        ///     Only @"target" and @"state" can change while we're in the background. Sources never change (See `RowStore.m`)
+        auto stores  = [NSMutableArray<RowStore *> arrayWithObject: store];
+        auto targets = [NSMutableArray<NSArray<NSString *> *> new];
+        auto states  = [NSMutableArray<NSData *> new];
         {
-            if (rowModel_isPluralParent(transUnit)) {
-                if ((0)) {}
-                else if (iscol(@"id"))       {}
-                else if (iscol(@"source"))   uiString = @"(pluralizable)";
-                else if (iscol(@"target")) { uiString = @"(pluralizable)"; } /// We never want the `%#@formatSstring@` to be changed by the translators, so we override it.
-                else if (iscol(@"state"))    { if ((0)) uiString = @"(pluralizable)"; }
-                else if (iscol(@"note"))     {}
-                else                         assert(false);
+            Xliff *xliff = getdoc(self)->_xliff;
+            for (XclocDocument *doc in getdoc_alldocs()) {
+                if (!doc->_xliff || doc->_xliff == xliff || !doc->_xliff->rowStore) continue; /// Still loading
+                if (![doc->_xliff->targetLanguage isEqual: xliff->targetLanguage]) continue;
+                [stores addObject: doc->_xliff->rowStore];
             }
-
-            if (rowModel_isPluralChild(transUnit)) {
-
-                if (iscol(@"id")) {
-                    
-                    NSArray *a = [xml_attr(transUnit, @"id").objectValue componentsSeparatedByString: @"|==|"];
-                    assert(a.count == 2);
-                    
-                    NSString *substitutionPath = a[1];
-                    assert([substitutionPath hasPrefix: @"substitutions.pluralizable.plural."]);
-                    
-                    NSString *pluralVariant = [substitutionPath substringFromIndex: @"substitutions.pluralizable.plural.".length];
-                    
-                    uiString = pluralVariant; /// Just show the variant name (e.g. "one", "other") since it's a child row
-                }
-                else if (iscol(@"note"))
-                    uiString = @""; /// Delete the note cause the parent row already has it.
+            for (RowStore *s in stores) {
+                [targets addObject: [s->targets copy]];
+                [states addObject: [NSData dataWithBytes: s->states length: s->count * sizeof(MFTransUnitState)]];
             }
         }
         
-        return uiString;
-        #undef iscol
+        dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+            
+            mftrace_scope("tm.build");
+            CFAbsoluteTime t0 = CFAbsoluteTimeGetCurrent();
+            
+            TranslationMemory *tm = TranslationMemory_Make();
+            for (NSInteger k = 0; k < (NSInteger)stores.count; k++) {
+                RowStore *s = stores[k];
+                const MFTransUnitState *st = states[k].bytes;
+                for (NSInteger row = 0; row < s->count; row++) {
+                    @autoreleasepool {
+                        if (st[row] != MFTransUnitState_Translated || s->isPluralParent[row]) continue;
+                        translationMemory_add(tm, s->sources[row], targets[k][row]);
+                    }
+                }
+            }
+            
+            mflog(@"Built TranslationMemory with %ld pairs in %.0f ms", tm->entryCount, (CFAbsoluteTimeGetCurrent() - t0) * 1000);
+            
+            dispatch_async(dispatch_get_main_queue(), ^{
+                /// Catch up on the edits that happened while we were building
+                ///     Swap the pair we built from for the current one, like `rowStore_setCellModel()` does.
+                NSArray<NSString *> *oldTargets = targets[0];
+                const MFTransUnitState *oldStates = states[0].bytes;
+                for (NSInteger row = 0; row < store->count; row++) {
+                    if (store->targets[row] == oldTargets[row] && store->states[row] == oldStates[row]) continue;
+                    if (store->isPluralParent[row]) continue;
+                    translationMemory_update(tm, store->sources[row],
+                        oldStates[row]      == MFTransUnitState_Translated ? oldTargets[row]     : nil,
+                        store->states[row]  == MFTransUnitState_Translated ? store->targets[row] : nil
+                    );
+                }
+                store->translationMemory = tm;
+                store->isBuildingTranslationMemory = NO;
+                [self _updateTranslationMemorySuggestions];
+            });
+        });
     }
 
+    static NSString *_issuesDescription(MFRowIssue issues) { /// toolTip of the @"state" cell [Oct 2026]
+        auto lines = [NSMutableArray<NSString *> arrayWithObject: stringf(@"%@:", kMFStr_Issues)];
+        if (issues & MFRowIssue_MissingSpecifier)       [lines addObject: stringf(@"• %@", kMFStr_Issue_MissingSpecifier)];
+        if (issues & MFRowIssue_ExtraSpecifier)         [lines addObject: stringf(@"• %@", kMFStr_Issue_ExtraSpecifier)];
+        if (issues & MFRowIssue_MismatchedSpecifier)    [lines addObject: stringf(@"• %@", kMFStr_Issue_MismatchedSpecifier)];
+        if (issues & MFRowIssue_PluralVariable)         [lines addObject: stringf(@"• %@", kMFStr_Issue_PluralVariable)];
+        if (issues & MFRowIssue_EmptyVariant)           [lines addObject: stringf(@"• %@", kMFStr_Issue_EmptyVariant)];
+        return [lines componentsJoinedByString: @"\n"];
+    }
 
     NSTableCellView *_getCellView(TableView *self, NSTableColumn *tableColumn, id item) {
             
@@ -1292,10 +1878,16 @@ auto reusableViewIDs = @[ /// Include any IDs that we call `makeViewWithIdentifi
             
         /// Measure how many times this is invoked.
         ///     `makeViewWithIdentifier:` is the biggest bottleneck to responsive switching between sidebar items. [Nov 2025]
-        if ((0)) mflog(@"viewForTableColumn: (%d)", __invocations++);
+        ///     Used to be a static counter we'd log here – see the Performance panel now (`Trace.m`) [Oct 2026]
+        mftrace_scope("render.cellView");
+        mftrace_count("render.cellViews", 1);
             
         NSString *uiString = rowModel_getUIString(self, item, tableColumn.identifier);
         
+        /// Get issues
+        ///     Plural parents include the ones of their variants. (See `rowModel_getIssues()`) [Oct 2026]
+        MFRowIssue issues = iscol(@"state") ? rowModel_getIssues(transUnit) : MFRowIssue_None;
+        
         /// Override raw state string with colorful symbols / badges
         NSMutableAttributedString *uiStringAttributed  = [[NSMutableAttributedString alloc] initWithString: (uiString ?: @"")];
         NSColor *stateCellBackgroundColor = nil;
@@ -1323,43 +1915,21 @@ auto reusableViewIDs = @[ /// Include any IDs that we call `makeViewWithIdentifi
                     assert(false);
                 }
             }
+            
+            if (iscol(@"state") && issues) { /// Flag rows with issues in front of the state. The details are in the toolTip (See `Validator.m`) [Oct 2026]
+                [uiStringAttributed insertAttributedString: attributed(@" ") atIndex: 0];
+                [uiStringAttributed insertAttributedString: make_issue_symbol(kMFStr_Issues) atIndex: 0];
+            }
         }
         
         /// Add `filter-highlights` (aka search-highlights)
         
-        if (self->_filterString.length && !iscol(@"state")) { /// @"state" col is excluded from searching. See [updateFilter:], also see `#define combinedRowString`[Dec 2025]
+        if (self->_lastFilter_string.length && !iscol(@"state")) { /// @"state" col is excluded from searching. See [updateFilter:], also see `#define combinedRowString`[Dec 2025]
             
-            /// Find ranges in the uiString that match the `_filterString`
+            /// Get ranges in the uiString that match the `_lastFilter_string`
             ///     (And are therefore responsible for this row being shown. See `kFilterField_StringCompareOptions`) [Dec 2025]
-            auto filterMatchRanges = [NSMutableArray new];
-            {
-                NSRange lastMatchRange = {};
-                for (int i = 0; ; i++) {
-                
-                    NSUInteger searchStart = 0;
-                    if (i) {
-                        searchStart = NSMaxRange(lastMatchRange);
-                        if (searchStart == lastMatchRange.location) {
-                            searchStart++; /// Prevent infinite-loop when using `.*` regex. which sometimes matches zero-length stuff.
-                            if (uiStringAttributed.string.length < searchStart) break;
-                        }
-                    }
-                
-                    NSRange matchRange = [uiStringAttributed.string
-                        rangeOfString: self->_filterString
-                        options: self->_filterOptions
-                        range: NSMakeRange(searchStart, uiStringAttributed.string.length - searchStart)
-                    ];
-                    
-                    if (matchRange.location == NSNotFound) break;
-                    
-                    mflog(@"searchMatch: %@ | %lu | %@", NSStringFromRange(matchRange), uiStringAttributed.string.length, [uiStringAttributed.string substringWithRange: matchRange]);
-                    
-                    [filterMatchRanges addObject: [NSValue valueWithRange: matchRange]];
-                    
-                    lastMatchRange = matchRange;
-                }
-            }
+            ///     Found by the filter pass in the background (See `filterQuery_run()`) – nothing to match while scrolling. [Oct 2026]
+            NSArray<NSValue *> *filterMatchRanges = [self->_filterMatchRanges objectForKey: transUnit][tableColumn.identifier];
             
             /// Get highlightColor
             static NSColor *highlightColor;
@@ -1451,6 +2021,7 @@ auto reusableViewIDs = @[ /// Include any IDs that we call `makeViewWithIdentifi
                     quickLookButton.hidden = !matchingScreenshotPlistEntry;
 
                     if (matchingScreenshotPlistEntry) {
+                        screenshotCache_prefetch(getScreenshotCache(getdoc(self)), matchingScreenshotPlistEntry[@"screenshots"]); /// Render in the background, so Quick Look opens instantly [Oct 2026]
                         NSButton *quickLookButton = (id)[cell searchSubviewWithIdentifier: @"quick-look-button"];
                         mflog(@"quick-look-button special config: %p (row: %ld)", quickLookButton, [self rowForItem: transUnit]);
                         [quickLookButton setAction: @selector(quickLookButtonPressed:)];
@@ -1465,6 +2036,18 @@ auto reusableViewIDs = @[ /// Include any IDs that we call `makeViewWithIdentifi
                 cell = [self makeViewWithIdentifier: @"theReusableCell_TableTarget" owner: self]; /// This contains an `MFTextField`
             
                 makeEditable = !rowModel_isPluralParent(transUnit);
+                
+                /// Show the best translation memory suggestion in empty targets – and all of them in the tooltip [Oct 2026]
+                ///     Reset on every call, since cells are reused.
+                {
+                    NSArray<TMSuggestion *> *suggestions = transUnit == self->_tmSuggestionsItem ? self->_tmSuggestions : nil;
+                    cell.textField.placeholderString = suggestions.count ? suggestions[0]->target : nil;
+                    cell.textField.toolTip = !suggestions.count ? nil : ({
+                        auto lines = [NSMutableArray<NSString *> arrayWithObject: kMFStr_TranslationMemory];
+                        for (TMSuggestion *sg in suggestions) [lines addObject: kMFStr_TranslationMemorySuggestion(sg)];
+                        [lines componentsJoinedByString: @"\n"];
+                    });
+                }
             }
             else if (iscol(@"state")) {
                 
@@ -1512,6 +2095,7 @@ auto reusableViewIDs = @[ /// Include any IDs that we call `makeViewWithIdentifi
             }
             
             /// Common config
+            if (!iscol(@"target")) cell.textField.toolTip = issues ? _issuesDescription(issues) : nil; /// The target cell sets its own. Reset for the others, since @"state", @"source" and @"note" share reusable cells. [Oct 2026]
             cell.textField.delegate      = (id)self;
             cell.textField.lineBreakMode = lineBreakMode;
             cell.textField.selectable    = makeSelectable;
@@ -1553,12 +2137,151 @@ auto reusableViewIDs = @[ /// Include any IDs that we call `makeViewWithIdentifi
         return _getCellView(self, tableColumn, item); /// Factored out `_getCellView()` to implement `heightOfRowByItem:`, but gave up on that [Nov 2025]
     }
 
+    #pragma mark - Row heights
+    
+    static NSDictionary *_Nullable _localizedStringsDataPlist_GetEntry(NSDictionary<NSString *, NSArray<NSDictionary *> *> *screenshotIndex, Xliff *xliff, NSXMLElement *transUnit) {
+        
+        /// Implementation of `_localizedStringsDataPlist_GetEntryForRowModel:` – any thread, so the row-height passes can use it in the background. [Oct 2026]
+        ///     Hashed lookup – this runs for every cell the table makes.
+        ///     `tableName` is the name of the row's `<file>`, and only matters when several tables use the same key. (Used to be an `assert((0))`-ed out check here.)
+        
+        NSString *tableName = nil;
+        {
+            NSInteger row;
+            RowStore *store = rowStore_lookup(transUnit, &row);
+            if (store && store == xliff->rowStore && row >= 0) tableName = xliff->filePaths[store->fileIndexes[row]].lastPathComponent.stringByDeletingPathExtension;
+        }
+        return screenshotIndex_getEntry(screenshotIndex, rowModel_getCellModel(transUnit, @"id"), tableName);
+    }
+    
+    - (RowHeightsLayout) _rowHeightsLayout {
+        
+        /// Cell widths
+        ///     `frameOfCellAtColumn:row:` includes the indentation of the outline column – row 0 is always top-level.
+        return (RowHeightsLayout) {
+            .idWidth                = [self frameOfCellAtColumn: [self columnWithIdentifier: @"id"]     row: 0].size.width,
+            .sourceWidth            = [self frameOfCellAtColumn: [self columnWithIdentifier: @"source"] row: 0].size.width,
+            .targetWidth            = [self frameOfCellAtColumn: [self columnWithIdentifier: @"target"] row: 0].size.width,
+            .noteWidth              = [self frameOfCellAtColumn: [self columnWithIdentifier: @"note"]   row: 0].size.width,
+            .indentationPerLevel    = self.indentationPerLevel,
+        };
+    }
+    
+    - (RowHeightsFlags (^)(NSXMLElement *)) _rowHeightsGetFlags {
+        
+        /// Mirrors the @"id" cell config in `_getCellView()`. The block only reads what it captures here, so it works on any thread.
+        
+        BOOL allTransUnitsShown = [getdoc(self)->ctrl->out_sourceList allTransUnitsShown];
+        NSDictionary *screenshotIndex = getdoc(self)->_screenshotIndex;
+        Xliff *xliff = getdoc(self)->_xliff;
+        return ^RowHeightsFlags (NSXMLElement *item) {
+            RowHeightsFlags flags = 0;
+            if (allTransUnitsShown && !rowModel_isPluralChild(item))               flags |= RowHeightsFlags_ShowsFilename;
+            if (_localizedStringsDataPlist_GetEntry(screenshotIndex, xliff, item))  flags |= RowHeightsFlags_ShowsQuickLook;
+            return flags;
+        };
+    }
+    
+    - (void) _measureRowHeightsInRows: (NSRange)rows {
+        
+        /// Measures `rows` right away with `rowHeights_measure()`, and tells the table when heights change. Only for the few rows on screen – this walks the outlineView's rows. [Oct 2026]
+        
+        rows = NSIntersectionRange(rows, NSMakeRange(0, self.numberOfRows));
+        if (!rows.length) return;
+        
+        RowHeightsFlags (^getFlags)(NSXMLElement *) = [self _rowHeightsGetFlags];
+        auto items = [NSMutableArray<NSXMLElement *> arrayWithCapacity: rows.length];
+        NSInteger *levels = malloc(rows.length * sizeof(NSInteger));
+        RowHeightsFlags *flags = malloc(rows.length * sizeof(RowHeightsFlags));
+        for (NSInteger i = 0; i < rows.length; i++) {
+            NSXMLElement *item = [self itemAtRow: rows.location + i];
+            [items addObject: item];
+            levels[i] = [self levelForRow: rows.location + i];
+            flags[i] = getFlags(item);
+        }
+        
+        rowHeights_measure(self->_rowHeights, items, levels, flags, [self _rowHeightsLayout], ^(NSIndexSet *changed) {
+            auto changedRows = [NSMutableIndexSet new];
+            [changed enumerateIndexesUsingBlock: ^(NSUInteger i, BOOL *stop) {
+                [changedRows addIndex: rows.location + i];
+            }];
+            [self _noteHeightOfRowsWithIndexesChanged_KeepingPosition: changedRows];
+        });
+        
+        free(levels);
+        free(flags);
+    }
+    
+    - (void) _measureRowHeightsInBackground: (NSArray<NSXMLElement *> *_Nullable)items {
+        
+        /// Measures `items` and their children in the background – or all displayed rows if `items` is nil. Then tells the table which heights changed. [Oct 2026]
+        ///     Pass the rows that are new or were forgotten (`rowHeights_forget()`). The others keep their heights.
+        ///     Cheap on the main thread: The pass finds the rows' levels and flags itself (See `rowHeights_measureInBackground()`).
+        
+        if (!self.numberOfRows) return;
+        
+        BOOL allTransUnitsShown = [getdoc(self)->ctrl->out_sourceList allTransUnitsShown];
+        if (self->_rowHeights->isMeasuring)                        items = nil; /// The pending pass would be cancelled – take over its rows, too
+        if (allTransUnitsShown != self->_rowHeightsShowFilenames)  items = nil; /// Every row's flags changed
+        if (items && !items.count) return;
+        self->_rowHeightsShowFilenames = allTransUnitsShown;
+        
+        rowHeights_measureInBackground(self->_rowHeights, items ?: self->_displayedTopLevelTransUnits, !items, [self _rowHeightsGetFlags], [self _rowHeightsLayout], ^(NSArray<NSXMLElement *> *changedItems) {
+            auto changedRows = [NSMutableIndexSet new];
+            for (NSXMLElement *item in changedItems) {
+                NSInteger row = [self rowForItem: item]; /// -1 if it isn't displayed (anymore)
+                if (row != -1) [changedRows addIndex: row];
+            }
+            [self _noteHeightOfRowsWithIndexesChanged_KeepingPosition: changedRows];
+        });
+    }
+    
+    - (void) _measureRowHeightsOnScreen {
+        NSRange rows = [self rowsInRect: self.visibleRect];
+        rows.length += 2; /// +2 so the rows that are pushed on-screen by shrinking rows are also exact
+        [self _measureRowHeightsInRows: rows];
+    }
+    
+    - (void) _noteHeightOfRowsWithIndexesChanged_KeepingPosition: (NSIndexSet *)rows {
+        
+        /// `noteHeightOfRowsWithIndexesChanged:` without moving the selected row – or the top visible row if the selection is off-screen – on screen. [Oct 2026]
+        ///     Otherwise measurements coming in for the rows above would push the visible ones around.
+        
+        if (!rows.count) return;
+        
+        NSInteger anchor = self.selectedRow;
+        if (anchor == -1 || !NSIntersectsRect([self rectOfRow: anchor], self.visibleRect))
+            anchor = [self rowAtPoint: self.visibleRect.origin];
+        CGFloat anchorOffset = anchor != -1 ? NSMinY([self rectOfRow: anchor]) - NSMinY(self.visibleRect) : 0;
+        
+        [NSAnimationContext beginGrouping];
+        [[NSAnimationContext currentContext] setDuration: 0.0]; /// `noteHeightOfRowsWithIndexesChanged:` animates by default
+        [self noteHeightOfRowsWithIndexesChanged: rows];
+        [NSAnimationContext endGrouping];
+        
+        if (anchor != -1)
+            [self scrollPoint: (CGPoint) { .x = NSMinX(self.visibleRect), .y = NSMinY([self rectOfRow: anchor]) - anchorOffset }];
+    }
+    
+    - (void) outlineViewColumnDidResize: (NSNotification *)notification {
+        
+        /// Column widths change the wrapping. Measure what's on screen immediately, and the rest once the user stops dragging. [Oct 2026]
+        
+        if (!self.numberOfRows) return;
+        [self _measureRowHeightsOnScreen];
+        mfdebounce(0.2, stringf(@"measureRowHeights:%p", self), ^{
+            [self _measureRowHeightsInBackground: nil];
+        });
+    }
+
     #pragma mark - NSOutlineView subclass
     
     - (void) reloadData {
         [super reloadData];
+        self->_bulkSelection = nil; /// The same selected rows can be other items now
         [self expandItem: nil expandChildren: YES]; /// mfunexpand – Expand all items by default. || We're also using `reloadDataForRowIndexes:` additionally to `reloadData`, but overriding that doesn't seem necessary to keep the items expanded [Oct 2025]
-        __invocations = 1;
+        [self _measureRowHeightsOnScreen];                                                             /// Exact right away...
+        [self _measureRowHeightsInBackground: nil];                                                    /// ... and for the rest soon [Oct 2026]
         __invocation_rowheight = 1;
     }
     
@@ -1591,9 +2314,11 @@ auto reusableViewIDs = @[ /// Include any IDs that we call `makeViewWithIdentifi
         ///         Actually the jitter is also really bad if we don't implement this [macOS Tahoe, Nov 2025], so maybe we should just return a constant to at least make it faster to load? ... ah I'll just keep the default behavior and hope Apple improves it in the future.
         ///     UPDATE 2: Could fix the jitter by overriding `[TableRowView setFrame:]` [Nov 2025]
         
+        ///     UPDATE 3: Measuring the text directly is what we do now – in advance and mostly in the background, so this only has to look up the result. (See `RowHeights.m`) [Oct 2026]
+        
         - (CGFloat) outlineView: (NSOutlineView *)outlineView heightOfRowByItem: (id)item {
             
-            return _defaultRowHeight;
+            return rowHeights_get(self->_rowHeights, item) ?: _defaultRowHeight;
             
             #if 0
                 if ((0))
@@ -1638,6 +2363,8 @@ auto reusableViewIDs = @[ /// Include any IDs that we call `makeViewWithIdentifi
     #endif
 
     - (void) outlineViewSelectionDidChange: (NSNotification *)notification {
+        self->_bulkSelection = nil;
+        [self _updateTranslationMemorySuggestions];
         if ( /// Works without this if-statement but shows "this will raise soon" warning (macOS Sequoia)
             [QLPreviewPanel sharedPreviewPanelExists] &&
             [[QLPreviewPanel sharedPreviewPanel] isVisible]
@@ -1690,16 +2417,7 @@ auto reusableViewIDs = @[ /// Include any IDs that we call `makeViewWithIdentifi
                 ```
             */
             
-            NSDictionary *matchingPlistEntry = nil;
-            for (NSDictionary *entry in getdoc(self)->_localizedStringsDataPlist) {
-                if ([entry[@"stringKey"] isEqual: rowModel_getCellModel(transUnit, @"id")]) {
-                    if (matchingPlistEntry) assert(false); /// Multiple entries for this key
-                    matchingPlistEntry = entry;
-                }
-            }
-            if ((0)) assert([matchingPlistEntry[@"tableName"] isEqual: rowModel_getCellModel(transUnit, @"fileName")]); /// Our `rowModel` doesn't actually have a `@"fileName"`, but if it did, this should be true. [Oct 2025]
-            
-            return matchingPlistEntry;
+            return _localizedStringsDataPlist_GetEntry(getdoc(self)->_screenshotIndex, getdoc(self)->_xliff, transUnit);
         };
         
         - (IBAction) quickLookButtonPressed: (id)quickLookButton {
@@ -1844,90 +2562,19 @@ auto reusableViewIDs = @[ /// Include any IDs that we call `makeViewWithIdentifi
                 NSDictionary *plistEntry = [self _localizedStringsDataPlist_GetEntryForRowModel: [self ql_selectedItem]];
                 NSDictionary *screenshotEntry = plistEntry[@"screenshots"][index];
                 
-                NSRect frame = NSRectFromString(screenshotEntry[@"frame"]);
                 NSString *name = screenshotEntry[@"name"];
                 
-                NSString *imagePath = findPaths(
-                    0,
-                    [stringf(@"%@%@",
-                        [getdoc(self).fileURL path],
-                        @"/Notes/Screenshots/"
-                    ) stringByStandardizingPath],
-                    ^BOOL(NSString *path) {
-                        return [[path lastPathComponent] isEqual: name];
-                    }
-                )[0];
-                
-                auto imageFileData = [[NSData alloc] initWithContentsOfFile: imagePath];
-                
-                auto simpleHash = ^int (NSData *data) {
-                    
-                    const char *bytes = data.bytes;
-                    NSUInteger len = data.length;
-                    
-                    int hash = 0;
-                    for (int i = 0; i < len; i++)
-                        hash -= bytes[i];
-                    
-                    return hash;
-                };
-                
-                /// Get `annotatedImagePath`
+                /// Get the annotated screenshot
                 ///     We have to write the annotated image to a file to get the QLPreviewPanel to load it.
                 ///         Xcode's xcloc editor circumvents this somehow (But it's also buggy and doesn't update the annotations correctly)
-                ///         If the `annotatedImagePath` is a unique identifier for the annotated image, we can  use it to cache the annotatedImage. [Oct 2025]
-                
-                auto annotatedImagePath = [[[[NSFileManager defaultManager] temporaryDirectory] path] stringByAppendingPathComponent: stringf(@"%@%@%@%@%@%@",
-                    @"/mf-xcloc-editor/annotated-screenshots/",
-                    [[imagePath lastPathComponent] stringByDeletingPathExtension],
-                    @" --- ",
-                    [NSString stringWithFormat: @"(%@) %@", /// Cache key
-                        @(simpleHash(imageFileData)),           /// Uniquely identifies source image (screenshot filename could be non-unique when you have multiple `Mac Mouse Fix.xcloc` files for different locales. When the annotation rect is also the same the cache-key will conflict  – but that's very unlikely. [Nov 2025])
-                        NSStringFromRect(frame)             /// Uniquely identifies annotation
-                    ],
-                    @".",
-                    [imagePath pathExtension]
-                )];
-                
-                /// Check if annotatedImage already exists
-                /// This is how we cache. Makes things noticably more responsive. `-[NSImage drawInRect:]` is apparently reallyyyy slow. (Cache shaves off like half a second on my M1 MBA on a single run – which seems strange) [Oct 2025]
-                ///     Idea: Claude suggests this may be because the image is compressed? We did choose compressed jpegs to reduce file size IIRC, due to the Xcode bug that forced us to duplicate the images. Compression may no longer be beneficial when switching from Xcode -> mf-xcloc-editor. [Oct 2025]
-                if ([[NSFileManager defaultManager] fileExistsAtPath: annotatedImagePath]) {
-                    mflog(@"Using cached annotatedImage file at: %@", annotatedImagePath);
-                }
-                else {
-                    mflog(@"Creating new annotatedImage file at: %@", annotatedImagePath);
-                
-                    auto image = [[NSImage alloc] initWithData: imageFileData];
-                    auto annotatedImage = [NSImage imageWithSize: image.size flipped: YES drawingHandler: ^BOOL(NSRect dstRect) {
-                        
-                        [image drawInRect: dstRect]; /// This line is slow
-                        
-                        [NSColor.systemRedColor setStroke];
-                        
-                        auto path = [NSBezierPath bezierPathWithRect: frame];
-                        [path setLineWidth: 3.0];
-                        [path stroke];
-
-                        return YES;
-                    }];
-                
-                    /// Make parent dirs
-                    NSError *err = nil;
-                    [[NSFileManager defaultManager] createDirectoryAtPath: [annotatedImagePath stringByDeletingLastPathComponent] withIntermediateDirectories: YES attributes: nil error: &err];
-                    if (err) assert(false);
-                    
-                    /// Write `annotatedImage` to `annotatedImagePath`
-                    err = nil;
-                    auto jpegData = imageData(annotatedImage, NSBitmapImageFileTypeJPEG, @{});
-                    [jpegData writeToFile: annotatedImagePath options: NSDataWritingAtomic error: &err];
-                    if (err) assert(false);
-                }
+                ///     Usually this was already rendered in the background when the row got its cell – then this is instant. (See `Screenshots.m`) [Oct 2026]
+                NSURL *annotatedImageURL = screenshotCache_getAnnotatedImage(getScreenshotCache(getdoc(self)), name, screenshotEntry[@"frame"]);
+                if (!annotatedImageURL) return nil;
                 
                 auto item = [MFQLPreviewItem new];
                 {
-                    item.previewItemTitle = [imagePath lastPathComponent];
-                    item.previewItemURL   = [NSURL fileURLWithPath: annotatedImagePath];
+                    item.previewItemTitle = name;
+                    item.previewItemURL   = annotatedImageURL;
                     // item.previewItemDisplayState = nil; /// Do we need this? [Oct 2025]
                 }
                 
@@ -0,0 +1,332 @@
+//
+//  Trace.m
+//  mf-xcloc-editor
+//
+//  Created by Noah Nübling on 10/17/26.
+//
+
+/// Lightweight tracing – so there's something to look at when the editor froze. [Oct 2026]
+///
+///     Usage:
+///         { mftrace_scope("filter"); ... }           /// Times the rest of the enclosing scope
+///         mftrace_count("cellViews", 1);             /// Adds to a counter
+///
+///     Off by default. Turn it on in Window > Performance (or `defaults write <bundle-id> MFTraceEnabled -bool YES`)
+///         While it's off, every span and counter costs one load + branch on `_mftrace_enabled` – so they're fine to leave in hot paths like `_getCellView()`.
+///     While it's on, we keep:
+///         - The last `kMFTraceMaxEvents` spans and counter changes – exported as Chrome trace-event JSON (Open in `chrome://tracing` or https://ui.perfetto.dev)
+///         - The last `kMFTraceMaxSamples` durations per phase – for the p50/p99 in the Performance panel
+///
+///     Names have to be string literals (or otherwise live forever) – we only store the pointers.
+
+#include <mach/mach_time.h>
+#include <pthread.h>
+
+#define kMFTraceMaxEvents   (1 << 16)   /// ~2.5 MB
+#define kMFTraceMaxSamples  1024        /// Per phase
+#define kMFTraceMaxPhases   48
+#define kMFTraceMaxCounters 32
+
+#pragma mark - Storage
+
+typedef struct {
+    const char *name;
+    uint64_t start;     /// mach_absolute_time
+    uint64_t duration;  /// mach_absolute_time units. Unused for counters.
+    uint64_t tid;
+    int64_t value;      /// Counters only
+    char phase;         /// Chrome trace-event phase: 'X' (complete span) or 'C' (counter)
+} MFTraceEvent;
+
+typedef struct {
+    const char *name;
+    double samples[kMFTraceMaxSamples]; /// Milliseconds. Ring buffer
+    NSInteger count;                    /// Total, not capped
+    double maxMs;
+} MFTracePhase;
+
+typedef struct {
+    const char *name;
+    int64_t value;
+} MFTraceCounter;
+
+static bool _mftrace_enabled = false;
+static os_unfair_lock _mftrace_lock = OS_UNFAIR_LOCK_INIT;
+static MFTraceEvent *_mftrace_events;       /// Ring buffer. Allocated the first time tracing is enabled.
+static NSInteger _mftrace_eventCount;       /// Total, not capped
+static MFTracePhase *_mftrace_phases;
+static NSInteger _mftrace_phaseCount;
+static MFTraceCounter _mftrace_counters[kMFTraceMaxCounters];
+static NSInteger _mftrace_counterCount;
+static uint64_t _mftrace_epoch;             /// Timestamps in the export are relative to this
+static mach_timebase_info_data_t _mftrace_timebase;
+
+static double _mftrace_toMs(uint64_t machTime) {
+    return (double)machTime * _mftrace_timebase.numer / _mftrace_timebase.denom / 1e6;
+}
+
+static void mftrace_reset(void) {
+    os_unfair_lock_lock(&_mftrace_lock);
+    _mftrace_eventCount = 0;
+    _mftrace_phaseCount = 0;
+    _mftrace_counterCount = 0;
+    _mftrace_epoch = mach_absolute_time();
+    os_unfair_lock_unlock(&_mftrace_lock);
+}
+
+static void mftrace_setEnabled(bool enabled) {
+
+    /// Main thread only
+
+    if (enabled && !_mftrace_events) {
+        mach_timebase_info(&_mftrace_timebase);
+        _mftrace_events = calloc(kMFTraceMaxEvents, sizeof(MFTraceEvent));
+        _mftrace_phases = calloc(kMFTraceMaxPhases, sizeof(MFTracePhase));
+        mftrace_reset();
+    }
+    __atomic_store_n(&_mftrace_enabled, enabled, __ATOMIC_RELEASE);
+    [[NSUserDefaults standardUserDefaults] setBool: enabled forKey: @"MFTraceEnabled"];
+}
+
+static bool mftrace_isEnabled(void) {
+    return __atomic_load_n(&_mftrace_enabled, __ATOMIC_RELAXED);
+}
+
+#pragma mark - Recording
+
+static void _mftrace_record(const char *name, char phase, uint64_t start, uint64_t duration, int64_t value) {
+
+    uint64_t tid = 0;
+    pthread_threadid_np(NULL, &tid);
+
+    os_unfair_lock_lock(&_mftrace_lock);
+    {
+        /// Event
+        _mftrace_events[_mftrace_eventCount % kMFTraceMaxEvents] = (MFTraceEvent) {
+            .name = name, .start = start, .duration = duration, .tid = tid, .value = value, .phase = phase,
+        };
+        _mftrace_eventCount++;
+
+        /// Phase stats
+        if (phase == 'X') {
+            MFTracePhase *p = NULL;
+            for (NSInteger i = 0; i < _mftrace_phaseCount; i++)
+                if (_mftrace_phases[i].name == name || !strcmp(_mftrace_phases[i].name, name)) { p = &_mftrace_phases[i]; break; }
+            if (!p && _mftrace_phaseCount < kMFTraceMaxPhases) {
+                p = &_mftrace_phases[_mftrace_phaseCount++];
+                *p = (MFTracePhase) { .name = name };
+            }
+            if (p) {
+                double ms = _mftrace_toMs(duration);
+                p->samples[p->count % kMFTraceMaxSamples] = ms;
+                p->count++;
+                p->maxMs = MAX(p->maxMs, ms);
+            }
+        }
+    }
+    os_unfair_lock_unlock(&_mftrace_lock);
+}
+
+typedef struct {
+    const char *name; /// NULL if tracing was off when the span began
+    uint64_t start;
+} MFTraceSpan;
+
+static inline MFTraceSpan _mftrace_beginSpan(const char *name) {
+    if (__builtin_expect(!mftrace_isEnabled(), 1)) return (MFTraceSpan) {};
+    return (MFTraceSpan) { .name = name, .start = mach_absolute_time() };
+}
+static inline void _mftrace_endSpan(MFTraceSpan *span) {
+    if (__builtin_expect(!span->name, 1)) return;
+    if (!mftrace_isEnabled()) return; /// Turned off in the meantime – the buffers might've been reset
+    _mftrace_record(span->name, 'X', span->start, mach_absolute_time() - span->start, 0);
+}
+
+#define _MFTRACE_CAT_(a, b) a ## b
+#define _MFTRACE_CAT(a, b) _MFTRACE_CAT_(a, b)
+#define mftrace_scope(name) \
+    __attribute__((cleanup(_mftrace_endSpan), unused)) MFTraceSpan _MFTRACE_CAT(_mftrace_span_, __LINE__) = _mftrace_beginSpan(name)
+
+static void _mftrace_count(const char *name, int64_t delta) {
+
+    int64_t value;
+    os_unfair_lock_lock(&_mftrace_lock);
+    {
+        MFTraceCounter *c = NULL;
+        for (NSInteger i = 0; i < _mftrace_counterCount; i++)
+            if (_mftrace_counters[i].name == name || !strcmp(_mftrace_counters[i].name, name)) { c = &_mftrace_counters[i]; break; }
+        if (!c && _mftrace_counterCount < kMFTraceMaxCounters) {
+            c = &_mftrace_counters[_mftrace_counterCount++];
+            *c = (MFTraceCounter) { .name = name };
+        }
+        if (!c) { os_unfair_lock_unlock(&_mftrace_lock); return; }
+        c->value += delta;
+        value = c->value;
+    }
+    os_unfair_lock_unlock(&_mftrace_lock);
+
+    _mftrace_record(name, 'C', mach_absolute_time(), 0, value);
+}
+
+#define mftrace_count(name, delta) ({ \
+    if (__builtin_expect(mftrace_isEnabled(), 0)) _mftrace_count((name), (delta)); \
+})
+
+#pragma mark - Reading
+
+static int _mftrace_compareDoubles(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static NSString *mftrace_statsDescription(void) {
+
+    /// The text of the Performance panel: Latency percentiles per phase, then the counters.
+
+    if (!_mftrace_events) return @"Tracing is off.";
+
+    auto result = [NSMutableString new];
+    [result appendFormat: @"%-28s %8s %10s %10s %10s\n", "Phase", "Count", "p50 (ms)", "p99 (ms)", "Max (ms)"];
+
+    os_unfair_lock_lock(&_mftrace_lock);
+    {
+        double sorted[kMFTraceMaxSamples];
+        for (NSInteger i = 0; i < _mftrace_phaseCount; i++) {
+            MFTracePhase *p = &_mftrace_phases[i];
+            NSInteger n = MIN(p->count, kMFTraceMaxSamples);
+            memcpy(sorted, p->samples, n * sizeof(double));
+            qsort(sorted, n, sizeof(double), _mftrace_compareDoubles);
+            [result appendFormat: @"%-28s %8ld %10.2f %10.2f %10.2f\n", p->name, p->count, sorted[(n - 1) / 2], sorted[(NSInteger)((n - 1) * 0.99)], p->maxMs];
+        }
+        if (_mftrace_counterCount) {
+            [result appendFormat: @"\n%-28s %8s\n", "Counter", "Value"];
+            for (NSInteger i = 0; i < _mftrace_counterCount; i++)
+                [result appendFormat: @"%-28s %8lld\n", _mftrace_counters[i].name, _mftrace_counters[i].value];
+        }
+        [result appendFormat: @"\n%ld events recorded (the last %d are kept for export)\n", _mftrace_eventCount, kMFTraceMaxEvents];
+    }
+    os_unfair_lock_unlock(&_mftrace_lock);
+
+    return result;
+}
+
+static BOOL mftrace_exportChromeTrace(NSURL *url, NSError *__autoreleasing _Nullable *outError) {
+
+    /// Writes the recorded events in Chrome's trace-event format (The "JSON Object Format" with `traceEvents`)
+
+    if (!_mftrace_events) {
+        if (outError) *outError = mferror(NSCocoaErrorDomain, 0, @"Nothing was recorded – tracing is off");
+        return NO;
+    }
+
+    auto events = [NSMutableArray<NSDictionary *> new];
+    int pid = [NSProcessInfo processInfo].processIdentifier;
+
+    os_unfair_lock_lock(&_mftrace_lock);
+    {
+        NSInteger first = MAX(0, _mftrace_eventCount - kMFTraceMaxEvents);
+        for (NSInteger i = first; i < _mftrace_eventCount; i++) {
+            MFTraceEvent *e = &_mftrace_events[i % kMFTraceMaxEvents];
+            double ts = e->start >= _mftrace_epoch ? _mftrace_toMs(e->start - _mftrace_epoch) * 1000.0 : 0; /// Microseconds
+            if (e->phase == 'X') {
+                [events addObject: @{ @"name": @(e->name), @"ph": @"X", @"ts": @(ts), @"dur": @(_mftrace_toMs(e->duration) * 1000.0), @"pid": @(pid), @"tid": @(e->tid) }];
+            }
+            else {
+                [events addObject: @{ @"name": @(e->name), @"ph": @"C", @"ts": @(ts), @"pid": @(pid), @"args": @{ @"value": @(e->value) } }];
+            }
+        }
+    }
+    os_unfair_lock_unlock(&_mftrace_lock);
+
+    NSData *data = [NSJSONSerialization dataWithJSONObject: @{ @"traceEvents": events, @"displayTimeUnit": @"ms" } options: 0 error: outError];
+    if (!data) return NO;
+    return [data writeToURL: url options: NSDataWritingAtomic error: outError];
+}
+
+#pragma mark - Performance panel
+
+@interface MFTraceStatsPanel : NSPanel @end
+@implementation MFTraceStatsPanel
+    {
+        NSTextView *_textView;
+        NSButton *_enabledCheckbox;
+        NSTimer *_refreshTimer;
+    }
+
+    + (instancetype) shared {
+        static MFTraceStatsPanel *panel;
+        if (!panel) panel = [[MFTraceStatsPanel alloc] init];
+        return panel;
+    }
+
+    - (instancetype) init {
+
+        self = [super
+            initWithContentRect: NSMakeRect(0, 0, 620, 360)
+            styleMask: NSWindowStyleMaskTitled | NSWindowStyleMaskClosable | NSWindowStyleMaskResizable | NSWindowStyleMaskUtilityWindow
+            backing: NSBackingStoreBuffered
+            defer: YES
+        ];
+        if (!self) return nil;
+
+        self.title = @"Performance";
+        self.releasedWhenClosed = NO;
+        self.hidesOnDeactivate = NO;
+        [self setFrameAutosaveName: @"MFTraceStatsPanel"];
+
+        /// Text
+        auto scrollView = [NSTextView scrollableTextView];
+        self->_textView = scrollView.documentView;
+        self->_textView.editable = NO;
+        self->_textView.font = [NSFont monospacedSystemFontOfSize: 11 weight: NSFontWeightRegular];
+
+        /// Buttons
+        self->_enabledCheckbox = [NSButton checkboxWithTitle: @"Record" target: self action: @selector(toggleEnabled:)];
+        auto resetButton  = [NSButton buttonWithTitle: @"Reset"           target: self action: @selector(reset:)];
+        auto exportButton = [NSButton buttonWithTitle: @"Export Trace…"   target: self action: @selector(exportTrace:)];
+        auto buttons = [NSStackView stackViewWithViews: @[self->_enabledCheckbox, [NSView new], resetButton, exportButton]];
+        [buttons setHuggingPriority: NSLayoutPriorityDefaultLow forOrientation: NSLayoutConstraintOrientationHorizontal];
+
+        auto stack = [NSStackView stackViewWithViews: @[scrollView, buttons]];
+        stack.orientation = NSUserInterfaceLayoutOrientationVertical;
+        stack.edgeInsets = NSEdgeInsetsMake(8, 8, 8, 8);
+        self.contentView = stack;
+
+        return self;
+    }
+
+    - (void) makeKeyAndOrderFront: (id)sender {
+        [super makeKeyAndOrderFront: sender];
+        [self refresh];
+        if (!self->_refreshTimer)
+            self->_refreshTimer = [NSTimer scheduledTimerWithTimeInterval: 1.0 repeats: YES block: ^(NSTimer *timer) {
+                if (!MFTraceStatsPanel.shared.visible) { [timer invalidate]; MFTraceStatsPanel.shared->_refreshTimer = nil; return; }
+                [MFTraceStatsPanel.shared refresh];
+            }];
+    }
+
+    - (void) refresh {
+        self->_enabledCheckbox.state = mftrace_isEnabled();
+        self->_textView.string = mftrace_statsDescription();
+    }
+
+    - (void) toggleEnabled: (NSButton *)sender {
+        mftrace_setEnabled(sender.state == NSControlStateValueOn);
+        [self refresh];
+    }
+    - (void) reset: (id)sender {
+        if (_mftrace_events) mftrace_reset();
+        [self refresh];
+    }
+    - (void) exportTrace: (id)sender {
+        auto savePanel = [NSSavePanel savePanel];
+        savePanel.nameFieldStringValue = stringf(@"xcloc-editor-trace-%.0f.json", [NSDate date].timeIntervalSince1970);
+        [savePanel beginSheetModalForWindow: self completionHandler: ^(NSModalResponse response) {
+            if (response != NSModalResponseOK) return;
+            NSError *err = nil;
+            if (!mftrace_exportChromeTrace(savePanel.URL, &err))
+                [[NSAlert alertWithError: err] beginSheetModalForWindow: self completionHandler: nil];
+        }];
+    }
+
+@end
@@ -0,0 +1,361 @@
+//
+//  TranslationMemory.m
+//  mf-xcloc-editor
+//
+//  Created by Noah Nübling on 10/17/26.
+//
+
+/// Suggests targets for a source, from the source → target pairs that are already translated [Oct 2026]
+///
+///     Why: The same strings show up all over a project – a button title in several storyboards, plus its `.strings` entry. Translators kept retyping them.
+///
+///     Exact matches: Hash lookup on the source (`entriesForSource`).
+///     Fuzzy matches: Each source gets a MinHash signature over its trigrams (folded and cut up the same way as in `SearchIndex.m`). The signature is split into bands, and each band is hashed into `bands` (LSH).
+///         Sources with similar trigram sets are likely to share at least one band – those are the candidates. They're ranked by how many bands they share, and only the best `kTMMaxCandidates` get their edit distance computed.
+///
+///     Threads: Built in the background by `_buildTranslationMemoryInBackground()` in TableView.m.
+///         After that, edits come in through `translationMemory_update()`, which does the MinHash work on `queue` – so bulk edits on the main thread don't wait for it. `translationMemory_suggest()` (background) shares `lock` with the writes. The edit distances are computed outside the lock.
+///
+///     Counts: Each entry counts the rows that currently have the pair. When a row's target changes, its old pair is counted down – at 0 it's not suggested anymore. (The entry stays in `bands` – it comes back if a row gets the pair again.)
+
+#define kTMHashCount        32      /// MinHash signature length
+#define kTMBandRows         2       /// Hashes per band -> 16 bands. Sources with a trigram-Jaccard of 0.5 share a band with ~99% probability, 0.2 with ~48%, 0.1 with ~15%.
+#define kTMMaxCandidates    256     /// Bounds the edit distance work per query
+#define kTMMinSimilarity    0.6     /// 1 - editDistance / length of the longer source. Below this, suggestions are more confusing than helpful.
+
+@interface TMSuggestion : NSObject
+    {
+        @public
+        NSString *source;
+        NSString *target;
+        double similarity;      /// 1.0 for exact matches
+        NSInteger count;        /// How often this exact pair was added – roughly how many rows have it
+    }
+@end
+@implementation TMSuggestion
+@end
+
+typedef struct {
+    uint32_t hashes[kTMHashCount];
+} TMSignature;
+
+@interface TranslationMemory : NSObject
+    {
+        @public
+        dispatch_queue_t queue;                                                         /// Serial. Runs `translationMemory_update()`, so updates land in order.
+        mflock_t lock;                                                                  /// Guards everything below
+        NSMutableArray<NSString *> *sources;                                            /// Indexed by entry. One entry per distinct source → target pair.
+        NSMutableArray<NSString *> *targets;
+        NSInteger *counts;
+        NSInteger entryCount;
+        NSInteger _capacity;
+        NSMutableDictionary<NSString *, NSMutableArray<NSNumber *> *> *entriesForSource; /// Exact matches
+        CFMutableDictionaryRef bands;                                                   /// band key -> `Postings *` of entries (See `SearchIndex.m`) || NULL callbacks like `SearchIndex->postings`
+    }
+@end
+
+@implementation TranslationMemory
+
+    - (void) dealloc {
+        free(self->counts);
+        if (!self->bands) return;
+        CFIndex n = CFDictionaryGetCount(self->bands);
+        const void **values = malloc(MAX(n, 1) * sizeof(void *));
+        CFDictionaryGetKeysAndValues(self->bands, NULL, values);
+        for (CFIndex i = 0; i < n; i++) {
+            free(((Postings *)values[i])->rows);
+            free((void *)values[i]);
+        }
+        free(values);
+        CFRelease(self->bands);
+    }
+
+@end
+
+#pragma mark - Helpers
+
+    static inline uint64_t _tm_mix(uint64_t x) { /// splitmix64 finalizer
+        x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return x;
+    }
+
+    static void _tm_makeSignature(NSString *source, TMSignature *outSignature) {
+
+        /// MinHash over the trigrams of the folded source. `kTMHashCount` hash functions of the form `(a * x + b) >> 32`, all derived from a single mix of the trigram.
+        ///     The source is padded with control chars, so short sources (and the starts and ends of longer ones) have trigrams, too.
+
+        static uint64_t a[kTMHashCount], b[kTMHashCount];
+        static dispatch_once_t onceToken;
+        dispatch_once(&onceToken, ^{
+            for (int i = 0; i < kTMHashCount; i++) {
+                a[i] = _tm_mix(2 * i + 1) | 1;
+                b[i] = _tm_mix(2 * i + 2);
+            }
+        });
+
+        for (int i = 0; i < kTMHashCount; i++) outSignature->hashes[i] = UINT32_MAX;
+        _searchIndex_forEachTrigram(stringf(@"\2%@\3", _searchIndex_fold(source)), ^(uint64_t trigram) {
+            uint64_t x = _tm_mix(trigram);
+            for (int i = 0; i < kTMHashCount; i++) {
+                uint32_t h = (uint32_t)((a[i] * x + b[i]) >> 32);
+                if (h < outSignature->hashes[i]) outSignature->hashes[i] = h;
+            }
+        });
+    }
+
+    static void _tm_forEachBandKey(const TMSignature *signature, void (^callback)(uint64_t key)) {
+        for (int band = 0; band < kTMHashCount / kTMBandRows; band++) {
+            uint64_t key = _tm_mix(band + 1);
+            for (int r = 0; r < kTMBandRows; r++)
+                key = _tm_mix(key ^ signature->hashes[band * kTMBandRows + r]);
+            callback(key ?: 1); /// 0 would be the NULL key
+        }
+    }
+
+    static NSInteger _tm_editDistance(const unichar *s, NSInteger n, const unichar *t, NSInteger m, NSInteger maxDistance) {
+
+        /// Levenshtein distance, or `maxDistance + 1` if it's larger than `maxDistance`.
+        ///     Only fills the diagonal band of width `2 * maxDistance + 1` – cells outside of it can't be ≤ `maxDistance` – and stops once a whole row is over. O(n * maxDistance)
+
+        NSInteger over = maxDistance + 1;
+        if (labs(n - m) > maxDistance) return over;
+
+        NSInteger *prev = malloc((m + 2) * sizeof(NSInteger));
+        NSInteger *cur  = malloc((m + 2) * sizeof(NSInteger));
+        for (NSInteger j = 0; j <= m + 1; j++) prev[j] = j <= maxDistance ? j : over;
+
+        for (NSInteger i = 1; i <= n; i++) {
+            NSInteger lo = MAX(1, i - maxDistance);
+            NSInteger hi = MIN(m, i + maxDistance);
+            cur[lo - 1] = lo == 1 && i <= maxDistance ? i : over;
+            NSInteger rowMin = cur[lo - 1];
+            for (NSInteger j = lo; j <= hi; j++) {
+                NSInteger v = prev[j - 1] + (s[i - 1] != t[j - 1]);
+                v = MIN(v, prev[j] + 1);
+                v = MIN(v, cur[j - 1] + 1);
+                cur[j] = MIN(v, over);
+                rowMin = MIN(rowMin, cur[j]);
+            }
+            if (hi < m) cur[hi + 1] = over; /// The next row reads one cell further right
+            if (rowMin > maxDistance) { free(prev); free(cur); return over; }
+            NSInteger *tmp = prev; prev = cur; cur = tmp;
+        }
+
+        NSInteger result = MIN(prev[m], over);
+        free(prev);
+        free(cur);
+        return result;
+    }
+
+    static double _tm_similarity(NSString *a, NSString *b, double minSimilarity) {
+
+        /// 1 - editDistance / length of the longer string, on the folded strings. 0 if it's below `minSimilarity`.
+
+        a = _searchIndex_fold(a);
+        b = _searchIndex_fold(b);
+        NSInteger n = a.length, m = b.length;
+        NSInteger longer = MAX(n, m);
+        if (!longer) return 1.0;
+
+        NSInteger maxDistance = (NSInteger)floor(longer * (1.0 - minSimilarity));
+        unichar *s = malloc(MAX(n, 1) * sizeof(unichar));
+        unichar *t = malloc(MAX(m, 1) * sizeof(unichar));
+        [a getCharacters: s range: NSMakeRange(0, n)];
+        [b getCharacters: t range: NSMakeRange(0, m)];
+        NSInteger d = _tm_editDistance(s, n, t, m, maxDistance);
+        free(s);
+        free(t);
+
+        return d > maxDistance ? 0 : 1.0 - (double)d / longer;
+    }
+
+    static NSComparisonResult _tm_compareSuggestions(TMSuggestion *x, TMSuggestion *y) {
+        if (x->similarity != y->similarity) return x->similarity > y->similarity ? NSOrderedAscending : NSOrderedDescending;
+        if (x->count      != y->count)      return x->count      > y->count      ? NSOrderedAscending : NSOrderedDescending;
+        return NSOrderedSame;
+    }
+
+#pragma mark - Interface
+
+TranslationMemory *TranslationMemory_Make(void) {
+    auto tm = [TranslationMemory new];
+    tm->queue = dispatch_queue_create("com.nuebling.mf-xcloc-editor.translation-memory", dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_UTILITY, 0));
+    tm->lock = MFLOCK_INIT;
+    tm->sources = [NSMutableArray new];
+    tm->targets = [NSMutableArray new];
+    tm->entriesForSource = [NSMutableDictionary new];
+    tm->bands = CFDictionaryCreateMutable(NULL, 0, NULL, NULL);
+    return tm;
+}
+
+void translationMemory_add(TranslationMemory *tm, NSString *source, NSString *target) {
+
+    /// Remembers that `source` was translated as `target`. Adding the same pair again just counts it. Any thread.
+
+    if (!isclass(source, NSString) || !source.length) return;
+    if (!isclass(target, NSString) || !target.length) return;
+
+    mflock(&tm->lock);
+    {
+        /// Same pair again?
+        NSMutableArray<NSNumber *> *entries = tm->entriesForSource[source];
+        for (NSNumber *e in entries) {
+            if ([tm->targets[e.integerValue] isEqual: target]) {
+                tm->counts[e.integerValue]++;
+                mfunlock(&tm->lock);
+                return;
+            }
+        }
+    }
+    mfunlock(&tm->lock);
+
+    TMSignature signature; /// Outside the lock – this is the slow part
+    _tm_makeSignature(source, &signature);
+
+    mflock(&tm->lock);
+    {
+        NSInteger e = tm->entryCount;
+        if (e == tm->_capacity) {
+            tm->_capacity = MAX(1024, tm->_capacity * 2);
+            tm->counts = realloc(tm->counts, tm->_capacity * sizeof(NSInteger));
+        }
+        tm->entryCount++;
+        [tm->sources addObject: source];
+        [tm->targets addObject: target];
+        tm->counts[e] = 1;
+
+        NSMutableArray<NSNumber *> *entries = tm->entriesForSource[source];
+        if (!entries) tm->entriesForSource[source] = entries = [NSMutableArray new];
+        [entries addObject: @(e)];
+
+        _tm_forEachBandKey(&signature, ^(uint64_t key) {
+            Postings *p = (Postings *)CFDictionaryGetValue(tm->bands, (void *)key);
+            if (!p) {
+                p = calloc(1, sizeof(Postings));
+                CFDictionarySetValue(tm->bands, (void *)key, p);
+            }
+            if (p->count == p->capacity) {
+                p->capacity = MAX(4, p->capacity * 2);
+                p->rows = realloc(p->rows, p->capacity * sizeof(int32_t));
+            }
+            p->rows[p->count++] = (int32_t)e;
+        });
+    }
+    mfunlock(&tm->lock);
+}
+
+void translationMemory_remove(TranslationMemory *tm, NSString *source, NSString *target) {
+
+    /// Counts `source` → `target` down once – a row doesn't have the pair anymore. Any thread.
+
+    if (!isclass(source, NSString) || !isclass(target, NSString)) return;
+
+    mflock(&tm->lock);
+    for (NSNumber *e in tm->entriesForSource[source]) {
+        if (![tm->targets[e.integerValue] isEqual: target]) continue;
+        if (tm->counts[e.integerValue] > 0) tm->counts[e.integerValue]--;
+        break;
+    }
+    mfunlock(&tm->lock);
+}
+
+void translationMemory_update(TranslationMemory *tm, NSString *source, NSString *_Nullable oldTarget, NSString *_Nullable newTarget) {
+
+    /// A row with `source` went from `oldTarget` to `newTarget` – either may be nil if the row wasn't / isn't translated. Returns right away; the work happens on `tm->queue`. [Oct 2026]
+
+    dispatch_async(tm->queue, ^{
+        @autoreleasepool {
+            if (oldTarget) translationMemory_remove(tm, source, oldTarget);
+            if (newTarget) translationMemory_add(tm, source, newTarget);
+        }
+    });
+}
+
+NSArray<TMSuggestion *> *translationMemory_suggest(TranslationMemory *tm, NSString *source, NSString *_Nullable currentTarget, NSInteger maxCount) {
+
+    /// Targets for `source`, best first – exact matches, then fuzzy ones above `kTMMinSimilarity`. One suggestion per distinct target.
+    ///     Leaves out `currentTarget` – suggesting what's already there doesn't help. Any thread.
+
+    if (!isclass(source, NSString) || !source.length) return @[];
+
+    TMSignature signature;
+    _tm_makeSignature(source, &signature);
+
+    auto exact      = [NSMutableArray<TMSuggestion *> new];
+    auto candidates = [NSMutableArray<TMSuggestion *> new];
+
+    mflock(&tm->lock);
+    {
+        /// Exact
+        for (NSNumber *e in tm->entriesForSource[source]) {
+            if (!tm->counts[e.integerValue]) continue; /// No row has it anymore
+            auto s = [TMSuggestion new];
+            s->source = source;
+            s->target = tm->targets[e.integerValue];
+            s->count = tm->counts[e.integerValue];
+            s->similarity = 1.0;
+            [exact addObject: s];
+        }
+
+        /// Fuzzy candidates
+        ///     Count the bands each entry shares with `source`. `touched` keeps this proportional to the number of hits, not to the size of the memory.
+        uint8_t *hits = calloc(MAX(tm->entryCount, 1), sizeof(uint8_t));
+        __block NSInteger touchedCount = 0;
+        __block NSInteger touchedCapacity = 256;
+        __block int32_t *touched = malloc(touchedCapacity * sizeof(int32_t));
+        _tm_forEachBandKey(&signature, ^(uint64_t key) {
+            Postings *p = (Postings *)CFDictionaryGetValue(tm->bands, (void *)key);
+            if (!p) return;
+            for (int32_t i = 0; i < p->count; i++) {
+                int32_t e = p->rows[i];
+                if (hits[e]++) continue;
+                if (touchedCount == touchedCapacity) {
+                    touchedCapacity *= 2;
+                    touched = realloc(touched, touchedCapacity * sizeof(int32_t));
+                }
+                touched[touchedCount++] = e;
+            }
+        });
+
+        /// Keep the entries that share the most bands
+        ///     Counting sort by hits – there are only `kTMHashCount / kTMBandRows` possible values.
+        for (int h = kTMHashCount / kTMBandRows; h > 0 && candidates.count < kTMMaxCandidates; h--) {
+            for (NSInteger i = 0; i < touchedCount && candidates.count < kTMMaxCandidates; i++) {
+                int32_t e = touched[i];
+                if (hits[e] != h) continue;
+                if (!tm->counts[e]) continue;
+                if ([tm->sources[e] isEqual: source]) continue; /// Already in `exact`
+                auto s = [TMSuggestion new];
+                s->source = tm->sources[e];
+                s->target = tm->targets[e];
+                s->count = tm->counts[e];
+                [candidates addObject: s];
+            }
+        }
+        free(hits);
+        free(touched);
+    }
+    mfunlock(&tm->lock);
+
+    /// Score
+    auto result = [NSMutableArray<TMSuggestion *> arrayWithArray: exact];
+    for (TMSuggestion *s in candidates) {
+        s->similarity = _tm_similarity(source, s->source, kTMMinSimilarity);
+        if (s->similarity >= kTMMinSimilarity) [result addObject: s];
+    }
+    [result sortUsingComparator: ^NSComparisonResult (TMSuggestion *x, TMSuggestion *y) { return _tm_compareSuggestions(x, y); }];
+
+    /// One per target
+    auto seenTargets = [NSMutableSet<NSString *> new];
+    if (isclass(currentTarget, NSString)) [seenTargets addObject: currentTarget];
+    auto deduped = [NSMutableArray<TMSuggestion *> new];
+    for (TMSuggestion *s in result) {
+        if ([seenTargets containsObject: s->target]) continue;
+        [seenTargets addObject: s->target];
+        [deduped addObject: s];
+        if ((NSInteger)deduped.count == maxCount) break;
+    }
+    return deduped;
+}
@@ -27,8 +27,35 @@
 
 #define arrcount(x...) (sizeof ((x)) / sizeof (x)[0])
         
-#define nowtime() (CACurrentMediaTime() * 1000.0) /// Timestamp in milliseconds
+#if !MF_HEADLESS
+    #define nowtime() (CACurrentMediaTime() * 1000.0) /// Timestamp in milliseconds
+#else
+    #define nowtime() ({ struct timespec _ts; clock_gettime(CLOCK_MONOTONIC, &_ts); _ts.tv_sec * 1000.0 + _ts.tv_nsec / 1e6; }) /// No QuartzCore in xcloc-tool – and `-[NSProcessInfo systemUptime]` isn't in every GNUstep. `bench` times its phases with this. [Oct 2026]
+#endif
         
+///
+/// Locks
+///
+
+/// `os_unfair_lock` on Apple platforms, `pthread_mutex_t` elsewhere – the model is also built on Linux (See `xcloc-tool/main.m`) [Oct 2026]
+///     Needs `<os/lock.h>` or `<pthread.h>` among the framework imports.
+#if __APPLE__
+    typedef os_unfair_lock mflock_t;
+    #define MFLOCK_INIT     OS_UNFAIR_LOCK_INIT
+    #define mflock(l)       os_unfair_lock_lock(l)
+    #define mfunlock(l)     os_unfair_lock_unlock(l)
+#else
+    typedef pthread_mutex_t mflock_t;
+    #define MFLOCK_INIT     ((pthread_mutex_t)PTHREAD_MUTEX_INITIALIZER)
+    #define mflock(l)       pthread_mutex_lock(l)
+    #define mfunlock(l)     pthread_mutex_unlock(l)
+#endif
+
+#if !__APPLE__ /// libdispatch on Linux takes QoS classes but doesn't name them – these are the values from Darwin's `<sys/qos.h>` [Oct 2026]
+    #define QOS_CLASS_USER_INITIATED    0x19
+    #define QOS_CLASS_UTILITY           0x11
+#endif
+
 #define mferror(domain, code_, msg_and_args...) \
     [NSError errorWithDomain: (domain) code: (code_) userInfo: @{ NSDebugDescriptionErrorKey: stringf(msg_and_args) }] /** Should we use `NSLocalizedFailureReasonErrorKey`? [Oct 2025] */
 
@@ -188,6 +215,7 @@ NSMutableDictionary<NSString *, NSXMLNode *> *xml_attrdict(NSXMLElement *_xmlEle
     return result;
 }
 
+#if __APPLE__ || !MF_HEADLESS /// NSFileWrapper is part of AppKit in GNUstep – and the model doesn't use these anymore (See `XclocPackage.m`) [Oct 2026]
 #pragma mark - Shorthands for horrible NSFileWrapper API
 
     void _fw_walk(NSFileWrapper *fileWrapper, void (^callback)(NSFileWrapper *subFileWrapper, NSString *subpath, BOOL *stop), NSMutableArray *currentKeyPath, BOOL *stop) {
@@ -267,7 +295,7 @@ NSMutableDictionary<NSString *, NSXMLNode *> *xml_attrdict(NSXMLElement *_xmlEle
         
         return result;
     }
-
+#endif
 
 NSArray<NSString *> *findPaths(int timeout_ms, NSString *dirPath, BOOL (^condition)(NSString *path)) {
     
@@ -292,6 +320,47 @@ NSArray<NSString *> *findPaths(int timeout_ms, NSString *dirPath, BOOL (^conditi
     return result;
 }
 
+BOOL writeFileAtomically(NSString *path, NSData *data, NSError *__autoreleasing _Nullable *outError) {
+
+    /// Writes `data` to a temp file next to `path`, fsyncs it, then `rename()`s it over `path`.
+    ///     Readers see either the old or the new file – never a half-written one. (`-[NSData writeToFile:atomically:]` does the same but doesn't fsync) [Oct 2026]
+
+    NSString *tempPath = stringf(@"%@.%@.tmp", path, NSUUID.UUID.UUIDString);
+
+    #define fail(msg...) ({ \
+        int _errno = errno; \
+        NSString *_msg = stringf(msg); \
+        if (fd != -1) close(fd); \
+        unlink(tempPath.fileSystemRepresentation); \
+        mflog(@"%@", _msg); \
+        if (outError) *outError = [NSError errorWithDomain: NSPOSIXErrorDomain code: _errno userInfo: @{ NSLocalizedDescriptionKey: _msg }]; \
+        return NO; \
+    })
+
+    int fd = open(tempPath.fileSystemRepresentation, O_WRONLY | O_CREAT | O_EXCL, 0644);
+    if (fd == -1) fail(@"Couldn't create temp file '%@' (%s)", tempPath, strerror(errno));
+
+    const char *bytes = data.bytes;
+    NSUInteger written = 0;
+    while (written < data.length) {
+        ssize_t n = write(fd, bytes + written, data.length - written);
+        if (n == -1 && errno == EINTR) continue;
+        if (n == -1) fail(@"Writing to '%@' failed (%s)", tempPath, strerror(errno));
+        written += n;
+    }
+    if (fsync(fd) == -1)  fail(@"fsync of '%@' failed (%s)", tempPath, strerror(errno));
+    if (close(fd) == -1) { fd = -1; fail(@"Closing '%@' failed (%s)", tempPath, strerror(errno)); }
+    fd = -1;
+
+    if (rename(tempPath.fileSystemRepresentation, path.fileSystemRepresentation) == -1)
+        fail(@"Renaming '%@' to '%@' failed (%s)", tempPath, path, strerror(errno));
+
+    #undef fail
+    return YES;
+}
+
+#if !MF_HEADLESS /// AppKit [Oct 2026]
+
 NSEvent *makeKeyDown(unichar keyEquivalent, int keyCode) {
     return [NSEvent
         keyEventWithType: NSEventTypeKeyDown
@@ -311,6 +380,8 @@ BOOL eventIsKey(NSEvent *event, unichar key) {
     return [stringf(@"%C", (unichar)key) isEqual: [event charactersIgnoringModifiers]];
 }
 
+#endif
+
 void runOnMain(double delay, void (^workload)(void)) {
     
     /// Delayed run on main for UI code [Oct 2025]
@@ -342,6 +413,8 @@ void mfdebounce(double delay, NSString *identifier, void (^block)(void)) {
     [[NSRunLoop mainRunLoop] addTimer: storage[identifier] forMode: NSRunLoopCommonModes];
 }
 
+#if !MF_HEADLESS /// AppKit [Oct 2026]
+
 struct mfanimate_args {
     NSTimeInterval duration;
     CAMediaTimingFunction *curve;
@@ -388,3 +461,5 @@ NSData *imageData(NSImage *image, NSBitmapImageFileType type, NSDictionary *prop
     return imageData;
 }
 
+#endif
+
@@ -0,0 +1,290 @@
+//
+//  Validator.m
+//  mf-xcloc-editor
+//
+//  Created by Noah Nübling on 10/17/26.
+//
+
+/// Checks the translations for mistakes that crash or garble the app at runtime [Oct 2026]
+///
+///     What we check:
+///         - The target uses the same format specifiers as the source (`%@`, `%d`, `%lld`, `%1$@`, `%#@var@`, ...) – with the same argument types at the same argument positions.
+///             A translation may reorder them with positional specifiers: `%@ has %d files` -> `%2$d Dateien hat %1$@` is fine.
+///         - Pluralizable variants (the `|==|` rows): Variants may leave out specifiers (`one` -> "One file"), but may only use ones that one of the source variants uses.
+///             And once one variant of a string is translated, all of them need a target.
+///     Rows that are `mf_dont_translate` and rows without a target aren't checked – those aren't translated yet, that's what the state column is for.
+///     Only the specifiers in `.strings`, `.stringsdict` and `.xcstrings` files are checked – IB and Info.plist strings are never formatted, so "100 % terminé" there is just text. (See `RowStore->fileHasFormatStrings`)
+///     A `%` followed by a space is taken literally ("50% off" isn't `% o`), unless the source uses the space flag itself.
+///
+///     Results are stored in the `RowStore` (`issues`, `issueCountByFile`):
+///         - `rowStore_validateAll()` checks all rows in parallel. Runs once in `rowStore_finish()`.
+///         - `rowStore_validateRow()` checks a row again after an edit, plus the rows whose result depends on it (its parent and sibling variants). Runs in `rowStore_setCellModel()`.
+///
+///     Specifiers are compared as (position, argument type) – the flags, width and precision don't matter at runtime. The length modifiers only matter as far as they change the size of the argument (`%d` vs `%ld`).
+
+#define kMFValidatorMaxSpecifiers 64    /// Per string. Any more are ignored.
+#define kMFValidatorChunkSize     1024  /// Rows per block in `rowStore_validateAll()`
+
+typedef struct {
+    int32_t position;   /// 1-based argument position
+    uint64_t type;      /// See `_validator_parse()`
+} MFSpecifier;
+
+#pragma mark - Parsing
+
+    static uint64_t _validator_typeOfConversion(unichar conversion, int lengthModifier) {
+
+        /// 0 for unknown conversions. Those aren't specifiers as far as NSString is concerned.
+        ///     lengthModifier: 0 = none/h/hh, 1 = l/ll/q/z/t/j (all 64 bit on our platforms), 2 = L
+
+        unichar c = 0;
+        switch (conversion) {
+            case 'd': case 'i': case 'u': case 'x': case 'X': case 'o': case 'c': case 'C': c = 'd'; break; /// Mixing these only changes how the number is printed
+            case 'D': case 'U': case 'O': c = 'd'; lengthModifier = 1; break;                           /// Deprecated synonyms of `%ld` etc.
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A': c = 'f'; lengthModifier = (lengthModifier == 2) ? 2 : 0; break; /// Floats are always promoted to double
+            case '@': case 's': case 'S': case 'p': case 'n': c = conversion; lengthModifier = 0; break;
+            default: return 0;
+        }
+        return ((uint64_t)lengthModifier << 16) | c;
+    }
+
+    static NSInteger _validator_parse(NSString *string, bool spaceIsLiteral, MFSpecifier *out, NSInteger capacity, bool *_Nullable outUsesSpaceFlag) {
+
+        /// Fills `out` with the specifiers of a format string, in order. Returns how many there are (at most `capacity`).
+        ///     Like `-[NSString stringWithFormat:]`, a `*` width or precision takes up an argument, too.
+        ///     `%#@var@` gets a type derived from the name, so renaming `var` is a mismatch.
+        ///     `spaceIsLiteral`: Skip a `%` that's followed by the space flag, like the one in "50% off". `outUsesSpaceFlag` is set if a specifier used it anyway.
+
+        NSInteger length = string.length;
+        if (!length || capacity <= 0) return 0;
+
+        /// Get the characters
+        ///     Most strings have no `%` at all – check that first without copying anything.
+        if ([string rangeOfString: @"%" options: NSLiteralSearch].location == NSNotFound) return 0;
+        unichar stackBuffer[512];
+        unichar *chars = length <= 512 ? stackBuffer : malloc(length * sizeof(unichar));
+        [string getCharacters: chars range: NSMakeRange(0, length)];
+
+        NSInteger count = 0;
+        int32_t nextPosition = 1;
+        #define emit(pos, t) ({ if (count < capacity) out[count++] = (MFSpecifier){ (pos), (t) }; })
+        #define isdigit_(ch) ('0' <= (ch) && (ch) <= '9')
+
+        for (NSInteger i = 0; i < length; i++) {
+            if (chars[i] != '%') continue;
+            NSInteger j = i + 1;
+            if (j >= length) break;
+            if (chars[j] == '%') { i = j; continue; } /// Literal %
+
+            /// Position
+            int32_t position = 0;
+            {
+                NSInteger k = j; int32_t n = 0;
+                while (k < length && isdigit_(chars[k]) && n < 10000) n = n * 10 + (chars[k++] - '0');
+                if (k < length && chars[k] == '$' && k > j && n > 0) { position = n; j = k + 1; }
+            }
+
+            /// `%#@var@`
+            if (j + 1 < length && chars[j] == '#' && chars[j + 1] == '@') {
+                NSInteger k = j + 2;
+                uint64_t hash = 14695981039346656037ULL; /// FNV-1a of the name
+                while (k < length && chars[k] != '@') { hash = (hash ^ chars[k]) * 1099511628211ULL; k++; }
+                if (k < length) {
+                    emit(position ?: nextPosition++, hash | (1ULL << 63));
+                    i = k;
+                    continue;
+                }
+            }
+
+            /// Flags
+            bool hasSpaceFlag = false;
+            while (j < length && (chars[j] == '-' || chars[j] == '+' || chars[j] == ' ' || chars[j] == '#' || chars[j] == '0' || chars[j] == '\'')) hasSpaceFlag |= chars[j++] == ' ';
+            if (hasSpaceFlag && spaceIsLiteral) continue;
+            /// Width
+            if (j < length && chars[j] == '*') { emit(nextPosition, _validator_typeOfConversion('d', 0)); nextPosition++; j++; }
+            else while (j < length && isdigit_(chars[j])) j++;
+            /// Precision
+            if (j < length && chars[j] == '.') {
+                j++;
+                if (j < length && chars[j] == '*') { emit(nextPosition, _validator_typeOfConversion('d', 0)); nextPosition++; j++; }
+                else while (j < length && isdigit_(chars[j])) j++;
+            }
+            /// Length modifier
+            int lengthModifier = 0;
+            while (j < length) {
+                unichar ch = chars[j];
+                if ((0)) {}
+                else if (ch == 'h')                                                 {}
+                else if (ch == 'l' || ch == 'q' || ch == 'z' || ch == 't' || ch == 'j') lengthModifier = 1;
+                else if (ch == 'L')                                                 lengthModifier = 2;
+                else break;
+                j++;
+            }
+            /// Conversion
+            if (j >= length) break;
+            uint64_t type = _validator_typeOfConversion(chars[j], lengthModifier);
+            if (!type) continue; /// Not a specifier (e.g. the `%!` in "50%!")
+            if (hasSpaceFlag && outUsesSpaceFlag) *outUsesSpaceFlag = true;
+            emit(position ?: nextPosition++, type);
+            i = j;
+        }
+
+        #undef emit
+        #undef isdigit_
+        if (chars != stackBuffer) free(chars);
+        return count;
+    }
+
+    static bool _validator_isPluralVariable(uint64_t type) { return type >> 63; }
+
+#pragma mark - Checking
+
+    static MFRowIssue _validator_compare(MFSpecifier *expected, NSInteger expectedCount, MFSpecifier *actual, NSInteger actualCount, bool allowMissing) {
+
+        /// Compares by position. Strings have a handful of specifiers at most, so quadratic is fine.
+
+        MFRowIssue result = MFRowIssue_None;
+
+        for (NSInteger a = 0; a < actualCount; a++) {
+            bool samePosition = false, sameType = false;
+            for (NSInteger e = 0; e < expectedCount; e++) {
+                if (expected[e].position != actual[a].position) continue;
+                samePosition = true;
+                if (expected[e].type == actual[a].type) sameType = true;
+            }
+            if ((0)) {}
+            else if (!samePosition) result |= _validator_isPluralVariable(actual[a].type) ? MFRowIssue_PluralVariable : MFRowIssue_ExtraSpecifier;
+            else if (!sameType)     result |= _validator_isPluralVariable(actual[a].type) ? MFRowIssue_PluralVariable : MFRowIssue_MismatchedSpecifier;
+        }
+
+        if (!allowMissing) {
+            for (NSInteger e = 0; e < expectedCount; e++) {
+                bool found = false;
+                for (NSInteger a = 0; a < actualCount && !found; a++) found = expected[e].position == actual[a].position;
+                if (!found) result |= _validator_isPluralVariable(expected[e].type) ? MFRowIssue_PluralVariable : MFRowIssue_MissingSpecifier;
+            }
+        }
+
+        return result;
+    }
+
+    static NSArray<NSNumber *> *_validator_siblingRows(RowStore *store, NSInteger row) {
+        /// Rows of all the variants of the row's parent – including the row itself.
+        auto result = [NSMutableArray<NSNumber *> new];
+        for (NSXMLElement *child in store->children[store->parentRow[row]]) {
+            NSInteger childRow;
+            if (rowStore_lookup(child, &childRow)) [result addObject: @(childRow)];
+        }
+        return result;
+    }
+
+    static MFRowIssue _validator_check(RowStore *store, NSInteger row) {
+
+        /// Only reads the store – safe to call on many rows at once, as long as nobody edits it.
+
+        if (store->states[row] == MFTransUnitState_DontTranslate) return MFRowIssue_None;
+
+        NSString *target = store->targets[row];
+        bool isVariant = store->parentRow[row] != -1;
+
+        if (!target.length) {
+            if (!isVariant) return MFRowIssue_None;
+            for (NSNumber *sibling in _validator_siblingRows(store, row))
+                if ([store->targets[sibling.integerValue] length]) return MFRowIssue_EmptyVariant;
+            return MFRowIssue_None;
+        }
+
+        if (!store->fileHasFormatStrings[store->fileIndexes[row]]) return MFRowIssue_None;
+        if (isVariant && [target rangeOfString: @"%" options: NSLiteralSearch].location == NSNotFound) return MFRowIssue_None; /// Variants may leave out specifiers – no need to look at the sources
+
+        MFSpecifier expected[kMFValidatorMaxSpecifiers];
+        NSInteger expectedCount = 0;
+        bool sourceUsesSpaceFlag = false;
+        if (!isVariant)
+            expectedCount = _validator_parse(store->sources[row], false, expected, kMFValidatorMaxSpecifiers, &sourceUsesSpaceFlag);
+        else
+            for (NSNumber *sibling in _validator_siblingRows(store, row))
+                expectedCount += _validator_parse(store->sources[sibling.integerValue], false, expected + expectedCount, kMFValidatorMaxSpecifiers - expectedCount, &sourceUsesSpaceFlag);
+
+        MFSpecifier actual[kMFValidatorMaxSpecifiers];
+        NSInteger actualCount = _validator_parse(target, !sourceUsesSpaceFlag, actual, kMFValidatorMaxSpecifiers, NULL);
+
+        return _validator_compare(expected, expectedCount, actual, actualCount, isVariant); /// Variants may leave out specifiers
+    }
+
+#pragma mark - Interface
+
+void rowStore_validateAll(RowStore *store) {
+
+    /// Fills `issues` and `issueCountByFile`. Synchronous – but checks the rows on all cores, so nothing may edit the store while it runs.
+
+    CFAbsoluteTime t0 = CFAbsoluteTimeGetCurrent();
+
+    NSInteger n = store->count;
+    free(store->issues);
+    free(store->issueCountByFile);
+    store->issues           = calloc(MAX(1, n), sizeof(MFRowIssue));
+    store->issueCountByFile = calloc(MAX(1, store->fileCount), sizeof(NSInteger));
+    store->issueCount       = 0;
+
+    MFRowIssue *issues = store->issues;
+    NSInteger chunkCount = (n + kMFValidatorChunkSize - 1) / kMFValidatorChunkSize;
+    dispatch_apply(chunkCount, DISPATCH_APPLY_AUTO, ^(size_t chunk) {
+        @autoreleasepool {
+            NSInteger end = MIN(n, (NSInteger)(chunk + 1) * kMFValidatorChunkSize);
+            for (NSInteger row = chunk * kMFValidatorChunkSize; row < end; row++)
+                issues[row] = _validator_check(store, row); /// Each block writes its own rows
+        }
+    });
+
+    for (NSInteger row = 0; row < n; row++) {
+        if (!issues[row]) continue;
+        store->issueCountByFile[store->fileIndexes[row]]++;
+        store->issueCount++;
+    }
+
+    mflog(@"Validated %ld rows in %.2f ms – %ld with issues", n, (CFAbsoluteTimeGetCurrent() - t0) * 1000, store->issueCount);
+}
+
+void rowStore_validateRow(RowStore *store, NSInteger row) {
+
+    /// Checks a row again after its target or state changed. On the thread that edits the store.
+    ///     Also checks its parent and its sibling variants – whether a variant may be empty depends on its siblings.
+
+    if (!store->issues) return; /// Not validated yet
+
+    NSArray<NSNumber *> *rows = store->parentRow[row] == -1 ? @[@(row)] : [_validator_siblingRows(store, row) arrayByAddingObject: @(store->parentRow[row])];
+    for (NSNumber *r in rows) {
+        NSInteger i = r.integerValue;
+        MFRowIssue newIssues = _validator_check(store, i);
+        NSInteger delta = (NSInteger)(newIssues != 0) - (NSInteger)(store->issues[i] != 0);
+        store->issueCountByFile[store->fileIndexes[i]] += delta;
+        store->issueCount += delta;
+        store->issues[i] = newIssues;
+    }
+}
+
+MFRowIssue rowStore_getIssues(RowStore *store, NSInteger row) {
+
+    /// Issues of the row – for plural parents including the ones of their variants, since those are shown under them.
+
+    if (!store->issues) return MFRowIssue_None;
+    MFRowIssue result = store->issues[row];
+    if (store->isPluralParent[row]) {
+        for (NSXMLElement *child in store->children[row]) {
+            NSInteger childRow;
+            if (rowStore_lookup(child, &childRow)) result |= store->issues[childRow];
+        }
+    }
+    return result;
+}
+
+NSInteger rowStore_getIssueCount(RowStore *store, NSInteger fileIndex) {
+
+    /// Rows with issues. Pass -1 for all files. O(1)
+
+    if (!store->issueCountByFile) return 0;
+    if (fileIndex == -1) return store->issueCount;
+    assert(0 <= fileIndex && fileIndex < store->fileCount);
+    return store->issueCountByFile[fileIndex];
+}
@@ -9,16 +9,22 @@
         - (void)_setShowAutosaveButton: (BOOL)flag;
     @end
 
+    @class Xliff;
+    @class ScreenshotCache;
+
     @interface XclocDocument : NSDocument
 
         {
             @public
             XclocWindowController *ctrl;
-            NSXMLDocument *_xliffDoc;
+            Xliff *_xliff;
             NSArray *_localizedStringsDataPlist; /// Plist mapping localizedStrings to screenshots [Oct 2025]
+            NSDictionary<NSString *, NSArray<NSDictionary *> *> *_screenshotIndex; /// `_localizedStringsDataPlist` by stringKey (See `ScreenshotIndex_Make()`) [Oct 2026]
+            ScreenshotCache *_screenshotCache;  /// Created on first use – Needs the fileURL (See `getScreenshotCache()`) [Oct 2026]
         }
         
         - (void) writeTranslationDataToFile;
+        - (void) flushJournalSynchronously;
 
     @end
 
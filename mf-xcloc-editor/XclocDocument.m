@@ -16,7 +16,23 @@
 #define kMFTypeName_Xcloc @"com.apple.xcode.xcloc"
 
 @interface XclocDocument ()
-    @property NSFileWrapper *storedXclocFileWrapper;
+    {
+        /// Journaled saving (See `EditJournal.m`) [Oct 2026]
+        EditJournal *_journal;                  /// nil if the xliff can't be saved by splicing – then every edit goes through `saveDocument:` like before
+        dispatch_queue_t _flushQueue;           /// Serial – flushes land on disk in order
+        NSInteger _unflushedEditCount;          /// Committed edits that are only in the journal
+        BOOL _isFlushing;
+        BOOL _needsAnotherFlush;
+        
+        NSString *_xliffSubpath;                /// Where the xliff is inside the package (See `XclocPackage.m`). We don't keep a file wrapper of the package anymore – it held on to every screenshot. [Oct 2026]
+        
+        /// Watching the xliff for changes by other apps (See `XliffMerge.m`) [Oct 2026]
+        dispatch_source_t _xliffWatcher;
+        BOOL _isMergingFromDisk;                /// No flushes while this is set – they'd move the base of the merge
+        NSInteger _watchRetryCount;             /// While the xliff is missing after an atomic replace
+        struct stat _knownXliffStat;            /// The xliff as of our last write or merge – events for a file that still matches are our own and get skipped without reading it. Zeroed if unknown.
+        BOOL _isClosed;
+    }
 @end
 
 @implementation XclocDocument
@@ -40,9 +56,28 @@
     
     #define useNativeSaving 0 /// Note: If we activate this, we should add back the default menu items like `Save`, maybe 'Revert to Version...' etc. [Oct 2025]
     
+    #define kMFFlushEditCount   50  /// Rewrite the xliff after this many edits...
+    #define kMFFlushDelay       5.0 /// ...or this many seconds after the first unflushed edit – whichever comes first. [Oct 2026]
+    
     - (void) writeTranslationDataToFile {
         /// Our code calls this whenever an edit is made
         if (!useNativeSaving) {
+            
+            if (self->_journal) {
+                
+                /// Commit the edit to the journal
+                ///     `rowStore_setCellModel()` has already appended it – this makes it durable. The xliff is rewritten later, in the background. [Oct 2026]
+                {
+                    mftrace_scope("save.journal");
+                    editJournal_sync(self->_journal);
+                }
+                [self updateChangeCount: NSChangeCleared]; /// The edit is safe on disk – don't let NSDocument autosave the whole package on its own.
+                
+                self->_unflushedEditCount++;
+                if      (self->_unflushedEditCount >= kMFFlushEditCount) [self flushJournal];
+                else if (self->_unflushedEditCount == 1)                  runOnMain(kMFFlushDelay, ^{ [self flushJournal]; });
+                return;
+            }
         
             static int savesThisRunLoop = 0;
             runOnMain(0.0, ^{
@@ -52,18 +87,169 @@
             mfdebounce(0.0, @"writeTranslationDataToFile", ^{
                 /// HACK: Only do this once per runLoop to prevent strange freezing bug. It seems when you save twice in one runLoop, then some internal API in NSDocument infinitely waits on some semaphore or something. After you've successfully saved once, this isn't necessary anymore. I guess the API gets initialized or something. This currently happens when editing a translation and then hitting Command-R. Observed on macOS 26 Tahoe [Nov 2025]
                 /// Update: TODO: oh no, just saw the freeze again, after using the program for a while (and saving a few times) `[_NSDocumentSerializationSemaphore wait]` hangs forever ... I can't reproduce it though.
+                ///     Update: Only reached when there's no journal anymore (the xliff couldn't be streamed, or the journal couldn't be opened) – otherwise we don't go through NSDocument for saving at all. [Oct 2026]
                 /// Old TODO notes about the original Command-R bug:
                 ///     Fix freeze when changing text and then hitting Command-R
                 ///         Can currently reproduce on all commits back to 987de9cec3653933a7824442a92303a33a495bdb
                 ///         (Document saving endlessly waits on some internal semaphore)
-                ///         (This only happens if the *first* save after opening the doc is Command-R after having changed text (but not committed, yet) – super weird)
+                ///         (This only happens if the *first* save after opening the doc is Command-R after having changed text (but not committed, yet) – super weird)
                 ///         [Nov 2025]
+                if ([self writeXliffInPlace]) return; /// Skips NSDocument entirely in the common case [Oct 2026]
                 [self saveDocument: nil];
                 savesThisRunLoop++;
                 mflog(@"Save no %d during this runLoop iteration", savesThisRunLoop); /// Check that the debouncing works [Nov 2025]
             });
         }
     }
+    
+    - (void) flushJournal {
+        
+        /// Writes all committed edits into the xliff, then empties the journal. [Oct 2026]
+        ///     The splicing happens here on main since it reads the `RowStore` – it's only string work for the edited rows plus a memcpy. The file write + fsync happens on `_flushQueue`.
+        
+        if (!self->_journal || !self->_unflushedEditCount) return;
+        mftrace_scope("save.flushJournal");
+        if (self->_isFlushing || self->_isMergingFromDisk) { /// One at a time. The running flush (or merge) will start another one when it's done.
+            self->_needsAnotherFlush = YES;
+            return;
+        }
+        
+        NSData *xliffData = xliff_spliceEdits(self->_xliff);
+        if (!xliffData) {
+            mflog(@"Couldn't splice the edits – falling back to saveDocument:");
+            [self saveDocument: nil];
+            return;
+        }
+        
+        EditJournal *journal = self->_journal;
+        NSUInteger flushedJournalLength = self->_journal->length;
+        NSInteger flushedEditCount = self->_unflushedEditCount;
+        NSString *xliffSubpath = self->_xliffSubpath;
+        NSURL *xliffURL = [self.fileURL URLByAppendingPathComponent: xliffSubpath];
+        
+        self->_unflushedEditCount = 0;
+        self->_isFlushing = YES;
+        
+        dispatch_async(self->_flushQueue, ^{
+            
+            NSError *err = nil;
+            BOOL didWrite = [self _writeXliffData: xliffData toURL: xliffURL error: &err];
+            
+            dispatch_async(dispatch_get_main_queue(), ^{
+                
+                self->_isFlushing = NO;
+                if (self->_journal != journal) return; /// Document was closed or reverted in the meantime – `flushJournalSynchronously` or the replay took care of everything
+                
+                if (didWrite) {
+                    [self _didWriteXliffData: xliffData subpath: xliffSubpath];
+                    editJournal_truncate(self->_journal, flushedJournalLength);
+                }
+                else {
+                    mflog(@"Flushing %ld edits failed with error: %@ – They're still in the journal, retrying in %.0f s", flushedEditCount, err, kMFFlushDelay);
+                    BOOL isArmed = self->_unflushedEditCount > 0; /// An edit came in while we were writing – its timer retries for us
+                    self->_unflushedEditCount += flushedEditCount; /// The rows are still unsaved (See `xliff_didWrite()`), so the retry writes them again.
+                    if (!isArmed) runOnMain(kMFFlushDelay, ^{ [self flushJournal]; });
+                }
+                
+                if (self->_needsAnotherFlush) {
+                    self->_needsAnotherFlush = NO;
+                    [self flushJournal];
+                }
+            });
+        });
+    }
+    
+    - (void) flushJournalSynchronously {
+        
+        /// Call before the document goes away. Afterwards everything is in the xliff and the journal is deleted. (Unless writing failed – then the journal stays and gets replayed on the next open.) [Oct 2026]
+        
+        if (!self->_journal) return;
+        
+        dispatch_sync(self->_flushQueue, ^{}); /// Wait for a running flush
+        
+        NSData *xliffData = xliff_spliceEdits(self->_xliff); /// Returns the current bytes even if there are no unsaved rows. Includes the edits of a flush whose result hasn't reached main yet – they're unsaved until then.
+        NSString *xliffSubpath = self->_xliffSubpath;
+        NSError *err = nil;
+        if (xliffData && [self _writeXliffData: xliffData toURL: [self.fileURL URLByAppendingPathComponent: xliffSubpath] error: &err]) {
+            [self _didWriteXliffData: xliffData subpath: xliffSubpath];
+            editJournal_remove(self->_journal);
+        }
+        else {
+            mflog(@"Final flush failed with error: %@ – Keeping the journal at %@", err, self->_journal->path);
+        }
+        
+        self->_xliff->rowStore->journal = nil;
+        self->_journal = nil;
+        self->_unflushedEditCount = 0;
+    }
+    
+    - (void) close {
+        self->_isClosed = YES;
+        [self stopWatchingXliff];
+        [self flushJournalSynchronously];
+        [super close];
+    }
+    
+    - (BOOL) writeXliffInPlace {
+        
+        /// Writes the edits straight into the .xliff inside the .xcloc, instead of going through `saveDocument:` -> `fileWrapperOfType:`, which rewrites the whole xliff through NSDocument.
+        ///     Only the edited `<target>`s are re-encoded (See `xliff_spliceEdits()`), and the file is replaced atomically, so a crash can't leave a half-written xliff behind.
+        ///     Returns NO if the xliff doesn't support this – then the caller should use `saveDocument:` [Oct 2026]
+        
+        if (!self.fileURL) return NO;
+        
+        mftrace_scope("save.writeXliffInPlace");
+        
+        NSData *xliffData = xliff_spliceEdits(self->_xliff);
+        if (!xliffData) return NO;
+        
+        NSString *xliffSubpath = self->_xliffSubpath;
+        NSError *err = nil;
+        if (![self _writeXliffData: xliffData toURL: [self.fileURL URLByAppendingPathComponent: xliffSubpath] error: &err]) {
+            mflog(@"Writing the xliff in place failed with error: %@", err);
+            return NO; /// The rows are still unsaved, so `saveDocument:` will still write them.
+        }
+        [self _didWriteXliffData: xliffData subpath: xliffSubpath];
+        
+        return YES;
+    }
+    
+    - (BOOL) _writeXliffData: (NSData *)xliffData toURL: (NSURL *)xliffURL error: (NSError *__autoreleasing _Nullable *)outError {
+        
+        /// Thread-safe. Doesn't touch any state of the document.
+        
+        __block BOOL didWrite = NO;
+        __block NSError *writeErr = nil;
+        NSError *coordinationErr = nil;
+        [[[NSFileCoordinator alloc] initWithFilePresenter: self] /// Passing `self` so NSDocument isn't told about its own write
+            coordinateWritingItemAtURL: xliffURL
+            options: NSFileCoordinatorWritingForReplacing
+            error: &coordinationErr
+            byAccessor: ^(NSURL *url) {
+                didWrite = writeFileAtomically(url.path, xliffData, &writeErr);
+            }];
+        
+        if (!didWrite && outError) *outError = writeErr ?: coordinationErr;
+        return didWrite;
+    }
+    
+    - (void) _didWriteXliffData: (NSData *)xliffData subpath: (NSString *)xliffSubpath {
+        
+        /// The next splice starts from the bytes that are on disk now
+        xliff_didWrite(self->_xliff, xliffData);
+        
+        /// Remember the file we wrote, so the watcher can tell our own write apart from another app's (See `mergeXliffFromDisk`)
+        [self _rememberXliffStat: [self.fileURL.path stringByAppendingPathComponent: xliffSubpath]];
+        
+        /// Keep NSDocument in the loop
+        ///     Otherwise it thinks the file was changed by another app, and the next `saveDocument:` would complain.
+        
+        self.fileModificationDate = [[NSFileManager defaultManager] attributesOfItemAtPath: self.fileURL.path error: nil][NSFileModificationDate];
+        [self updateChangeCount: NSChangeCleared];
+        
+        mflog(@"Wrote %lu bytes to %@", xliffData.length, xliffSubpath);
+    }
+    
     #if !useNativeSaving
         - (void)_updateDocumentEditedAndAnimate:(BOOL)flag {
             /// Turn off 'Edited' label flashing (since we just automatically save on every edit the user makes) – Doesn't work [Oct 2025]
@@ -89,7 +275,14 @@
 
 #pragma mark - Read & Write
 
-    - (BOOL) readFromFileWrapper: (NSFileWrapper *)xclocWrapper ofType: (NSString *)typeName error: (NSError *__autoreleasing  _Nullable *)outError {
+    #define useStreamingLoader 1 /// Set to 0 to always load through NSXMLDocument. (See `Xliff.m`) [Oct 2026]
+
+    - (BOOL) readFromURL: (NSURL *)url ofType: (NSString *)typeName error: (NSError *__autoreleasing  _Nullable *)outError {
+        
+        /// Reads just the xliff and the screenshot plist out of the package. Also called when reverting.
+        ///     Used to be `readFromFileWrapper:`, which NSDocument calls after loading the whole package into an NSFileWrapper – screenshots, asset catalogs and all. (See `XclocPackage.m`) [Oct 2026]
+        
+        mftrace_scope("load.readFromURL"); /// Usually on a background thread
         
         #define fail(msg...) ({ \
             mflog(msg); \
@@ -98,51 +291,69 @@
             return NO; \
         })
         
+        NSString *xclocPath = url.path;
         NSError *err = nil;
         
         {
             /// Load xliff
-            NSXMLDocument *doc = nil;
+            Xliff *xliff = nil;
+            NSString *xliffSubpath = XclocPackage_XliffSubpath(xclocPath);
             {
+                if (!xliffSubpath) fail(@"Couldn't find an .xliff file in '%@'", xclocPath);
                 
-                auto xliffWrapper = fw_readPath(xclocWrapper, fw_getXliffPath(xclocWrapper));
-                doc = [[NSXMLDocument alloc] initWithData:  xliffWrapper.regularFileContents options: NSXMLNodeOptionsNone error: &err];
-                if (err) fail(@"Loading XMLDocument from wrapper '%@' failed with error: '%@'", xliffWrapper, err);
+                NSString *xliffPath = [xclocPath stringByAppendingPathComponent: xliffSubpath];
+                NSData *xliffData = XclocPackage_MapFile(xliffPath, &err);
+                if (!xliffData) fail(@"Reading '%@' failed with error: '%@'", xliffPath, err);
                 
-                mflog(@"Loaded xliff from fileWrapper %@", xliffWrapper.filename);
+                xliff = XclocProject_TakePreloaded(xliffPath, xliffData); /// If it was opened together with the rest of the project (See `XclocProject.m`)
+                if (!xliff && useStreamingLoader) {
+                    StringTable *strings = StringTable_ForProject(xclocPath.stringByDeletingLastPathComponent); /// Share strings with the other open languages of the project
+                    xliff = Xliff_Stream(xliffData, strings, &err);
+                    if (xliff) xliff_copyMappedData(xliff);
+                    else       mflog(@"Streaming xliff '%@' failed with error: '%@' – Falling back to NSXMLDocument", xliffPath, err);
+                    err = nil;
+                }
+                if (!xliff) {
+                    NSXMLDocument *doc = [[NSXMLDocument alloc] initWithData: xliffData options: NSXMLNodeOptionsNone error: &err];
+                    if (err) fail(@"Loading XMLDocument from '%@' failed with error: '%@'", xliffPath, err);
+                    xliff = Xliff_FromDocument(doc);
+                }
+                
+                mflog(@"Loaded xliff %@", xliffSubpath);
             }
             
             /// Load localizedStringData.plist
             NSArray *localizedStringsDataPlist = nil;
             {
-                auto stringsDataPaths = fw_findPaths(xclocWrapper, ^BOOL (NSFileWrapper *w, NSString *p, BOOL *stop) {
-                    if ([p hasSuffix: @"localizedStringData.plist"]) {
-                        *stop = YES;
-                        return YES;
-                    }
-                    return NO;
-                });
+                NSString *stringsDataSubpath = XclocPackage_StringsDataPlistSubpath(xclocPath);
                 
-                if (stringsDataPaths.count) { /// .xloc files with no screenshots don't have `localizedStringData.plist` [Oct 2025]
+                if (stringsDataSubpath) { /// .xloc files with no screenshots don't have `localizedStringData.plist` [Oct 2025]
+                    
+                    NSData *plistData = [NSData dataWithContentsOfFile: [xclocPath stringByAppendingPathComponent: stringsDataSubpath] options: 0 error: &err];
+                    if (!plistData) fail(@"Reading localizedStringsData.plist failed with error: %@", err);
                     
                     localizedStringsDataPlist = [NSPropertyListSerialization
-                        propertyListWithData: fw_readPath(xclocWrapper, stringsDataPaths[0]).regularFileContents
+                        propertyListWithData: plistData
                         options: 0
                         format: NULL
                         error: &err
                     ];
-                    if (err) fail(@"Loading localizedStringsData.plist from fileWrapper failed with error: %@", err);
+                    if (err) fail(@"Loading localizedStringsData.plist failed with error: %@", err);
                     
-                    mflog(@"Loaded localizedStringsData.plist from fileWrapper: %@", xclocWrapper);
+                    mflog(@"Loaded localizedStringsData.plist %@", stringsDataSubpath);
                 }
             }
             
+            /// Collate the ids
+            ///     The table is sorted by @"id" by default – doing this here, while we're reading in the background, makes the first sort instant. (See `SortKeys.m`) [Oct 2026]
+            if (!NSThread.isMainThread) rowStore_prebuildSortKeys(xliff->rowStore, @"id");
+            
             /// Store deserialized data
-            self->_xliffDoc = doc;
+            self->_xliff = xliff;
+            self->_xliffSubpath = xliffSubpath;
             self->_localizedStringsDataPlist = localizedStringsDataPlist;
-            
-            /// Store the xcloc fileWrapper directly (Used in `fileWrapperOfType:`) [Oct 2025]
-            self->_storedXclocFileWrapper = xclocWrapper;
+            self->_screenshotIndex = ScreenshotIndex_Make(localizedStringsDataPlist);
+            self->_screenshotCache = nil; /// The screenshots may have changed, e.g. on revert [Oct 2026]
             
             /// Update the UI
             if (self->ctrl) {
@@ -150,18 +361,131 @@
             }
         }
         
+        [self openJournalForURL: url];
+        
+        return YES;
+        #undef fail
+    }
+    
+    - (void) openJournalForURL: (NSURL *)url {
+        
+        /// Replays a journal left behind by a crash, then starts journaling. (See `EditJournal.m`) [Oct 2026]
+        
+        if (self->_journal) { /// Reverting – e.g. when the xliff changed on disk and couldn't be merged (See `_applyXliffFromDisk:`)
+            ///     Keep the journal: It still has the edits that weren't flushed yet, or whose flush failed. They're replayed onto the new contents below – except where the file changed the same cell.
+            dispatch_sync(self->_flushQueue, ^{});
+            editJournal_close(self->_journal);
+            self->_journal = nil;
+            self->_unflushedEditCount = 0;
+        }
+        
+        if (!xliff_canSpliceEdits(self->_xliff)) {
+            mflog(@"xliff can't be saved by splicing – not journaling");
+            return;
+        }
+        
+        NSString *journalPath = EditJournal_PathForDocument(url);
+        
+        /// Replay
+        NSInteger replayedCount = 0;
+        {
+            RowStore *store = self->_xliff->rowStore;
+            for (NSDictionary *entry in EditJournal_Read(journalPath)) {
+                
+                #define unnull(x) ({ id _x = (x); _x == [NSNull null] ? nil : _x; })
+                NSString *columnID = entry[@"column"];
+                NSString *oldValue = unnull(entry[@"old"]);
+                NSString *newValue = unnull(entry[@"new"]);
+                #undef unnull
+                
+                NSUInteger fileIndex = [self->_xliff->filePaths indexOfObject: entry[@"file"]];
+                NSNumber *row = fileIndex == NSNotFound ? nil : store->rowForID[fileIndex][entry[@"id"]];
+                if (!row || !([columnID isEqual: @"target"] || [columnID isEqual: @"state"])) {
+                    mflog(@"Skipping journal entry for unknown transUnit: %@", entry);
+                    continue;
+                }
+                
+                /// Only apply on top of what the entry was recorded against. (Or if it's already applied – the journal is only emptied after a flush.)
+                ///     Anything else means the xliff was changed outside the app, and we don't wanna clobber that.
+                NSString *currentValue = rowStore_getCellModel(store, row.integerValue, columnID);
+                BOOL isAsRecorded = (currentValue == oldValue || [currentValue isEqual: oldValue]);
+                BOOL isApplied    = (currentValue == newValue || [currentValue isEqual: newValue] || (!newValue && [columnID isEqual: @"state"] && [currentValue isEqual: kMFTransUnitState_New])); /// nil state = attribute removed, reads as `new` (See `_rowModel_getStateForUndo()`)
+                if (!isAsRecorded && !isApplied) {
+                    mflog(@"Skipping journal entry that conflicts with the file's current value '%@': %@", currentValue, entry);
+                    continue;
+                }
+                if (isApplied) continue;
+                
+                _rowModel_setCellModel(store->transUnits[row.integerValue], columnID, newValue);
+                replayedCount++;
+            }
+            if (replayedCount) mflog(@"Replayed %ld edits from journal at %@", replayedCount, journalPath);
+        }
+        
+        /// Start journaling
+        NSError *err = nil;
+        self->_journal = EditJournal_Open(journalPath, self->_xliff->filePaths, &err);
+        if (!self->_journal) {
+            mflog(@"Couldn't open journal: %@ – saving through NSDocument", err);
+            if (replayedCount) runOnMain(0.0, ^{ [self writeTranslationDataToFile]; });
+            return;
+        }
+        self->_xliff->rowStore->journal = self->_journal;
+        if (!self->_flushQueue) self->_flushQueue = dispatch_queue_create("com.nuebling.mf-xcloc-editor.flush", DISPATCH_QUEUE_SERIAL);
+        
+        /// Write the replayed edits into the xliff
+        ///     Deferred so `self.fileURL` is set.
+        if (replayedCount) {
+            self->_unflushedEditCount = replayedCount;
+            runOnMain(0.0, ^{ [self flushJournal]; });
+        }
+    }
+    
+    - (BOOL) writeSafelyToURL: (NSURL *)url ofType: (NSString *)typeName forSaveOperation: (NSSaveOperationType)saveOperation error: (NSError *__autoreleasing  _Nullable *)outError {
+        
+        /// Saving in place only replaces the xliff – the rest of the package never changes. [Oct 2026]
+        ///     NSDocument's default writes a complete copy of the package (from `fileWrapperOfType:`) next to the original and swaps them.
+        ///     Reached when there's no journal (See `writeTranslationDataToFile`). Other save operations (Duplicate, Save As...) still go through `fileWrapperOfType:`.
+        
+        BOOL isInPlace =
+            (saveOperation == NSSaveOperation || saveOperation == NSAutosaveInPlaceOperation) &&
+            self.fileURL && [url.URLByStandardizingPath isEqual: self.fileURL.URLByStandardizingPath];
+        if (!isInPlace)
+            return [super writeSafelyToURL: url ofType: typeName forSaveOperation: saveOperation error: outError];
+        
+        mftrace_scope("save.writeSafelyToURL");
+        
+        NSData *xliffData = xliff_spliceEdits(self->_xliff) ?: xliff_serialize(self->_xliff);
+        if (!xliffData) {
+            if (outError) *outError = mferror(NSCocoaErrorDomain, 0, @"Serializing the xliff failed");
+            return NO;
+        }
+        if (![self _writeXliffData: xliffData toURL: [url URLByAppendingPathComponent: self->_xliffSubpath] error: outError]) return NO;
+        xliff_didWrite(self->_xliff, xliffData);
         return YES;
     }
     
     - (NSFileWrapper *) fileWrapperOfType: (NSString *)typeName error: (NSError *__autoreleasing  _Nullable *)outError {
         
-        fw_writePath(self.storedXclocFileWrapper, fw_getXliffPath(self.storedXclocFileWrapper), [[self->_xliffDoc XMLStringWithOptions: NSXMLNodePrettyPrint] dataUsingEncoding: NSUTF8StringEncoding]);
+        /// The package with the current xliff – for writing it somewhere else. (Saving in place doesn't come here, see `writeSafelyToURL:`)
+        ///     The wrapper reads the rest of the package lazily, straight from the original. [Oct 2026]
         
+        mftrace_scope("save.fileWrapperOfType");
+        mftrace_count("save.fileWrappers", 1);
         
-        static int _fileWrapCounter = 0; /// Monitor if our file is consistently saved on every edit [Oct 2025]
-        mflog(@"(%d) Returning fileWrapper for saving document: %@", _fileWrapCounter++, self.storedXclocFileWrapper);
+        NSData *xliffData = xliff_serialize(self->_xliff);
+        if (!xliffData) {
+            if (outError) *outError = mferror(NSCocoaErrorDomain, 0, @"Serializing the xliff failed");
+            return nil;
+        }
         
-        return self.storedXclocFileWrapper;
+        NSFileWrapper *package = [[NSFileWrapper alloc] initWithURL: self.fileURL options: 0 error: outError];
+        if (!package) return nil;
+        fw_writePath(package, self->_xliffSubpath, xliffData);
+        
+        mflog(@"Returning fileWrapper for saving document: %@", package);
+        
+        return package;
     }
     
     #if 0
@@ -239,6 +563,199 @@
         }
     #endif
 
+#pragma mark - Changes on Disk
+
+    /// When another app changes the xliff – usually Xcode re-exporting the localizations – we merge the new file into the open document, instead of letting NSDocument revert it. (See `XliffMerge.m`) [Oct 2026]
+    ///     We watch the file ourselves, since exports don't always go through NSFileCoordinator. The NSFilePresenter callbacks end up in the same place.
+    ///     Only while we're journaling – the merge needs a spliceable xliff, and it runs on the `_flushQueue`. Otherwise NSDocument handles changes on disk like before.
+    
+    #define kMFDiskChangeDebounce 0.5 /// Exports write in several steps
+    #define kMFWatchMaxRetries    20  /// Give up after 10 seconds without an xliff. Then NSFilePresenter is all we get.
+    
+    - (void) startWatchingXliff {
+        
+        [self stopWatchingXliff];
+        if (!self->_journal || !self.fileURL || self->_isClosed) return;
+        
+        NSString *xliffPath = [self.fileURL.path stringByAppendingPathComponent: self->_xliffSubpath];
+        int fd = open(xliffPath.fileSystemRepresentation, O_EVTONLY);
+        if (fd == -1) {
+            mflog(@"Couldn't watch '%@' (%s)", xliffPath, strerror(errno));
+            return;
+        }
+        
+        dispatch_source_t watcher = dispatch_source_create(DISPATCH_SOURCE_TYPE_VNODE, fd, DISPATCH_VNODE_WRITE | DISPATCH_VNODE_EXTEND | DISPATCH_VNODE_DELETE | DISPATCH_VNODE_RENAME, dispatch_get_main_queue());
+        __weak XclocDocument *weakSelf = self;
+        dispatch_source_set_event_handler(watcher, ^{
+            [weakSelf xliffDidChangeOnDisk];
+        });
+        dispatch_source_set_cancel_handler(watcher, ^{
+            close(fd);
+        });
+        dispatch_resume(watcher);
+        self->_xliffWatcher = watcher;
+    }
+    
+    - (void) stopWatchingXliff {
+        if (!self->_xliffWatcher) return;
+        dispatch_source_cancel(self->_xliffWatcher);
+        self->_xliffWatcher = nil;
+    }
+    
+    - (void) presentedItemDidChange {
+        if (!self->_journal) { [super presentedItemDidChange]; return; }
+        dispatch_async(dispatch_get_main_queue(), ^{ [self xliffDidChangeOnDisk]; });
+    }
+    
+    - (void) presentedSubitemDidChangeAtURL: (NSURL *)url {
+        if (!self->_journal) { [super presentedSubitemDidChangeAtURL: url]; return; }
+        dispatch_async(dispatch_get_main_queue(), ^{ [self xliffDidChangeOnDisk]; });
+    }
+    
+    - (void) xliffDidChangeOnDisk {
+        mfdebounce(kMFDiskChangeDebounce, stringf(@"xliffDidChangeOnDisk-%p", self), ^{
+            [self mergeXliffFromDisk];
+        });
+    }
+    
+    static BOOL _isSameFile(struct stat a, struct stat b) {
+        return a.st_ino == b.st_ino && a.st_size == b.st_size && a.st_mtimespec.tv_sec == b.st_mtimespec.tv_sec && a.st_mtimespec.tv_nsec == b.st_mtimespec.tv_nsec;
+    }
+    
+    - (void) _rememberXliffStat: (NSString *)xliffPath {
+        if (stat(xliffPath.fileSystemRepresentation, &self->_knownXliffStat) != 0) self->_knownXliffStat = (struct stat){0};
+    }
+    
+    - (void) mergeXliffFromDisk {
+        
+        /// Reads and parses the xliff in the background, then merges it in on main.
+        ///     Our own writes also trigger this. We skip those by their (inode, size, mtime) before reading anything – see `_knownXliffStat`.
+        ///     Every atomic replace gets a new inode, so another app's write can't look like ours – unless it leaves the inode, size and mtime alone, which a real edit doesn't.
+        
+        if (self->_isClosed || !self->_journal) return;
+        if (self->_isMergingFromDisk) { [self xliffDidChangeOnDisk]; return; } /// Try again when this one is done
+        if (self->_isFlushing)        { [self xliffDidChangeOnDisk]; return; } /// Our write might be what we're seeing – `_knownXliffStat` isn't updated until the flush is done
+        
+        [self startWatchingXliff]; /// Re-arm – an atomic replace leaves the watcher on the old, deleted file
+        if (!self->_xliffWatcher) { /// The file isn't back yet
+            if (self->_watchRetryCount++ < kMFWatchMaxRetries) [self xliffDidChangeOnDisk];
+            return;
+        }
+        self->_watchRetryCount = 0;
+        
+        NSString *xliffPath = [self.fileURL.path stringByAppendingPathComponent: self->_xliffSubpath];
+        struct stat st;
+        if (stat(xliffPath.fileSystemRepresentation, &st) == 0 && _isSameFile(st, self->_knownXliffStat)) return; /// Ours, or already merged
+        
+        mftrace_scope("merge.fromDisk");
+        
+        self->_isMergingFromDisk = YES; /// Also keeps new flushes from starting
+        StringTable *strings = StringTable_ForProject(self.fileURL.path.stringByDeletingLastPathComponent);
+        
+        dispatch_async(self->_flushQueue, ^{
+            
+            NSError *err = nil;
+            struct stat readStat; /// Before reading – if the file changes while we read, the next event won't match and we read again.
+            if (stat(xliffPath.fileSystemRepresentation, &readStat) != 0) readStat = (struct stat){0};
+            NSData *data = [NSData dataWithContentsOfFile: xliffPath options: 0 error: &err]; /// Not mapped – the other app might still be writing
+            Xliff *xliff = nil;
+            if (data) {
+                xliff = Xliff_Stream(data, strings, &err);
+                if (xliff) rowStore_prebuildSortKeys(xliff->rowStore, @"id"); /// Like `readFromURL:`
+            }
+            
+            dispatch_async(dispatch_get_main_queue(), ^{
+                
+                self->_isMergingFromDisk = NO;
+                
+                if ((0)) {}
+                else if (self->_isClosed)   {}
+                else if (!data)             mflog(@"Reading the changed xliff failed with error: %@", err);
+                else if (!xliff)            mflog(@"Parsing the changed xliff failed with error: %@ – waiting for the next change", err); /// Probably caught it mid-write
+                else {
+                    self->_knownXliffStat = readStat;
+                    [self _applyXliffFromDisk: xliff];
+                }
+                
+                if (self->_needsAnotherFlush) {
+                    self->_needsAnotherFlush = NO;
+                    [self flushJournal];
+                }
+            });
+        });
+    }
+    
+    - (void) _applyXliffFromDisk: (Xliff *)xliff {
+        
+        XliffMerge *merge = xliff_merge(self->_xliff, xliff);
+        if (!merge) {
+            mflog(@"Can't merge the xliff from disk – reverting");
+            NSError *err = nil;
+            if (![self revertToContentsOfURL: self.fileURL ofType: self.fileType error: &err]) mflog(@"Reverting failed with error: %@", err);
+            [self startWatchingXliff]; /// The journal was reopened
+            return;
+        }
+        
+        /// Swap in the merged xliff
+        self->_xliff->rowStore->journal = nil;
+        self->_xliff = xliff;
+        self->_journal->filePaths = xliff->filePaths; /// The old entries record paths, not indexes – so they stay valid.
+        xliff->rowStore->journal = self->_journal;
+        self.fileModificationDate = [[NSFileManager defaultManager] attributesOfItemAtPath: self.fileURL.path error: nil][NSFileModificationDate]; /// Otherwise NSDocument complains on the next save
+        
+        /// Update the UI
+        [self->ctrl->out_sourceList applyMergedXliff: xliff changedItems: merge->changedTransUnits];
+        
+        /// Write the edits we kept into the new file
+        if (xliff->rowStore->unsavedRows.count) {
+            self->_unflushedEditCount = MAX(self->_unflushedEditCount, (NSInteger)xliff->rowStore->unsavedRows.count);
+            [self flushJournal];
+        }
+        
+        if (merge->conflicts.count || merge->lostEditCount) [self _showMergeConflicts: merge];
+    }
+    
+    - (void) _showMergeConflicts: (XliffMerge *)merge {
+        
+        /// The user's versions are already kept – this only offers to take the file's versions instead. Undoable, like any other bulk edit.
+        
+        auto conflictingTransUnits = [NSMutableOrderedSet<NSXMLElement *> new];
+        for (NSDictionary *conflict in merge->conflicts) [conflictingTransUnits addObject: conflict[@"transUnit"]];
+        
+        NSAlert *alert = [NSAlert new];
+        alert.messageText = kMFStr_MergeConflicts;
+        alert.informativeText = kMFStr_MergeConflictsInfo(conflictingTransUnits.count, merge->lostEditCount);
+        if (merge->conflicts.count) {
+            [alert addButtonWithTitle: kMFStr_MergeKeepMine];
+            [alert addButtonWithTitle: kMFStr_MergeUseTheirs];
+        }
+        
+        [alert beginSheetModalForWindow: self->ctrl.window completionHandler: ^(NSModalResponse response) {
+            
+            if (response != NSAlertSecondButtonReturn) return;
+            
+            /// Collect the file's versions
+            ///     Current values for the columns that didn't conflict – the user may have kept editing while the sheet was up.
+            auto transUnits = [NSMutableArray<NSXMLElement *> new];
+            auto states     = [NSMutableArray<NSString *> new];
+            auto targets    = [NSMutableArray<NSString *> new];
+            for (NSXMLElement *transUnit in conflictingTransUnits) {
+                if (rowStore_lookup(transUnit, NULL) != self->_xliff->rowStore) continue; /// Gone with another change on disk
+                [transUnits addObject: transUnit];
+                [states  addObject: rowModel_getCellModel(transUnit, @"state")  ?: kMFTransUnitState_New];
+                [targets addObject: rowModel_getCellModel(transUnit, @"target") ?: @""];
+            }
+            for (NSDictionary *conflict in merge->conflicts) {
+                NSUInteger i = [transUnits indexOfObjectIdenticalTo: conflict[@"transUnit"]];
+                if (i == NSNotFound) continue;
+                if ([conflict[@"column"] isEqual: @"state"]) states[i]  = conflict[@"theirs"];
+                else                                         targets[i] = conflict[@"theirs"];
+            }
+            
+            [self->ctrl->out_tableView setStates: states targets: targets onRowModels: transUnits actionName: kMFStr_MergeUseTheirs];
+        }];
+    }
+
 #pragma mark - Restoration
     /// See `XclocDocumentController.m` for discussion
     /// Bug: (I think `restoreDocumentWindowWithIdentifier:`) Causes app to open and immediately start edting the first row, but without selecting that row, which causes crash and is weird. (app doesn't expect to be editing a row that is not selected)
@@ -289,7 +806,7 @@
     
     mflog(@"Making windowControllers");
     
-    if (self->_xliffDoc == nil) {
+    if (self->_xliff == nil) {
         assert(false);
         return;
     }
@@ -306,12 +823,15 @@
     
     /// Load UI
     [self refreshSourceList];
+    
+    /// Pick up changes by other apps
+    [self startWatchingXliff];
 }
 
 - (void) refreshSourceList {
     /// Reload Source LIst (Does this belong here?) [Oct 2025]
     
-    [self->ctrl->out_sourceList setXliffDoc: self->_xliffDoc];
+    [self->ctrl->out_sourceList setXliff: self->_xliff];
     [self->ctrl->out_sourceList reloadData];
 }
 
@@ -322,17 +842,4 @@ NSString *getXliffPath(NSString *xclocPath) {
     return xliff;
 }
 
-NSString *fw_getXliffPath(NSFileWrapper *xclocWrapper) {
-    
-    auto xliff = fw_findPaths(xclocWrapper, ^BOOL (NSFileWrapper *w, NSString *p, BOOL *stop) {
-        if ([p hasSuffix: @".xliff"]) {
-            *stop = YES;
-            return YES;
-        }
-        return NO;
-    })[0];
-    
-    return xliff;
-}
-
 @end
@@ -49,6 +49,7 @@
             auto openPanel = [NSOpenPanel new];
             [openPanel setRestorable: NO]; /// Desparate 
             openPanel.allowsMultipleSelection = NO;
+            openPanel.canChooseDirectories = YES; /// Choosing a folder opens all the .xcloc files inside (See `openProjectFolder:`) [Oct 2026]
             [openPanel setRequiredFileType: @"com.apple.xcode.xcloc"];
             {
             
@@ -79,7 +80,10 @@
                     [openPanel setDirectory: [_searchResults[0] stringByDeletingLastPathComponent]];
             }
             [openPanel beginWithCompletionHandler:^(NSModalResponse result) {
-                if (openPanel.URL && result == NSModalResponseOK) {
+                if (openPanel.URL && result == NSModalResponseOK && ![openPanel.URL.pathExtension isEqual: @"xcloc"]) {
+                    [self openProjectFolder: openPanel.URL];
+                }
+                else if (openPanel.URL && result == NSModalResponseOK) {
                     [self openDocumentWithContentsOfURL: openPanel.URL display: YES completionHandler:^(NSDocument * _Nullable document, BOOL documentWasAlreadyOpen, NSError * _Nullable error) {
                         mflog(@"Document opened %@, atPath: %@, was open: %@, error: %@", document, openPanel.URL, @(documentWasAlreadyOpen), error);
                         [document showWindows];
@@ -88,6 +92,44 @@
             }];
         }
     #endif
+    
+    - (void) openProjectFolder: (NSURL *)folderURL {
+        
+        /// Opens every .xcloc in the folder – one window per language.
+        ///     The xliffs are parsed in parallel and share their source strings (See `XclocProject.m`). Each document then just picks up its preloaded xliff. [Oct 2026]
+        
+        NSArray<NSString *> *allPaths = XclocProject_FindXclocs(folderURL.path);
+        if (!allPaths.count) {
+            mflog(@"No .xcloc files in %@", folderURL);
+            NSBeep();
+            return;
+        }
+        
+        /// Don't preload what's already open – NSDocumentController would just bring those to the front
+        auto xclocPaths = [NSMutableArray<NSString *> new];
+        for (NSString *p in allPaths)
+            if (![self documentForURL: [NSURL fileURLWithPath: p]]) [xclocPaths addObject: p];
+        
+        dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+            
+            XclocProject_Preload(xclocPaths);
+            
+            dispatch_async(dispatch_get_main_queue(), ^{
+                dispatch_group_t opening = dispatch_group_create();
+                for (NSString *p in allPaths) {
+                    dispatch_group_enter(opening);
+                    [self openDocumentWithContentsOfURL: [NSURL fileURLWithPath: p] display: YES completionHandler: ^(NSDocument * _Nullable document, BOOL documentWasAlreadyOpen, NSError * _Nullable error) {
+                        mflog(@"Project document opened %@, atPath: %@, was open: %@, error: %@", document, p, @(documentWasAlreadyOpen), error);
+                        [document showWindows];
+                        dispatch_group_leave(opening);
+                    }];
+                }
+                dispatch_group_notify(opening, dispatch_get_main_queue(), ^{
+                    XclocProject_DropPreloaded();
+                });
+            });
+        });
+    }
 
     + (void) restoreWindowWithIdentifier:(NSUserInterfaceItemIdentifier)identifier state:(NSCoder *)state completionHandler:(void (^)(NSWindow * _Nullable, NSError * _Nullable))completionHandler {
         
@@ -0,0 +1,99 @@
+//
+//  XclocPackage.m
+//  mf-xcloc-editor
+//
+//  Created by Noah Nübling on 10/17/26.
+//
+
+/// Finds the files we need inside an .xcloc package – without looking at the ones we don't [Oct 2026]
+///
+///     Why: We used to load the whole package as an NSFileWrapper tree and search it recursively for the xliff and the screenshot plist.
+///         That stats every screenshot, every asset catalog image and all of `Source Contents` – for a package with hundreds of screenshots, that was most of the open time, and NSDocument then kept the tree around and wrote it back on save.
+///     Now we go by Xcode's layout:
+///         <name>.xcloc/
+///             contents.json                                   ("targetLocale")
+///             Localized Contents/<targetLocale>.xliff
+///             Notes/Screenshots/<test>/<device>/localizedStringData.plist
+///             Source Contents/...                             (never looked at)
+///     ... and only fall back to a scan if that doesn't work out. The scan skips the folders that only contain images and sources, and gives up after `kMFPackageScanMaxEntries`.
+///
+///     The other package members (the screenshots) are opened on demand by `Screenshots.m`.
+
+#define kMFPackageScanMaxEntries 5000
+
+static NSArray<NSString *> *_xclocPackage_scan(NSString *xclocPath, BOOL (^condition)(NSString *subpath), BOOL firstOnly) {
+
+    /// Bounded fallback for packages that don't follow the usual layout. Returns subpaths (relative to the package).
+
+    auto result = [NSMutableArray<NSString *> new];
+    NSDirectoryEnumerator<NSString *> *e = [[NSFileManager defaultManager] enumeratorAtPath: xclocPath];
+    NSInteger seen = 0;
+    for (NSString *subpath in e) {
+        if (++seen > kMFPackageScanMaxEntries) {
+            mflog(@"Gave up scanning '%@' after %d entries", xclocPath, kMFPackageScanMaxEntries);
+            break;
+        }
+        NSString *name = subpath.lastPathComponent;
+        if ([subpath isEqual: @"Source Contents"] || [name.pathExtension isEqual: @"xcassets"] || [name.pathExtension isEqual: @"lproj"]) {
+            [e skipDescendants];
+            continue;
+        }
+        if (condition(subpath)) {
+            [result addObject: subpath];
+            if (firstOnly) break;
+        }
+    }
+    return result;
+}
+
+static NSArray<NSString *> *_xclocPackage_list(NSString *dirPath) {
+    return [[[NSFileManager defaultManager] contentsOfDirectoryAtPath: dirPath error: nil] sortedArrayUsingSelector: @selector(compare:)] ?: @[];
+}
+
+NSString *_Nullable XclocPackage_XliffSubpath(NSString *xclocPath) {
+
+    /// Path of the .xliff, relative to the package. nil if there's none.
+
+    /// contents.json -> `Localized Contents/<targetLocale>.xliff`
+    NSData *contentsData = [NSData dataWithContentsOfFile: [xclocPath stringByAppendingPathComponent: @"contents.json"]];
+    NSDictionary *contents = contentsData ? [NSJSONSerialization JSONObjectWithData: contentsData options: 0 error: nil] : nil;
+    if (isclass(contents, NSDictionary) && isclass(contents[@"targetLocale"], NSString)) {
+        NSString *subpath = [@"Localized Contents" stringByAppendingPathComponent: [contents[@"targetLocale"] stringByAppendingPathExtension: @"xliff"]];
+        if ([[NSFileManager defaultManager] fileExistsAtPath: [xclocPath stringByAppendingPathComponent: subpath]]) return subpath;
+    }
+
+    /// Any xliff directly in `Localized Contents`
+    for (NSString *name in _xclocPackage_list([xclocPath stringByAppendingPathComponent: @"Localized Contents"]))
+        if ([name.pathExtension isEqual: @"xliff"]) return [@"Localized Contents" stringByAppendingPathComponent: name];
+
+    /// Scan
+    return _xclocPackage_scan(xclocPath, ^BOOL (NSString *subpath) { return [subpath.pathExtension isEqual: @"xliff"]; }, YES).firstObject;
+}
+
+NSString *_Nullable XclocPackage_StringsDataPlistSubpath(NSString *xclocPath) {
+
+    /// Path of `localizedStringData.plist`, relative to the package. nil if the package has no screenshots.
+    ///     Lists the test and device folders – not the screenshots in them.
+
+    NSString *screenshotsSubpath = @"Notes/Screenshots";
+    NSString *screenshotsDir = [xclocPath stringByAppendingPathComponent: screenshotsSubpath];
+    BOOL isDir = NO;
+    if (![[NSFileManager defaultManager] fileExistsAtPath: screenshotsDir isDirectory: &isDir] || !isDir) return nil;
+
+    for (NSString *test in _xclocPackage_list(screenshotsDir)) {
+        for (NSString *device in _xclocPackage_list([screenshotsDir stringByAppendingPathComponent: test])) {
+            NSString *subpath = [screenshotsSubpath stringByAppendingPathComponent: [[test stringByAppendingPathComponent: device] stringByAppendingPathComponent: @"localizedStringData.plist"]];
+            if ([[NSFileManager defaultManager] fileExistsAtPath: [xclocPath stringByAppendingPathComponent: subpath]]) return subpath;
+        }
+    }
+
+    return _xclocPackage_scan(xclocPath, ^BOOL (NSString *subpath) { return [subpath.lastPathComponent isEqual: @"localizedStringData.plist"]; }, YES).firstObject;
+}
+
+NSData *_Nullable XclocPackage_MapFile(NSString *path, NSError *__autoreleasing _Nullable *outError) {
+
+    /// Read-only, memory-mapped where that's safe (local volumes) – so a big xliff is paged in as the parser gets to it instead of copied up front.
+    ///     Only for parsing – don't keep the result around. Our own saves replace the file with `rename()`, but another app might truncate or rewrite it in place, and touching a page that's gone from the file crashes with SIGBUS. (See `xliff_copyMappedData()`)
+
+    return [NSData dataWithContentsOfFile: path options: NSDataReadingMappedIfSafe error: outError];
+}
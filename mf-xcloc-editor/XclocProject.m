@@ -0,0 +1,93 @@
+//
+//  XclocProject.m
+//  mf-xcloc-editor
+//
+//  Created by Noah Nübling on 10/17/26.
+//
+
+/// Loads all the .xcloc files of a project folder at once [Oct 2026]
+///
+///     Xcode exports one .xcloc per language into the same folder. Opening them one after another parsed the same sources, ids and notes over and over, one language at a time.
+///     Here we parse all the xliffs in parallel (one per core), sharing the `StringTable` of the folder – so opening the whole project takes about as long as opening its largest language, and the per-language memory is mostly targets.
+///
+///     The parsed `Xliff`s are parked here until each `XclocDocument` picks up its own in `readFromURL:` (See `XclocProject_TakePreloaded()`).
+///         That keeps NSDocument's opening machinery (window restoration, recent documents, autosave) the same as for a single .xcloc.
+
+static NSMutableDictionary<NSString *, Xliff *> *_preloaded; /// xliff path -> Xliff || Guarded by `_preloadedLock`
+static mflock_t _preloadedLock = MFLOCK_INIT;
+
+NSArray<NSString *> *XclocProject_FindXclocs(NSString *projectDir) {
+
+    /// The .xcloc packages directly inside `projectDir`, sorted by name. (Doesn't look inside the packages or into subfolders.)
+
+    NSArray<NSString *> *names = [[NSFileManager defaultManager] contentsOfDirectoryAtPath: projectDir error: nil];
+    auto result = [NSMutableArray<NSString *> new];
+    for (NSString *name in [names sortedArrayUsingSelector: @selector(localizedStandardCompare:)])
+        if ([name.pathExtension isEqual: @"xcloc"])
+            [result addObject: [projectDir stringByAppendingPathComponent: name]];
+    return result;
+}
+
+void XclocProject_Preload(NSArray<NSString *> *xclocPaths) {
+
+    /// Parses the xliffs of `xclocPaths` concurrently. Blocks until all of them are done – call it off the main thread.
+    ///     Failures are only logged: the document will try again on its own and report the error the usual way.
+
+    if (!xclocPaths.count) return;
+
+    xmlInitParser(); /// libxml2 wants this before it's used from several threads. Calling it more than once is fine.
+
+    CFAbsoluteTime t0 = CFAbsoluteTimeGetCurrent();
+
+    dispatch_apply(xclocPaths.count, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t i) {
+        @autoreleasepool {
+
+            NSString *xclocPath = xclocPaths[i];
+            NSString *xliffSubpath = XclocPackage_XliffSubpath(xclocPath); /// Same lookup as `-[XclocDocument readFromURL:]`, so the paths match up in `XclocProject_TakePreloaded()`
+            if (!xliffSubpath) return;
+            NSString *xliffPath = [xclocPath stringByAppendingPathComponent: xliffSubpath];
+
+            NSError *err = nil;
+            NSData *data = XclocPackage_MapFile(xliffPath, &err);
+            if (!data) { mflog(@"Preloading '%@' failed: %@", xliffPath, err); return; }
+
+            Xliff *xliff = Xliff_Stream(data, StringTable_ForProject(xclocPath.stringByDeletingLastPathComponent), &err);
+            if (!xliff) { mflog(@"Preloading '%@' failed: %@ – The document will fall back to NSXMLDocument", xliffPath, err); return; }
+            xliff_copyMappedData(xliff);
+
+            mflock(&_preloadedLock);
+            if (!_preloaded) _preloaded = [NSMutableDictionary new];
+            _preloaded[xliffPath.stringByStandardizingPath] = xliff;
+            mfunlock(&_preloadedLock);
+        }
+    });
+
+    mflog(@"Preloaded %ld xclocs in %.0f ms", xclocPaths.count, (CFAbsoluteTimeGetCurrent() - t0) * 1000);
+}
+
+Xliff *_Nullable XclocProject_TakePreloaded(NSString *xliffPath, NSData *xliffData) {
+
+    /// Hands out the preloaded `Xliff` for `xliffPath` – once. Returns nil if there's none, or if the file changed since it was preloaded.
+
+    mflock(&_preloadedLock);
+    NSString *key = xliffPath.stringByStandardizingPath;
+    Xliff *xliff = _preloaded[key];
+    [_preloaded removeObjectForKey: key];
+    mfunlock(&_preloadedLock);
+
+    if (xliff && ![xliff->data isEqualToData: xliffData]) {
+        mflog(@"'%@' changed after it was preloaded – parsing it again", xliffPath);
+        return nil;
+    }
+    return xliff;
+}
+
+void XclocProject_DropPreloaded(void) {
+
+    /// Frees whatever wasn't picked up – e.g. because a document was already open or failed to open.
+
+    mflock(&_preloadedLock);
+    if (_preloaded.count) mflog(@"Dropping %ld unused preloaded xliffs", _preloaded.count);
+    _preloaded = nil;
+    mfunlock(&_preloadedLock);
+}
@@ -0,0 +1,833 @@
+//
+//  Xliff.m
+//  mf-xcloc-editor
+//
+//  Created by Noah Nübling on 10/17/26.
+//
+
+/// The contents of the .xliff file inside an .xcloc [Oct 2026]
+///
+///     There are two loaders:
+///         - `Xliff_Stream()`:         Parses the file in a single pass with libxml2's xmlreader, without ever building an `NSXMLDocument`. The values go straight into the `RowStore`, and each transUnit becomes a small standalone `NSXMLElement` that only serves as the rowModel.
+///         - `Xliff_FromDocument()`:   The old way – parse everything into an `NSXMLDocument` and walk it. Kept as a fallback in case the streaming parser chokes on something.
+///     Both do the validation that used to live in `-[SourceList setXliffDoc:]`
+///
+///     Why: Our big exports are 60-120 MB. The DOM for those is several times the size of the file, and building it + walking it again took many seconds.
+
+@interface Xliff : NSObject
+    {
+        @public
+        NSString *sourceLanguage;
+        NSString *targetLanguage;
+        NSArray<NSString *> *filePaths;                         /// `original` attribute of each `<file>`. Files without translatable transUnits are left out.
+        NSArray<NSArray<NSXMLElement *> *> *transUnitsByFile;   /// Same order as `filePaths`. `translate="no"` transUnits are left out.
+        RowStore *rowStore;
+
+        NSXMLDocument *_Nullable doc;                           /// For streamed xliffs, this is only created when saving. See `xliff_serialize()`
+        NSData *_Nullable data;                                 /// Raw bytes of a streamed xliff
+        NSArray<NSXMLElement *> *_Nullable _docTransUnits;      /// Streamed xliffs only: The transUnits of `doc`, indexed by `RowStore` row.
+
+        /// Byte-preserving saves (See `xliff_spliceEdits()`)
+        ///     All nil/NULL if the xliff can't be saved that way – then we fall back to the DOM. [Oct 2026]
+        struct XliffTargetLocation *_Nullable _targetLocations; /// Where each row's `<target>` is in `data`. Indexed by `RowStore` row.
+        NSMutableArray<NSString *> *_Nullable _savedTargets;    /// What's currently in `data` for each row – so we only re-encode what actually changed.
+        NSMutableArray<NSString *> *_Nullable _savedStates;
+
+        /// The last splice, until it's on disk (See `xliff_didWrite()`)
+        ///     `data`, `_targetLocations` and the saved values only move forward once the bytes were written – so after a failed write they still describe the file. [Oct 2026]
+        NSData *_Nullable _pendingData;
+        struct XliffTargetLocation *_Nullable _pendingLocations;
+        NSDictionary<NSNumber *, NSArray<NSString *> *> *_Nullable _pendingValues; /// row -> @[target, state] as they are in `_pendingData`
+    }
+@end
+@implementation Xliff
+    - (void) dealloc {
+        free(self->_targetLocations);
+        free(self->_pendingLocations);
+    }
+@end
+
+#pragma mark - DOM
+
+Xliff *Xliff_FromDocument(NSXMLDocument *xliffDoc) {
+    
+    /// Validate doc
+    
+    assert( [xliffDoc.version           isEqual: @"1.0"] );
+    assert( [xliffDoc.characterEncoding isEqual: @"UTF-8"] ); /// Not sure these things make any sense validating
+    
+    /// Validate xliff node
+    
+    NSXMLNode *xliff = [xliffDoc rootElement];
+    
+    assert( [xliff.name isEqual: @"xliff"] );
+    assert( isclass(xliff, NSXMLElement) );
+    auto attrs = xml_attrdict((NSXMLElement *)xliff);
+    
+    if ((0)) assert( [attrs[@"xmlns"].objectValue     isEqual: @"urn:oasis:names:tc:xliff:document:1.2"] );         /// Present in the xml text but not here
+    if ((0)) assert( [attrs[@"xmlns:xsi"].objectValue isEqual: @"http://www.w3.org/2001/XMLSchema-instance"] ); /// Present in the xml text but not here
+    assert( [attrs[@"version"].objectValue            isEqual: @"1.2" ] );
+    assert( [attrs[@"xsi:schemaLocation"].objectValue isEqual: @"urn:oasis:names:tc:xliff:document:1.2 http://docs.oasis-open.org/xliff/v1.2/os/xliff-core-1.2-strict.xsd"] );
+    
+    /// Validate & store xliff node children (files)
+    assert( allsatisfy(xliff.children, xliff.childCount, x, isclass(x, NSXMLElement)) );
+    assert( allsatisfy(xliff.children, xliff.childCount, x, [x.name isEqual: @"file"]) );
+    
+    /// Unwrap the transUnits
+    auto filePaths = [NSMutableArray new];
+    auto transUnitsByFile = [NSMutableArray new];
+    NSString *sourceLanguage = nil;
+    NSString *targetLanguage = nil;
+    for (NSXMLElement *file in xliff.children) {
+    
+        /** Validate data
+            Should look like this:
+            ```
+            <file original="App/UI/Main/Base.lproj/Main.storyboard" source-language="en" target-language="de" datatype="plaintext">
+                <header>
+                  <tool tool-id="com.apple.dt.xcode" tool-name="Xcode" tool-version="16.1" build-num="16B5001e"/>
+                </header>
+                <body>...
+            ```
+        */
+        {
+            NSDictionary<NSString *, NSXMLNode *> *attrs;
+            
+            /// Validate `<file>`
+            
+            assert(file != nil);
+            assert([file.name isEqual: @"file"]);
+            assert(file.childCount == 2);
+            assert([[file childAtIndex: 0].name isEqual: @"header"]);
+            assert([[file childAtIndex: 1].name isEqual: @"body"]);
+            assert(isclass([file childAtIndex: 0], NSXMLElement));
+            assert(isclass([file childAtIndex: 1], NSXMLElement));
+            
+            
+            attrs = xml_attrdict(file);
+            assert(attrs[@"original"].objectValue           );
+            assert(attrs[@"source-language"].objectValue    );
+            assert(attrs[@"target-language"].objectValue    );
+            assert(attrs[@"datatype"].objectValue           );
+            
+            if (!sourceLanguage) sourceLanguage = attrs[@"source-language"].objectValue;
+            else                 assert([sourceLanguage isEqual: attrs[@"source-language"].objectValue]);
+            if (!targetLanguage) targetLanguage = attrs[@"target-language"].objectValue;
+            else                 assert([targetLanguage isEqual: attrs[@"target-language"].objectValue]);
+            
+            mflog("Attributes: %@", attrs);
+            
+            /// Validate `<header>`
+            
+            NSXMLNode *header = [file childAtIndex:0];
+            assert(header.childCount == 1);
+            NSXMLNode *tool = [header childAtIndex:0];
+            assert([tool.name isEqual: @"tool"]);
+            assert( isclass(tool, NSXMLElement) );
+            attrs = xml_attrdict((NSXMLElement *)tool);
+            assert([attrs[@"tool-id"].objectValue       isEqual: @"com.apple.dt.xcode"] );
+            assert([attrs[@"tool-name"].objectValue     isEqual: @"Xcode"]              );
+            if ((0)) { /// We hope our code can support other versions, too?
+                assert([attrs[@"tool-version"].objectValue  isEqual: @"16.1"]               );
+                assert([attrs[@"build-num"].objectValue     isEqual: @"16B5001e"]           );
+            }
+        }
+        
+        NSArray<NSXMLElement *> *transUnits = (id)[xml_childnamed(file, @"body") children];
+        
+        NSMutableArray<NSXMLElement *> *filteredTransUnits = [NSMutableArray new]; /// Filter out transUnits with `kMFTransUnitState_DontTranslate` (Why does Xcode even export those?)  || Reimplements the logic in `rowModel_getCellModel` Maybe we should reuse that? [Oct 2025]
+        {
+            for (NSXMLElement *transUnit in transUnits) {
+                if ([xml_attr(transUnit, @"translate").objectValue isEqual: @"no"])
+                    continue;
+                [filteredTransUnits addObject: transUnit];
+            }
+        }
+        if (filteredTransUnits.count) {
+            [filePaths addObject: xml_attr(file, @"original").objectValue];
+            [transUnitsByFile addObject: filteredTransUnits];
+        }
+    }
+    
+    auto x = [Xliff new];
+    x->sourceLanguage   = sourceLanguage;
+    x->targetLanguage   = targetLanguage;
+    x->filePaths        = filePaths;
+    x->transUnitsByFile = transUnitsByFile;
+    x->rowStore         = RowStore_Make(transUnitsByFile, filePaths); /// This is the only place where the xml structure can change, so the parent/child relationships are only computed here. [Oct 2026]
+    x->doc              = xliffDoc;
+    return x;
+}
+
+#pragma mark - Byte ranges
+
+    /// To save without re-serializing the whole document, we remember where each transUnit's `<target>` is in the original bytes. (See `xliff_spliceEdits()`) [Oct 2026]
+    ///     xmlreader can't tell us – `xmlTextReaderByteConsumed()` is only precise to the parser's input buffer – so we find the positions in a second pass over the bytes.
+    ///     That pass only needs to understand tags, not entities or namespaces, so it's just a few memchr()s per element.
+
+    typedef struct XliffTargetLocation {
+        NSUInteger indentStart;         /// Start of the whitespace in front of `<source>` on its line. Used to indent inserted `<target>`s
+        NSUInteger sourceStart;         /// `<` of `<source>`
+        NSUInteger sourceEnd;           /// Right after `</source>`. A missing `<target>` is inserted here
+        NSUInteger targetStart;         /// `<` of `<target>`. NSNotFound if the transUnit has no target
+        NSUInteger targetTagEnd;        /// Right after the `>` of the start tag
+        NSUInteger targetContentEnd;    /// `<` of `</target>`. Same as `targetTagEnd` for `<target/>`
+        NSUInteger targetEnd;           /// Right after `</target>`. Same as `targetTagEnd` for `<target/>`
+        NSUInteger stateStart;          /// Value of the `state` attribute, without the quotes. NSNotFound if there's none
+        NSUInteger stateEnd;
+    } XliffTargetLocation;
+
+    static void XliffTargetLocation_shift(XliffTargetLocation *l, NSUInteger from, NSInteger delta) {
+        /// Move all positions at or after `from` by `delta`
+        NSUInteger *fields[] = { &l->indentStart, &l->sourceStart, &l->sourceEnd, &l->targetStart, &l->targetTagEnd, &l->targetContentEnd, &l->targetEnd, &l->stateStart, &l->stateEnd };
+        for (int i = 0; i < arrcount(fields); i++)
+            if (*fields[i] != NSNotFound && *fields[i] >= from) *fields[i] += delta;
+    }
+
+    static XliffTargetLocation *_Nullable _xliff_scanTargetLocations(NSData *data, NSInteger *outCount) {
+        
+        /// Returns one location per `<trans-unit>` in document order – including the `translate="no"` ones.
+        ///     Returns NULL on anything unexpected. Caller needs to free() the result.
+        
+        const char *b = data.bytes;
+        NSUInteger n = data.length;
+        
+        NSInteger count = 0, capacity = 1024;
+        XliffTargetLocation *locs = malloc(capacity * sizeof(XliffTargetLocation));
+        XliffTargetLocation *cur = NULL;
+        
+        NSInteger depth = 0;                /// Number of open elements
+        NSInteger transUnitDepth = -1;      /// -1 outside of `<trans-unit>`s
+        
+        #define fail(msg...) ({ mflog(msg); free(locs); return NULL; })
+        #define hasprefix(i, s) ((i) + strlen(s) <= n && 0 == memcmp(b + (i), (s), strlen(s)))
+        #define skippast(i, s) ({ \
+            const char *_p = memmem(b + (i), n - (i), (s), strlen(s)); \
+            if (!_p) fail(@"Unterminated '%s' at byte %lu", (s), (unsigned long)(i)); \
+            (NSUInteger)(_p - b) + strlen(s); \
+        })
+        #define isspace_(c) ((c) == ' ' || (c) == '\t' || (c) == '\n' || (c) == '\r')
+        
+        NSUInteger i = 0;
+        while (i < n) {
+            
+            const char *lt = memchr(b + i, '<', n - i);
+            if (!lt) break;
+            NSUInteger tagStart = lt - b;
+            
+            /// Skip non-elements
+            if      (hasprefix(tagStart, "<!--"))       { i = skippast(tagStart, "-->"); continue; }
+            else if (hasprefix(tagStart, "<![CDATA["))  { i = skippast(tagStart, "]]>"); continue; }
+            else if (hasprefix(tagStart, "<?"))         { i = skippast(tagStart, "?>");  continue; }
+            else if (hasprefix(tagStart, "<!")) { /// DOCTYPE
+                i = skippast(tagStart, ">");
+                if (memchr(b + tagStart, '[', i - tagStart)) fail(@"DOCTYPEs with an internal subset aren't supported");
+                continue;
+            }
+            
+            BOOL isEndTag = hasprefix(tagStart, "</");
+            
+            /// Parse name
+            NSUInteger nameStart = tagStart + (isEndTag ? 2 : 1);
+            NSUInteger j = nameStart;
+            while (j < n && !isspace_(b[j]) && b[j] != '>' && b[j] != '/') j++;
+            NSUInteger nameLength = j - nameStart;
+            #define isname(s) (nameLength == strlen(s) && 0 == memcmp(b + nameStart, (s), nameLength))
+            
+            BOOL isTarget = !isEndTag && transUnitDepth != -1 && depth == transUnitDepth + 1 && isname("target");
+            
+            /// Parse attributes
+            NSUInteger stateStart = NSNotFound, stateEnd = NSNotFound;
+            BOOL isEmptyElement = NO;
+            while (1) {
+                while (j < n && isspace_(b[j])) j++;
+                if (j >= n)                     fail(@"Unterminated tag at byte %lu", (unsigned long)tagStart);
+                if (b[j] == '>')                { j += 1; break; }
+                if (hasprefix(j, "/>"))         { j += 2; isEmptyElement = YES; break; }
+                if (isEndTag)                   fail(@"Unexpected content in end tag at byte %lu", (unsigned long)tagStart);
+                
+                NSUInteger attrStart = j;
+                while (j < n && !isspace_(b[j]) && b[j] != '=') j++;
+                NSUInteger attrLength = j - attrStart;
+                while (j < n && isspace_(b[j])) j++;
+                if (j >= n || b[j] != '=')      fail(@"Attribute without value at byte %lu", (unsigned long)attrStart);
+                j++;
+                while (j < n && isspace_(b[j])) j++;
+                if (j >= n || (b[j] != '"' && b[j] != '\'')) fail(@"Unquoted attribute value at byte %lu", (unsigned long)attrStart);
+                const char *closingQuote = memchr(b + j + 1, b[j], n - j - 1);
+                if (!closingQuote)              fail(@"Unterminated attribute value at byte %lu", (unsigned long)attrStart);
+                
+                if (isTarget && attrLength == 5 && 0 == memcmp(b + attrStart, "state", 5)) {
+                    stateStart = j + 1;
+                    stateEnd   = closingQuote - b;
+                }
+                j = (closingQuote - b) + 1;
+            }
+            i = j;
+            
+            /// Record positions
+            if (!isEndTag) {
+                
+                NSInteger elementDepth = depth;
+                if (!isEmptyElement) depth++;
+                
+                if (transUnitDepth == -1) {
+                    if (isname("trans-unit")) {
+                        if (isEmptyElement) fail(@"Empty trans-unit at byte %lu", (unsigned long)tagStart);
+                        if (count == capacity) {
+                            capacity *= 2;
+                            locs = realloc(locs, capacity * sizeof(XliffTargetLocation));
+                        }
+                        cur = &locs[count++];
+                        *cur = (XliffTargetLocation) { NSNotFound, NSNotFound, NSNotFound, NSNotFound, NSNotFound, NSNotFound, NSNotFound, NSNotFound, NSNotFound };
+                        transUnitDepth = elementDepth;
+                    }
+                }
+                else if (elementDepth == transUnitDepth + 1) {
+                    if (isname("source")) {
+                        cur->sourceStart = tagStart;
+                        NSUInteger k = tagStart;
+                        while (k > 0 && (b[k-1] == ' ' || b[k-1] == '\t')) k--;
+                        cur->indentStart = (k == 0 || b[k-1] == '\n') ? k : tagStart; /// No indent if `<source>` isn't first on its line
+                        if (isEmptyElement) cur->sourceEnd = i;
+                    }
+                    else if (isTarget) {
+                        cur->targetStart  = tagStart;
+                        cur->targetTagEnd = i;
+                        cur->stateStart   = stateStart;
+                        cur->stateEnd     = stateEnd;
+                        if (isEmptyElement) cur->targetContentEnd = cur->targetEnd = i;
+                    }
+                }
+            }
+            else {
+                
+                depth--;
+                if (depth < 0) fail(@"Unbalanced end tag at byte %lu", (unsigned long)tagStart);
+                
+                if (transUnitDepth != -1) {
+                    if (depth == transUnitDepth) { /// `</trans-unit>`
+                        transUnitDepth = -1;
+                        cur = NULL;
+                    }
+                    else if (depth == transUnitDepth + 1) {
+                        if      (isname("source")) cur->sourceEnd = i;
+                        else if (isname("target")) { cur->targetContentEnd = tagStart; cur->targetEnd = i; }
+                    }
+                }
+            }
+            #undef isname
+        }
+        
+        #undef fail
+        #undef hasprefix
+        #undef skippast
+        #undef isspace_
+        
+        *outCount = count;
+        return locs;
+    }
+
+    static void _xliff_attachTargetLocations(Xliff *x, const NSInteger *rowOrdinals, const bool *rowHasTarget, NSInteger transUnitCount) {
+        
+        /// Enables `xliff_spliceEdits()` for a streamed xliff
+        ///     `rowOrdinals` maps each row to the index of its `<trans-unit>` among all transUnits in the file (rows skip the `translate="no"` ones)
+        ///     We cross-check against what xmlreader saw, and leave the xliff on the DOM path if anything disagrees. [Oct 2026]
+        
+        RowStore *store = x->rowStore;
+        
+        NSInteger scannedCount = 0;
+        XliffTargetLocation *scanned = _xliff_scanTargetLocations(x->data, &scannedCount);
+        if (!scanned) return;
+        if (scannedCount != transUnitCount) {
+            mflog(@"Found %ld trans-units in the bytes, but xmlreader saw %ld – Saves will go through the DOM", scannedCount, transUnitCount);
+            free(scanned);
+            return;
+        }
+        
+        XliffTargetLocation *locs = malloc(MAX(1, store->count) * sizeof(XliffTargetLocation));
+        for (NSInteger row = 0; row < store->count; row++) {
+            locs[row] = scanned[rowOrdinals[row]];
+            if ((locs[row].targetStart != NSNotFound) != rowHasTarget[row]) {
+                mflog(@"The <target> of row %ld wasn't found where xmlreader saw it – Saves will go through the DOM", row);
+                free(scanned);
+                free(locs);
+                return;
+            }
+        }
+        free(scanned);
+        
+        auto savedStates = [NSMutableArray<NSString *> arrayWithCapacity: store->count];
+        for (NSInteger row = 0; row < store->count; row++)
+            [savedStates addObject: rowStore_getCellModel(store, row, @"state")];
+        
+        x->_targetLocations = locs;
+        x->_savedTargets    = [store->targets mutableCopy];
+        x->_savedStates     = savedStates;
+    }
+
+#pragma mark - Streaming
+
+    static NSString *_Nullable _xmlreader_attr(xmlTextReaderPtr r, const char *name) {
+        xmlChar *value = xmlTextReaderGetAttribute(r, BAD_CAST name);
+        if (!value) return nil;
+        NSString *result = [NSString stringWithUTF8String: (const char *)value];
+        xmlFree(value);
+        return result;
+    }
+    static NSString *_xmlreader_content(xmlTextReaderPtr r) {
+        /// Text content of the current element – same as `-[NSXMLNode objectValue]` for our elements
+        xmlChar *value = xmlTextReaderReadString(r);
+        if (!value) return @""; /// Empty element
+        NSString *result = [NSString stringWithUTF8String: (const char *)value];
+        xmlFree(value);
+        return result;
+    }
+
+Xliff *_Nullable Xliff_Stream(NSData *data, StringTable *_Nullable strings, NSError *__autoreleasing _Nullable *outError) {
+    
+    /// Returns nil if libxml2 can't parse the data. Callers should then fall back to `Xliff_FromDocument()` (Which will give a proper error) [Oct 2026]
+    ///     Validation failures are asserts, like in `Xliff_FromDocument()`
+    ///     Pass the `strings` of the project (See `StringTable_ForProject()`) to share the ids, sources and notes with the other languages. Safe to call concurrently for different xliffs.
+    
+    if (data.length > INT_MAX) { /// xmlReaderForMemory takes an int
+        if (outError) *outError = mferror(NSCocoaErrorDomain, 0, @"xliff is too large for xmlreader (%lu bytes)", data.length);
+        return nil;
+    }
+    
+    xmlTextReaderPtr r = xmlReaderForMemory((const char *)data.bytes, (int)data.length, NULL, NULL, XML_PARSE_NONET | XML_PARSE_HUGE);
+    
+    #define fail(msg...) ({ \
+        mflog(msg); \
+        if (outError) *outError = mferror(NSCocoaErrorDomain, 0, msg); \
+        xmlFreeTextReader(r); \
+        return nil; \
+    })
+    
+    if (!r) fail(@"Couldn't create xmlreader");
+    
+    auto filePaths = [NSMutableArray<NSString *> new];
+    auto transUnitsByFile = [NSMutableArray<NSArray<NSXMLElement *> *> new];
+    RowStore *store = RowStore_Begin();
+    NSString *sourceLanguage = nil;
+    NSString *targetLanguage = nil;
+    
+    /// State of the current `<file>`
+    NSMutableArray<NSXMLElement *> *fileTransUnits = nil;
+    NSString *filePath = nil;
+    
+    /// State of the current `<trans-unit>`
+    BOOL inTransUnit = NO;
+    NSInteger transUnitOrdinal = -1;                    /// Counts all transUnits, including the ones we filter out
+    auto rowOrdinals  = [NSMutableData new];            /// NSInteger per row – for `_xliff_attachTargetLocations()`
+    auto rowHasTarget = [NSMutableData new];            /// bool per row
+    NSString *transUnitID = nil, *translate = nil, *source = nil, *target = nil, *targetState = nil, *note = nil;
+    
+    /// Parse
+    ///     Depths: `<xliff>` 0 > `<file>` 1 > `<header>`/`<body>` 2 > `<tool>`/`<trans-unit>` 3 > `<source>`/`<target>`/`<note>` 4
+    int ret;
+    while ((ret = xmlTextReaderRead(r)) == 1) {
+        
+        int type  = xmlTextReaderNodeType(r);
+        int depth = xmlTextReaderDepth(r);
+        const char *name = (const char *)xmlTextReaderConstLocalName(r);
+        #define isname(n) (name && 0 == strcmp(name, (n)))
+        
+        if (type == XML_READER_TYPE_ELEMENT) {
+            
+            if (depth == 0) {
+                
+                /// Validate `<xliff>`
+                if (!isname("xliff")) fail(@"Root element is '%s', not 'xliff'", name);
+                assert( 0 == strcmp((const char *)xmlTextReaderConstXmlVersion(r) ?: "", "1.0") );
+                assert( [_xmlreader_attr(r, "version")            isEqual: @"1.2"] );
+                assert( [_xmlreader_attr(r, "xsi:schemaLocation") isEqual: @"urn:oasis:names:tc:xliff:document:1.2 http://docs.oasis-open.org/xliff/v1.2/os/xliff-core-1.2-strict.xsd"] );
+            }
+            else if (depth == 1) {
+                
+                /// Validate `<file>`
+                if (!isname("file")) fail(@"Found '%s' element where a 'file' was expected", name);
+                
+                filePath = stringTable_intern(strings, _xmlreader_attr(r, "original"));
+                NSString *fileSourceLanguage = _xmlreader_attr(r, "source-language");
+                NSString *fileTargetLanguage = _xmlreader_attr(r, "target-language");
+                assert(filePath);
+                assert(fileSourceLanguage);
+                assert(fileTargetLanguage);
+                assert(_xmlreader_attr(r, "datatype"));
+                
+                if (!sourceLanguage) sourceLanguage = fileSourceLanguage;
+                else                 assert([sourceLanguage isEqual: fileSourceLanguage]);
+                if (!targetLanguage) targetLanguage = fileTargetLanguage;
+                else                 assert([targetLanguage isEqual: fileTargetLanguage]);
+                
+                fileTransUnits = [NSMutableArray new];
+            }
+            else if (depth == 2) {
+                assert(isname("header") || isname("body"));
+            }
+            else if (depth == 3 && isname("tool")) {
+                
+                /// Validate `<header>`
+                assert([_xmlreader_attr(r, "tool-id")   isEqual: @"com.apple.dt.xcode"]);
+                assert([_xmlreader_attr(r, "tool-name") isEqual: @"Xcode"]);
+            }
+            else if (depth == 3 && isname("trans-unit")) {
+                assert(!xmlTextReaderIsEmptyElement(r));
+                inTransUnit = YES;
+                transUnitOrdinal++;
+                transUnitID = stringTable_intern(strings, _xmlreader_attr(r, "id"));
+                translate   = _xmlreader_attr(r, "translate");
+                source = target = targetState = note = nil;
+            }
+            else if (depth == 4 && inTransUnit) {
+                if      (isname("source")) source = stringTable_intern(strings, _xmlreader_content(r));
+                else if (isname("target")) { target = _xmlreader_content(r); targetState = _xmlreader_attr(r, "state"); }
+                else if (isname("note"))   note = stringTable_intern(strings, _xmlreader_content(r));
+            }
+        }
+        else if (type == XML_READER_TYPE_END_ELEMENT) {
+            
+            if (depth == 3 && isname("trans-unit")) {
+                
+                inTransUnit = NO;
+                if ([translate isEqual: @"no"]) continue; /// Filter out transUnits with `kMFTransUnitState_DontTranslate`, like `Xliff_FromDocument()`
+                
+                /// Build the rowModel
+                ///     Only has the stuff that `_rowModel_setCellModel()` looks at. Edits are written to it, but it isn't what gets saved. (See `xliff_serialize()`) [Oct 2026]
+                ///     No `<source>` or `<note>` – those are only ever read from the `RowStore`, where they're shared with the other languages. A copy per row per language is what `StringTable.m` is there to avoid. [Oct 2026]
+                auto transUnit = [NSXMLElement elementWithName: @"trans-unit"];
+                [transUnit addAttribute: [NSXMLNode attributeWithName: @"id" stringValue: transUnitID ?: @""]];
+                if (target) {
+                    auto targetEl = [NSXMLElement elementWithName: @"target" stringValue: target];
+                    if (targetState) [targetEl addAttribute: [NSXMLNode attributeWithName: @"state" stringValue: targetState]];
+                    [transUnit addChild: targetEl];
+                }
+                
+                /// Normalize the state (Mirrors `_rowModel_getCellModel_DOM()`)
+                NSString *state = targetState ?: kMFTransUnitState_New;
+                if ([state isEqual: kMFTransUnitState_NeedsReview2])
+                    state = kMFTransUnitState_NeedsReview;
+                
+                rowStore_append(store, transUnit, (int32_t)transUnitsByFile.count, transUnitID, source, target ?: @"", note, state);
+                bool hasTarget = target != nil;
+                [rowOrdinals  appendBytes: &transUnitOrdinal length: sizeof(NSInteger)];
+                [rowHasTarget appendBytes: &hasTarget length: sizeof(bool)];
+                [fileTransUnits addObject: transUnit];
+            }
+            else if (depth == 1 && isname("file")) {
+                if (fileTransUnits.count) {
+                    [filePaths addObject: filePath];
+                    [transUnitsByFile addObject: fileTransUnits];
+                }
+                fileTransUnits = nil;
+            }
+        }
+        #undef isname
+    }
+    
+    if (ret != 0) fail(@"xmlreader failed around line %d", xmlTextReaderGetParserLineNumber(r));
+    
+    xmlFreeTextReader(r);
+    #undef fail
+    
+    rowStore_finish(store, filePaths);
+    store->strings = strings;
+    
+    auto x = [Xliff new];
+    x->sourceLanguage   = sourceLanguage;
+    x->targetLanguage   = targetLanguage;
+    x->filePaths        = filePaths;
+    x->transUnitsByFile = transUnitsByFile;
+    x->rowStore         = store;
+    x->data             = data;
+    
+    _xliff_attachTargetLocations(x, rowOrdinals.bytes, rowHasTarget.bytes, transUnitOrdinal + 1);
+    
+    return x;
+}
+
+#pragma mark - Saving
+
+    static void _xliff_appendEscaped(NSMutableData *out, NSString *string, BOOL isAttribute) {
+        /// Escapes like Xcode's exports: `&`, `<` and `>` – plus `"` inside attribute values
+        const char *s = string.UTF8String ?: "";
+        const char *run = s;
+        for (const char *p = s; *p; p++) {
+            const char *entity = NULL;
+            switch (*p) {
+                case '&': entity = "&amp;"; break;
+                case '<': entity = "&lt;";  break;
+                case '>': entity = "&gt;";  break;
+                case '"': if (isAttribute) entity = "&quot;"; break;
+            }
+            if (!entity) continue;
+            [out appendBytes: run length: p - run];
+            [out appendBytes: entity length: strlen(entity)];
+            run = p + 1;
+        }
+        [out appendBytes: run length: strlen(run)];
+    }
+
+BOOL xliff_canSpliceEdits(Xliff *x) {
+    return x->_targetLocations != NULL;
+}
+
+NSData *_Nullable xliff_spliceEdits(Xliff *x) {
+    
+    /// Writes the `unsavedRows` into the bytes of the last save and returns the result.
+    ///     Doesn't change `x` – call `xliff_didWrite()` once the result is on disk. Until then, the rows stay unsaved and the next splice starts from the same bytes again. [Oct 2026]
+    ///     Only the `<target>`s of rows whose target or state actually changed are re-encoded. Everything else – Xcode's formatting, escaping, attribute order – stays byte-for-byte the same, so diffs of the .xcloc only show real edits.
+    ///     Returns nil if the xliff can't be saved this way (Not streamed, or the byte scan didn't match xmlreader). Then use `xliff_serialize()`, which falls back to the DOM.
+    ///     Cost: The string work only scales with the number of edits. We still have to copy the unchanged bytes around the edits, but that's a memcpy – not a re-serialization. [Oct 2026]
+    
+    RowStore *store = x->rowStore;
+    XliffTargetLocation *locs = x->_targetLocations;
+    if (!locs) return nil;
+    
+    /// Check that we can do all the edits before touching anything
+    __block BOOL canSplice = YES;
+    [store->unsavedRows enumerateIndexesUsingBlock: ^(NSUInteger row, BOOL *stop) {
+        if (locs[row].targetStart == NSNotFound && locs[row].sourceEnd == NSNotFound) { /// Nowhere to insert a `<target>`
+            canSplice = NO;
+            *stop = YES;
+        }
+    }];
+    if (!canSplice) return nil;
+    
+    if (!store->unsavedRows.count) return x->data;
+    
+    const char *b = x->data.bytes;
+    auto out = [NSMutableData dataWithCapacity: x->data.length + 256 * store->unsavedRows.count];
+    auto values = [NSMutableDictionary<NSNumber *, NSArray<NSString *> *> new];
+    locs = malloc(MAX(1, store->count) * sizeof(XliffTargetLocation)); /// Work on a copy
+    memcpy(locs, x->_targetLocations, store->count * sizeof(XliffTargetLocation));
+    
+    #define copy(start, end)    [out appendBytes: b + (start) length: (end) - (start)]
+    #define append(cstr)        [out appendBytes: (cstr) length: strlen(cstr)]
+    
+    NSUInteger copiedUpTo = 0;  /// Position in the old bytes
+    NSInteger delta = 0;        /// How far the old bytes after `copiedUpTo` have moved in `out`
+    
+    for (NSInteger row = 0; row < store->count; row++) {
+        
+        XliffTargetLocation *l = &locs[row];
+        
+        NSString *target = nil, *state = nil;
+        BOOL targetChanged = NO, stateChanged = NO;
+        if ([store->unsavedRows containsIndex: row]) {
+            target = rowStore_getCellModel(store, row, @"target") ?: @"";
+            state  = rowStore_getCellModel(store, row, @"state");
+            targetChanged = ![target isEqual: x->_savedTargets[row]];
+            stateChanged  = ![state  isEqual: x->_savedStates[row]];
+        }
+        
+        if (!targetChanged && !stateChanged) { /// Untouched (or edited and then undone)
+            XliffTargetLocation_shift(l, 0, delta);
+            continue;
+        }
+        
+        XliffTargetLocation old = *l;
+        XliffTargetLocation_shift(l, 0, delta);
+        
+        if (old.targetStart != NSNotFound) { /// Rewrite the `<target>`
+            
+            BOOL isEmptyElement = old.targetEnd == old.targetTagEnd;    /// `<target/>`
+            NSUInteger tagClose = old.targetTagEnd - (isEmptyElement ? 2 : 1); /// The `>` or `/>`
+            
+            copy(copiedUpTo, old.targetStart);
+            l->targetStart = out.length;
+            
+            if (!stateChanged) {
+                copy(old.targetStart, tagClose);
+                if (old.stateStart != NSNotFound) {
+                    l->stateStart = l->targetStart + (old.stateStart - old.targetStart);
+                    l->stateEnd   = l->targetStart + (old.stateEnd   - old.targetStart);
+                }
+            }
+            else if (old.stateStart != NSNotFound) {
+                copy(old.targetStart, old.stateStart);
+                l->stateStart = out.length;
+                _xliff_appendEscaped(out, state, YES);
+                l->stateEnd = out.length;
+                copy(old.stateEnd, tagClose);
+            }
+            else {
+                copy(old.targetStart, tagClose);
+                append(" state=\"");
+                l->stateStart = out.length;
+                _xliff_appendEscaped(out, state, YES);
+                l->stateEnd = out.length;
+                append("\"");
+            }
+            append(">");
+            l->targetTagEnd = out.length;
+            
+            if (targetChanged)  _xliff_appendEscaped(out, target, NO);
+            else                copy(old.targetTagEnd, old.targetContentEnd);
+            l->targetContentEnd = out.length;
+            
+            if (isEmptyElement) append("</target>");
+            else                copy(old.targetContentEnd, old.targetEnd);
+            l->targetEnd = out.length;
+            
+            copiedUpTo = old.targetEnd;
+            NSInteger deltaBefore = delta;
+            delta = (NSInteger)out.length - (NSInteger)copiedUpTo;
+            
+            if (old.sourceStart != NSNotFound && old.sourceStart > old.targetStart) { /// `<source>` after `<target>` – Xcode doesn't do that, but the positions have to stay right
+                l->indentStart  = old.indentStart + (old.indentStart >= old.targetEnd ? delta : deltaBefore);
+                l->sourceStart  = old.sourceStart + delta;
+                if (old.sourceEnd != NSNotFound) l->sourceEnd = old.sourceEnd + delta;
+            }
+        }
+        else { /// Insert a `<target>` after `</source>`, on its own line with the same indent
+            
+            copy(copiedUpTo, old.sourceEnd);
+            append("\n");
+            copy(old.indentStart, old.sourceStart);
+            
+            l->targetStart = out.length;
+            append("<target state=\"");
+            l->stateStart = out.length;
+            _xliff_appendEscaped(out, state, YES);
+            l->stateEnd = out.length;
+            append("\">");
+            l->targetTagEnd = out.length;
+            _xliff_appendEscaped(out, target, NO);
+            l->targetContentEnd = out.length;
+            append("</target>");
+            l->targetEnd = out.length;
+            
+            copiedUpTo = old.sourceEnd;
+            delta = (NSInteger)out.length - (NSInteger)copiedUpTo;
+        }
+        
+        values[@(row)] = @[target, state];
+    }
+    
+    copy(copiedUpTo, x->data.length);
+    
+    #undef copy
+    #undef append
+    
+    free(x->_pendingLocations);
+    x->_pendingData      = out;
+    x->_pendingLocations = locs;
+    x->_pendingValues    = values;
+    
+    return out;
+}
+
+void xliff_didWrite(Xliff *x, NSData *data) {
+    
+    /// Call on the thread that edits the store once `data` from `xliff_spliceEdits()` is on disk. It becomes the base of the next splice – and of merges (See `XliffMerge.m`). [Oct 2026]
+    ///     Rows that were edited again while `data` was being written stay unsaved.
+    
+    if (!x->_pendingData || data != x->_pendingData) return; /// Nothing was spliced, or there's a newer splice already
+    
+    RowStore *store = x->rowStore;
+    
+    free(x->_targetLocations);
+    x->_targetLocations = x->_pendingLocations;
+    x->data             = x->_pendingData;
+    [x->_pendingValues enumerateKeysAndObjectsUsingBlock: ^(NSNumber *row, NSArray<NSString *> *values, BOOL *stop) {
+        x->_savedTargets[row.integerValue] = values[0];
+        x->_savedStates[row.integerValue]  = values[1];
+    }];
+    x->_pendingData      = nil;
+    x->_pendingLocations = NULL;
+    x->_pendingValues    = nil;
+    
+    auto saved = [NSMutableIndexSet new];
+    [store->unsavedRows enumerateIndexesUsingBlock: ^(NSUInteger row, BOOL *stop) {
+        NSString *target = rowStore_getCellModel(store, row, @"target") ?: @"";
+        NSString *state  = rowStore_getCellModel(store, row, @"state");
+        if ([target isEqual: x->_savedTargets[row]] && [state isEqual: x->_savedStates[row]]) [saved addIndex: row];
+    }];
+    [store->unsavedRows removeIndexes: saved];
+}
+
+void xliff_copyMappedData(Xliff *x) {
+    
+    /// Call after streaming from a mapped file (See `XclocPackage_MapFile()`). Replaces `data` with a copy in memory. [Oct 2026]
+    ///     We keep `data` as the base for splicing for as long as the document is open – a mapping would crash the next splice if another app truncated the file in the meantime.
+    
+    if (!x->data) return;
+    x->data = [NSData dataWithBytes: x->data.bytes length: x->data.length];
+}
+
+NSString *_Nullable xliff_getDiskCellModel(Xliff *x, NSInteger row, NSString *columnID) {
+    
+    /// What the file on disk has for `row` – as of the last read or successful write. This is the base for 3-way merges (See `XliffMerge.m`). [Oct 2026]
+    ///     Only `xliff_didWrite()` moves it forward, so a splice that's still being written (or failed to write) doesn't count as being on disk.
+    ///     Only for xliffs that can be spliced (See `xliff_canSpliceEdits()`). Only "target" and "state".
+    
+    assert(xliff_canSpliceEdits(x));
+    
+    NSString *result = nil;
+    if ((0)) {}
+        else if ([columnID isEqual: @"target"]) result = x->_savedTargets[row];
+        else if ([columnID isEqual: @"state"])  result = x->_savedStates[row];
+    else assert(false);
+    
+    if (result == (id)[NSNull null]) result = nil; /// `_savedTargets` starts out as a copy of `RowStore->targets`
+    return result;
+}
+
+NSData *_Nullable xliff_serialize(Xliff *x) {
+    
+    /// Returns the full xliff for saving.
+    ///     Streamed xliffs splice their edits into the original bytes (See `xliff_spliceEdits()`). If that's not possible, we fall back to the DOM:
+    ///     Streamed xliffs don't have a DOM to serialize. So on the first save, we parse one from the (last saved) bytes, and copy the edits over from the `RowStore`.
+    ///     That way, opening and browsing stays fast and light, and we only pay for the DOM once the user actually edits something. [Oct 2026]
+    
+    RowStore *store = x->rowStore;
+    
+    NSData *spliced = xliff_spliceEdits(x);
+    if (spliced) return spliced;
+    
+    if (!x->doc) {
+        
+        NSError *err = nil;
+        x->doc = [[NSXMLDocument alloc] initWithData: x->data options: NSXMLNodeOptionsNone error: &err];
+        if (!x->doc) {
+            mflog(@"Parsing the streamed xliff for saving failed with error: %@", err);
+            return nil;
+        }
+        
+        /// Match up the DOM's transUnits with the rows – same order and same filtering as in `Xliff_Stream()`
+        auto docTransUnits = [NSMutableArray<NSXMLElement *> new];
+        for (NSXMLElement *file in x->doc.rootElement.children) {
+            for (NSXMLElement *transUnit in xml_childnamed(file, @"body").children) {
+                if ([xml_attr(transUnit, @"translate").objectValue isEqual: @"no"]) continue;
+                [docTransUnits addObject: transUnit];
+            }
+        }
+        assert(docTransUnits.count == store->count);
+        x->_docTransUnits = docTransUnits;
+        
+        /// Not needed anymore
+        x->data = nil;
+        free(x->_targetLocations);
+        x->_targetLocations = NULL;
+        x->_savedTargets = nil;
+        x->_savedStates = nil;
+        free(x->_pendingLocations);
+        x->_pendingLocations = NULL;
+        x->_pendingData = nil;
+        x->_pendingValues = nil;
+    }
+    
+    /// Copy edits into the DOM
+    ///     Only needed for streamed xliffs – otherwise the rowModels *are* the DOM's transUnits. (`unsavedRows` holds every edit that isn't in the bytes we parsed the DOM from, so the first save copies over everything that's missing.)
+    if (x->_docTransUnits) {
+        [store->unsavedRows enumerateIndexesUsingBlock: ^(NSUInteger row, BOOL *stop) {
+            _rowModel_setCellModel(x->_docTransUnits[row], @"target", rowStore_getCellModel(store, row, @"target"));
+            _rowModel_setCellModel(x->_docTransUnits[row], @"state",  rowStore_getCellModel(store, row, @"state"));
+        }];
+    }
+    [store->unsavedRows removeAllIndexes];
+    
+    return [[x->doc XMLStringWithOptions: NSXMLNodePrettyPrint] dataUsingEncoding: NSUTF8StringEncoding];
+}
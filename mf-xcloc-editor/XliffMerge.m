@@ -0,0 +1,148 @@
+//
+//  XliffMerge.m
+//  mf-xcloc-editor
+//
+//  Created by Noah Nübling on 10/17/26.
+//
+
+/// Merges a new version of the xliff from disk (e.g. a re-export from Xcode) into the open one [Oct 2026]
+///
+///     Why: When the xcloc changed on disk, NSDocument reverted the whole document – it rebuilt the SourceList, reloaded the table, scrolled to the top, and dropped the edit in progress along with any edits that hadn't been flushed yet.
+///     Now `XclocDocument` parses the new file in the background, and `xliff_merge()` matches its transUnits up with the open ones by (file, id):
+///         - Rows the user didn't edit since the last save take the values from disk.
+///         - Rows the user did edit keep the user's values. If the file changed them, too, that's a conflict. (3-way, with what's on disk as of our last read or successful write as the base – See `xliff_getDiskCellModel()`)
+///         - Rows that are in both keep their rowModel objects, so the TableView can keep its selection, its scroll position and an edit in progress, and only has to insert, remove and reload the rows that changed. (See `-[TableView reloadWithChangedData:changedItems:]`)
+///     Only works when both xliffs were streamed and can be spliced – only those know their base. Otherwise the document is reverted like before.
+
+@interface XliffMerge : NSObject
+    {
+        @public
+        NSMutableArray<NSXMLElement *> *changedTransUnits;  /// Rows of the new xliff whose cells differ from before. Includes plural parents whose variants were added or removed.
+        NSInteger addedCount;
+        NSInteger removedCount;
+        NSMutableArray<NSDictionary *> *conflicts;          /// `@{ @"transUnit", @"column", @"mine", @"theirs" }` – The merged xliff has `mine`.
+        NSInteger lostEditCount;                            /// Rows with unsaved edits that aren't in the new file anymore
+    }
+@end
+@implementation XliffMerge @end
+
+static BOOL _xliffMerge_isEqual(NSString *_Nullable a, NSString *_Nullable b) {
+    return a == b || [a isEqual: b] || (!a.length && !b.length); /// A missing `<target>` and an empty one are the same to the user – splicing writes nil targets as empty ones.
+}
+
+XliffMerge *_Nullable xliff_merge(Xliff *old, Xliff *new) {
+
+    /// Moves the user's unsaved edits and the rowModels of `old` into `new`. Afterwards, `new` is what the document should show and save.
+    ///     The kept edits go into `new->rowStore->unsavedRows`, so the next flush writes them into the new file. (`new` has no journal yet – they're already in the journal from when they were made.)
+    ///     Returns nil if the xliffs can't be merged. `new` is untouched then.
+    ///     Main thread only – this reads and writes the live `RowStore` of `old`.
+
+    if (!xliff_canSpliceEdits(old) || !xliff_canSpliceEdits(new)) return nil;
+    if (![old->sourceLanguage isEqual: new->sourceLanguage] || ![old->targetLanguage isEqual: new->targetLanguage]) return nil;
+
+    CFAbsoluteTime t0 = CFAbsoluteTimeGetCurrent();
+
+    RowStore *os = old->rowStore;
+    RowStore *ns = new->rowStore;
+
+    auto m = [XliffMerge new];
+    m->changedTransUnits = [NSMutableArray new];
+    m->conflicts = [NSMutableArray new];
+
+    auto oldFileIndexForPath = [NSMutableDictionary<NSString *, NSNumber *> new];
+    for (NSInteger i = 0; i < (NSInteger)old->filePaths.count; i++) oldFileIndexForPath[old->filePaths[i]] = @(i);
+
+    NSInteger *newRowForOldRow = malloc(MAX(1, os->count) * sizeof(NSInteger));
+    for (NSInteger o = 0; o < os->count; o++) newRowForOldRow[o] = -1;
+    auto changedRows = [NSMutableIndexSet new];
+
+    for (NSInteger row = 0; row < ns->count; row++) {
+
+        /// Match
+        NSNumber *oldFileIndex = oldFileIndexForPath[new->filePaths[ns->fileIndexes[row]]];
+        NSNumber *oldRow = oldFileIndex ? os->rowForID[oldFileIndex.integerValue][ns->ids[row]] : nil;
+        if (!oldRow || newRowForOldRow[oldRow.integerValue] != -1) { /// Second check is for duplicate ids – each rowModel can only be adopted once (See `rowStore_finish()`)
+            m->addedCount++;
+            if (ns->parentRow[row] != -1) [changedRows addIndex: ns->parentRow[row]]; /// New variant
+            continue;
+        }
+        NSInteger o = oldRow.integerValue;
+        newRowForOldRow[o] = row;
+        NSXMLElement *oldTransUnit = os->transUnits[o];
+        NSXMLElement *newTransUnit = ns->transUnits[row];
+
+        /// 3-way merge of the columns that the user edits
+        for (NSString *columnID in @[@"target", @"state"]) {
+            NSString *mine   = rowStore_getCellModel(os, o, columnID);
+            NSString *base   = xliff_getDiskCellModel(old, o, columnID);
+            NSString *theirs = rowStore_getCellModel(ns, row, columnID);
+            if (_xliffMerge_isEqual(mine, base))   continue; /// Not edited – take theirs
+            if (_xliffMerge_isEqual(mine, theirs)) continue; /// Same edit on both sides
+            if (!_xliffMerge_isEqual(theirs, base))
+                [m->conflicts addObject: @{ @"transUnit": oldTransUnit, @"column": columnID, @"mine": mine ?: @"", @"theirs": theirs ?: @"" }];
+            _rowModel_setCellModel(newTransUnit, columnID, mine);
+        }
+
+        /// Did anything change for the table?
+        if (
+            !_xliffMerge_isEqual(rowStore_getCellModel(os, o, @"target"), rowStore_getCellModel(ns, row, @"target")) || /// Not the raw arrays – they hold NSNull for missing values
+            !_xliffMerge_isEqual(rowStore_getCellModel(os, o, @"source"), rowStore_getCellModel(ns, row, @"source")) ||
+            !_xliffMerge_isEqual(rowStore_getCellModel(os, o, @"note"),   rowStore_getCellModel(ns, row, @"note"))   ||
+            !_xliffMerge_isEqual(rowStore_getCellModel(os, o, @"state"), rowStore_getCellModel(ns, row, @"state"))
+        ) {
+            [changedRows addIndex: row];
+        }
+
+        /// Adopt the old rowModel
+        ///     Its contents become the new one's – the streamed rowModels only hold the id, the `<target>` and the `translate` attribute. (See `Xliff_Stream()`)
+        oldTransUnit.attributes = [[NSArray alloc] initWithArray: newTransUnit.attributes copyItems: YES];
+        [oldTransUnit setChildren: [[NSArray alloc] initWithArray: newTransUnit.children copyItems: YES]];
+        rowStore_replaceTransUnit(ns, row, oldTransUnit);
+        ((NSMutableArray *)new->transUnitsByFile[ns->fileIndexes[row]])[rowStore_getRowInFile(ns, row)] = oldTransUnit;
+    }
+
+    /// Removed rows
+    for (NSInteger o = 0; o < os->count; o++) {
+        if (newRowForOldRow[o] != -1) continue;
+        m->removedCount++;
+        if ([os->unsavedRows containsIndex: o] && (
+            !_xliffMerge_isEqual(rowStore_getCellModel(os, o, @"target"), xliff_getDiskCellModel(old, o, @"target")) ||
+            !_xliffMerge_isEqual(rowStore_getCellModel(os, o, @"state"),  xliff_getDiskCellModel(old, o, @"state"))
+        )) {
+            m->lostEditCount++;
+        }
+        if (os->parentRow[o] != -1 && newRowForOldRow[os->parentRow[o]] != -1) [changedRows addIndex: newRowForOldRow[os->parentRow[o]]]; /// Removed variant
+    }
+
+    /// Translation memory pairs that the old rows don't have anymore – removed and changed rows. (The new pairs of the changed rows are added below.)
+    auto staleTMPairs = [NSMutableArray<NSArray<NSString *> *> new];
+    if (os->translationMemory) {
+        for (NSInteger o = 0; o < os->count; o++) {
+            if (os->states[o] != MFTransUnitState_Translated || os->isPluralParent[o]) continue;
+            if (newRowForOldRow[o] != -1 && ![changedRows containsIndex: newRowForOldRow[o]]) continue;
+            [staleTMPairs addObject: @[os->sources[o], os->targets[o]]];
+        }
+    }
+    free(newRowForOldRow);
+
+    [changedRows enumerateIndexesUsingBlock: ^(NSUInteger row, BOOL *stop) {
+        [m->changedTransUnits addObject: ns->transUnits[row]];
+    }];
+
+    /// Keep the translation memory
+    ///     Rebuilding it takes a while. Only the pairs of rows that changed on disk are swapped. (See `TranslationMemory.m`)
+    if (os->translationMemory) {
+        ns->translationMemory = os->translationMemory;
+        for (NSArray<NSString *> *pair in staleTMPairs)
+            translationMemory_update(ns->translationMemory, pair[0], pair[1], nil);
+        [changedRows enumerateIndexesUsingBlock: ^(NSUInteger row, BOOL *stop) {
+            if (ns->states[row] == MFTransUnitState_Translated && !ns->isPluralParent[row])
+                translationMemory_update(ns->translationMemory, ns->sources[row], nil, ns->targets[row]);
+        }];
+    }
+
+    mflog(@"Merged xliff from disk in %.0f ms – %ld changed, %ld added, %ld removed, %ld kept edits, %ld conflicts, %ld lost edits",
+        (CFAbsoluteTimeGetCurrent() - t0) * 1000, m->changedTransUnits.count, m->addedCount, m->removedCount, ns->unsavedRows.count, m->conflicts.count, m->lostEditCount);
+
+    return m;
+}
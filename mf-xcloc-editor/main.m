@@ -29,6 +29,9 @@
 #include <objc/runtime.h>
 #include <objc/message.h>
 #include <QuickLookUI/QuickLookUI.h>
+#include <libxml/xmlreader.h>
+#include <os/lock.h>
+#include <CommonCrypto/CommonDigest.h> /// Screenshot cache keys [Oct 2026]
 
 /// Main
 
@@ -50,6 +53,8 @@ int main(int argc, const char * argv[]) {
 #include "Utility/NSView+Additions.m"
 #include "Utility/MFSetMethod.m"
 
+#include "Trace.m"                 /// Before everything that wants to be traced [Oct 2026]
+
 /// Forward declares
 #include "SourceList.h"            /// XclocWindowController.h depends on @class SourceList [Dec 2025]
 #include "TableView.h"             /// XclocWindowController.h depends on @class TableView  [Dec 2025]
@@ -58,7 +63,9 @@ int main(int argc, const char * argv[]) {
 
 /// More imports of local files.
 #include "MFTextField.m"
-#include "RowUtils.h"
+#include "Model.h"                 /// Everything that builds without AppKit. Shared with xcloc-tool [Oct 2026]
+#include "Screenshots.m"
+#include "RowHeights.m"
 #include "SourceList.m"
 #include "TableView.m"
 
@@ -0,0 +1,322 @@
+//
+//  Bench.m
+//  xcloc-tool
+//
+//  Created by Noah Nübling on 10/17/26.
+//
+
+/// Headless benchmark of the model code behind the app's slow phases [Oct 2026]
+///
+///     Phases – and what they stand in for in the app:
+///         load            `-[XclocDocument readFromURL:ofType:error:]` – read + stream the xliff (NSXMLDocument fallback if streaming fails)
+///         screenshots     The `localizedStringData.plist` parse in `readFromURL:` (Only if the xcloc has one)
+///         caches          `_buildRowStoreCachesInBackground()` – display notes, search strings and the `SearchIndex`. (`-[SourceList setXliff:]` itself is only UI)
+///         filter.*        One filter pass per typical query, the way the filterField runs it – `FilterQuery_Make()` + `filterQuery_run()`, so the `SearchIndex` prefilter and the matching on all cores (See `FilterQuery.m`)
+///         sort            The sort pass of `bigUpdateAndStuff_OnlyUpdateSorting:` – collating the sort keys and sorting all rows by two columns
+///         progress        `-[SourceList updateProgressInCell:withFile:]` – progress of every file, as often as a big sidebar asks for it
+///         validate        `rowStore_validateAll()` – the format specifier and plural checks that run at the end of loading (See `Validator.m`)
+///         tm.build        `_buildTranslationMemoryInBackground()` – the `TranslationMemory` over all translated rows
+///         tm.suggest      `_updateTranslationMemorySuggestions` – suggestions for 1% of the rows, one after another (The app does one per selection change)
+///         edit            Editing 1% of the rows (target + state), like `setTranslation:` does
+///         save.splice     `writeXliffInPlace` / `flushJournal` – `xliff_spliceEdits()`
+///         save.serialize  `fileWrapperOfType:` – `xliff_serialize()`
+///     The AppKit parts (cells, row heights, the outline view) aren't covered – use the Performance panel in the app for those. (See `Trace.m`)
+///
+///     Each phase reports the fastest time over all iterations, and the peak resident memory while it ran (sampled every 2 ms).
+///     With `--baseline`, phases that got slower or bigger than the baseline by more than `--tolerance` fail the run (Exit status 1) – small absolute changes are ignored as noise.
+///     Linux: Builds with the recipe in `main.m`. Resident memory comes from `/proc/self/statm` there instead of mach. Baselines are per machine anyway, so keep separate ones for macOS and Linux.
+///     Phases with a budget fail the run when they take longer, baseline or not: Each `filter.*` query has to finish in 10 ms – that's the target for a 100k trans-unit xcloc (`generate --units 100000`).
+
+typedef struct {
+    NSInteger iterations;
+    NSString *_Nullable baselinePath;       /// Compare against this
+    NSString *_Nullable writeBaselinePath;  /// Save the results as the new baseline
+    double tolerance;                       /// Fraction
+} BenchOptions;
+
+#define kMFBenchNoiseMs     5.0     /// Regressions smaller than this are ignored
+#define kMFBenchNoiseMB     16.0
+#define kMFBenchFilterBudgetMs  10.0 /// Per query – so filtering keeps up with typing
+
+#pragma mark - Memory
+
+static double bench_currentRSSMB(void) {
+    #if __APPLE__
+        mach_task_basic_info_data_t info;
+        mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+        if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) != KERN_SUCCESS) return 0;
+        return info.resident_size / (1024.0 * 1024.0);
+    #else
+        long pages = 0, resident = 0;
+        FILE *f = fopen("/proc/self/statm", "r");
+        if (!f) return 0;
+        int n = fscanf(f, "%ld %ld", &pages, &resident);
+        fclose(f);
+        return n == 2 ? resident * (double)sysconf(_SC_PAGESIZE) / (1024.0 * 1024.0) : 0;
+    #endif
+}
+
+static _Atomic double _bench_peakRSSMB;
+
+static dispatch_source_t bench_startRSSSampler(void) {
+    dispatch_source_t timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, dispatch_queue_create("bench.rss", DISPATCH_QUEUE_SERIAL));
+    dispatch_source_set_timer(timer, DISPATCH_TIME_NOW, 2 * NSEC_PER_MSEC, NSEC_PER_MSEC);
+    dispatch_source_set_event_handler(timer, ^{
+        double rss = bench_currentRSSMB();
+        if (rss > _bench_peakRSSMB) _bench_peakRSSMB = rss; /// Only this queue writes while a phase runs
+    });
+    dispatch_resume(timer);
+    return timer;
+}
+
+#pragma mark - Phases
+
+typedef struct {
+    const char *name;
+    double ms;
+    double peakRSSMB;
+} BenchResult;
+
+#define bench_phase(results, phaseName, code...) \
+    bench_budgetPhase(results, phaseName, 0, code)
+
+#define bench_budgetPhase(results, phaseName, budgetMs_, code...) ({               \
+    _bench_peakRSSMB = bench_currentRSSMB();                                        \
+    double _t0 = nowtime();                                                         \
+    { code }                                                                        \
+    double _ms = nowtime() - _t0;                                                   \
+    double _rss = MAX(_bench_peakRSSMB, bench_currentRSSMB());                      \
+    auto _r = [NSMutableDictionary dictionaryWithDictionary: @{ @"name": @(phaseName), @"ms": @(_ms), @"peakRSSMB": @(_rss) }]; \
+    if ((budgetMs_) > 0) _r[@"budgetMs"] = @(budgetMs_);                            \
+    [(results) addObject: _r];                                                      \
+})
+
+static NSArray<NSDictionary *> *_Nullable bench_runOnce(NSString *xclocPath, NSError *__autoreleasing _Nullable *outError) {
+
+    /// One pass over all phases. Returns [{name, ms, peakRSSMB}], in order.
+
+    auto results = [NSMutableArray<NSDictionary *> new];
+
+    NSString *xliffSubpath = XclocPackage_XliffSubpath(xclocPath);
+    if (!xliffSubpath) { if (outError) *outError = mferror(NSCocoaErrorDomain, 0, @"No .xliff inside '%@'", xclocPath); return nil; }
+
+    /// load
+    __block Xliff *xliff = nil;
+    bench_phase(results, "load", {
+        NSData *data = XclocPackage_MapFile([xclocPath stringByAppendingPathComponent: xliffSubpath], outError);
+        if (!data) return nil;
+        xliff = Xliff_Stream(data, StringTable_ForProject(xclocPath.stringByDeletingLastPathComponent), nil);
+        if (xliff) xliff_copyMappedData(xliff); /// Like the app
+        else {
+            NSXMLDocument *doc = [[NSXMLDocument alloc] initWithData: data options: NSXMLNodeOptionsNone error: outError];
+            if (!doc) return nil;
+            xliff = Xliff_FromDocument(doc);
+        }
+    });
+    RowStore *store = xliff->rowStore;
+
+    /// screenshots
+    NSString *plistSubpath = XclocPackage_StringsDataPlistSubpath(xclocPath);
+    if (plistSubpath) bench_phase(results, "screenshots", {
+        NSArray *plist = [NSPropertyListSerialization propertyListWithData: [NSData dataWithContentsOfFile: [xclocPath stringByAppendingPathComponent: plistSubpath]] options: 0 format: NULL error: nil];
+        (void)plist;
+    });
+
+    /// caches
+    ///     Same as `_buildRowStoreCachesInBackground()`, minus the hops to the main thread
+    bench_phase(results, "caches", {
+        auto displayNotes = [NSMutableArray arrayWithCapacity: store->count];
+        for (NSInteger row = 0; row < store->count; row++) @autoreleasepool {
+            [displayNotes addObject: stringTable_displayNote(store->strings, rowStore_getCellModel(store, row, @"note"), _rowModel_cleanUpNote) ?: (id)[NSNull null]];
+        }
+        auto strings = [NSMutableArray arrayWithCapacity: store->count];
+        for (NSInteger row = 0; row < store->count; row++) @autoreleasepool {
+            if (store->parentRow[row] != -1) [strings addObject: [NSNull null]];
+            else                             [strings addObject: _rowModel_makeSearchString(store->transUnits[row], store->targets, displayNotes)];
+        }
+        store->displayNotes = displayNotes;
+        store->searchStrings = strings;
+        store->searchIndex = SearchIndex_Make(strings);
+    });
+
+    /// filter.*
+    ///     The generator's syllables (See `Generate.m`) – broad, narrow, case-sensitive, regex
+    ///     Each one is a fresh query over all rows of the "All Project Files" item, like the first keystroke in the filterField. (Later keystrokes only narrow down the previous matches.)
+    auto allRows = [NSMutableArray<NSXMLElement *> new];
+    for (NSInteger row = 0; row < store->count; row++) [allRows addObject: store->transUnits[row]];
+    NSArray *queries = @[
+        @[@"broad",     @"ka",              @(rowModel_filterOptions(NO, NO))],
+        @[@"narrow",    @"berdan",          @(rowModel_filterOptions(NO, NO))],
+        @[@"case",      @"Pra",             @(rowModel_filterOptions(NO, YES))],
+        @[@"umlaut",    @"übersetzt",       @(rowModel_filterOptions(NO, NO))],
+        @[@"regex",     @"pra\\w+tra",      @(rowModel_filterOptions(YES, NO))],
+    ];
+    for (NSArray *query in queries) {
+        __block NSInteger matchCount = 0;
+        bench_budgetPhase(results, [stringf(@"filter.%@", query[0]) UTF8String], kMFBenchFilterBudgetMs, {
+            FilterQuery *q = FilterQuery_Make(allRows, query[1], [query[2] unsignedIntegerValue], NO);
+            filterQuery_run(q, NULL);
+            matchCount = q->matches.count;
+        });
+        mflog(@"Filter '%@' matched %ld rows", query[1], matchCount);
+    }
+
+    /// sort
+    bench_phase(results, "sort", {
+        rowStore_buildSortKeys(store, @[@"id", @"target"], YES, nil);
+        auto topLevel = [NSMutableArray<NSXMLElement *> new];
+        for (NSInteger row = 0; row < store->count; row++) if (store->parentRow[row] == -1) [topLevel addObject: store->transUnits[row]];
+        NSArray *sorted = rowStore_sortRows(store, topLevel, @[
+            [NSSortDescriptor sortDescriptorWithKey: @"target" ascending: NO],
+            [NSSortDescriptor sortDescriptorWithKey: @"id" ascending: YES],
+        ]);
+        assert(sorted.count == topLevel.count);
+    });
+
+    /// progress
+    ///     The sidebar asks once per file per update – do 100 updates
+    __block NSInteger translated = 0;
+    bench_phase(results, "progress", {
+        for (int i = 0; i < 100; i++)
+            for (NSInteger file = -1; file < store->fileCount; file++)
+                translated += rowStore_getProgress(store, file).translated;
+    });
+    (void)translated;
+
+    /// validate
+    ///     Already ran once as part of "load" – this times it on its own (See `Validator.m`)
+    bench_phase(results, "validate", {
+        rowStore_validateAll(store);
+    });
+
+    /// tm.build
+    __block TranslationMemory *tm = nil;
+    bench_phase(results, "tm.build", {
+        tm = TranslationMemory_Make();
+        for (NSInteger row = 0; row < store->count; row++) @autoreleasepool {
+            if (store->states[row] != MFTransUnitState_Translated || store->isPluralParent[row]) continue;
+            translationMemory_add(tm, store->sources[row], store->targets[row]);
+        }
+    });
+
+    /// tm.suggest
+    __block NSInteger suggestionCount = 0;
+    __block NSInteger queryCount = 0;
+    bench_phase(results, "tm.suggest", {
+        for (NSInteger row = 0; row < store->count; row += 100) @autoreleasepool {
+            if (store->isPluralParent[row]) continue;
+            suggestionCount += translationMemory_suggest(tm, store->sources[row], store->targets[row], 5).count;
+            queryCount++;
+        }
+    });
+    mflog(@"TranslationMemory: %ld pairs, %ld suggestions for %ld rows", tm->entryCount, suggestionCount, queryCount);
+
+    /// edit
+    bench_phase(results, "edit", {
+        for (NSInteger row = 0; row < store->count; row += 100) {
+            if (store->isPluralParent[row]) continue;
+            NSXMLElement *transUnit = store->transUnits[row];
+            _rowModel_setCellModel(transUnit, @"target", [rowModel_getCellModel(transUnit, @"target") stringByAppendingString: @" (bench)"]);
+            _rowModel_setCellModel(transUnit, @"state", kMFTransUnitState_Translated);
+        }
+    });
+
+    /// save
+    if (xliff_canSpliceEdits(xliff)) bench_phase(results, "save.splice", {
+        NSData *d = xliff_spliceEdits(xliff);
+        assert(d.length);
+    });
+    bench_phase(results, "save.serialize", {
+        NSData *d = xliff_serialize(xliff);
+        assert(d.length);
+    });
+
+    return results;
+}
+
+#pragma mark - Main
+
+static int runBench(NSString *xclocPath, const BenchOptions *o) {
+
+    /// Prints a table to stderr and the results as JSON to stdout. Returns the exit status.
+
+    dispatch_source_t sampler = bench_startRSSSampler();
+
+    /// Run
+    ///     Keep the fastest time and the biggest memory peak of each phase
+    auto best = [NSMutableDictionary<NSString *, NSMutableDictionary *> new];
+    auto order = [NSMutableArray<NSString *> new];
+    for (NSInteger i = 0; i < o->iterations; i++) @autoreleasepool {
+        NSError *err = nil;
+        NSArray<NSDictionary *> *results = bench_runOnce(xclocPath, &err);
+        if (!results) {
+            fprintf(stderr, "Benchmark failed: %s\n", err.localizedDescription.UTF8String);
+            dispatch_source_cancel(sampler);
+            return 1;
+        }
+        for (NSDictionary *r in results) {
+            NSMutableDictionary *b = best[r[@"name"]];
+            if (!b) { best[r[@"name"]] = [r mutableCopy]; [order addObject: r[@"name"]]; continue; }
+            b[@"ms"]        = @(MIN([b[@"ms"] doubleValue],        [r[@"ms"] doubleValue]));
+            b[@"peakRSSMB"] = @(MAX([b[@"peakRSSMB"] doubleValue], [r[@"peakRSSMB"] doubleValue]));
+        }
+    }
+    dispatch_source_cancel(sampler);
+
+    /// Compare
+    NSDictionary *baseline = nil;
+    if (o->baselinePath) {
+        NSData *data = [NSData dataWithContentsOfFile: o->baselinePath];
+        baseline = data ? [NSJSONSerialization JSONObjectWithData: data options: 0 error: nil] : nil;
+        if (!isclass(baseline, NSDictionary)) { fprintf(stderr, "Couldn't read baseline '%s'\n", o->baselinePath.UTF8String); return 2; }
+    }
+
+    int status = 0;
+    auto phases = [NSMutableArray<NSDictionary *> new];
+    fprintf(stderr, "%-16s %10s %12s %12s\n", "Phase", "ms", "Peak RSS MB", "vs baseline");
+    bool regressed = NO, overBudget = NO;
+    for (NSString *name in order) {
+        NSMutableDictionary *r = best[name];
+        double ms = [r[@"ms"] doubleValue], rss = [r[@"peakRSSMB"] doubleValue];
+
+        NSString *verdict = @"";
+        NSDictionary *base = nil;
+        for (NSDictionary *p in baseline[@"phases"]) if ([p[@"name"] isEqual: name]) base = p;
+        if (base) {
+            double baseMs = [base[@"ms"] doubleValue], baseRSS = [base[@"peakRSSMB"] doubleValue];
+            bool slower = ms  > baseMs  * (1 + o->tolerance) && ms  - baseMs  > kMFBenchNoiseMs;
+            bool bigger = rss > baseRSS * (1 + o->tolerance) && rss - baseRSS > kMFBenchNoiseMB;
+            verdict = stringf(@"%+.0f%%%@%@", baseMs > 0 ? (ms / baseMs - 1) * 100 : 0, slower ? @" SLOWER" : @"", bigger ? @" BIGGER" : @"");
+            if (slower || bigger) { r[@"regressed"] = @YES; status = 1; regressed = YES; }
+        }
+        double budget = [r[@"budgetMs"] doubleValue];
+        if (budget > 0 && ms > budget) {
+            verdict = [verdict stringByAppendingFormat: @"%@OVER %.0f ms", verdict.length ? @" " : @"", budget];
+            r[@"regressed"] = @YES; status = 1; overBudget = YES;
+        }
+        fprintf(stderr, "%-16s %10.1f %12.1f %12s\n", name.UTF8String, ms, rss, verdict.UTF8String);
+        [phases addObject: r];
+    }
+
+    /// Output
+    NSDictionary *output = @{
+        @"xcloc":       xclocPath,
+        @"iterations":  @(o->iterations),
+        @"phases":      phases,
+    };
+    NSData *json = [NSJSONSerialization dataWithJSONObject: output options: NSJSONWritingPrettyPrinted | NSJSONWritingSortedKeys error: nil];
+    fwrite(json.bytes, 1, json.length, stdout);
+    fputc('\n', stdout);
+
+    if (o->writeBaselinePath) {
+        NSError *err = nil;
+        if (!writeFileAtomically(o->writeBaselinePath, json, &err)) {
+            fprintf(stderr, "Writing baseline failed: %s\n", err.localizedDescription.UTF8String);
+            return 1;
+        }
+    }
+
+    if (regressed)  fprintf(stderr, "Regressed past the baseline by more than %.0f%%\n", o->tolerance * 100);
+    if (overBudget) fprintf(stderr, "Went over the time budget\n");
+    return status;
+}
@@ -0,0 +1,213 @@
+//
+//  Generate.m
+//  xcloc-tool
+//
+//  Created by Noah Nübling on 10/17/26.
+//
+
+/// Writes synthetic .xcloc packages for benchmarking (See `Bench.m`) [Oct 2026]
+///     The only real xclocs we have (`example-docs/`) are tiny. These look like what Xcode exports for a big app: storyboard files with IB notes, .strings files with plain comments, pluralizable strings from .stringsdict files, and a screenshot plist.
+///     Output only depends on the options and `seed` – so the same options always give the same package and benchmark results stay comparable.
+
+typedef struct {
+    NSInteger transUnits;           /// Total, including plural variants
+    NSInteger files;
+    double pluralFraction;          /// Of the top-level rows. Each one gets 2–6 variants
+    double ibNoteFraction;          /// Of the files – those are storyboards with IB-generated plist notes
+    double translatedFraction;
+    NSInteger screenshotEntries;    /// Entries in `localizedStringData.plist`
+    NSString *targetLanguage;
+    uint64_t seed;
+} GenerateOptions;
+
+static GenerateOptions GenerateOptions_Default(void) {
+    return (GenerateOptions) {
+        .transUnits = 10000, .files = 20, .pluralFraction = 0.02, .ibNoteFraction = 0.3, .translatedFraction = 0.7,
+        .screenshotEntries = 0, .targetLanguage = @"de", .seed = 1,
+    };
+}
+
+#pragma mark - Randomness
+
+typedef struct { uint64_t s; } GenerateRNG;
+
+static uint64_t _generate_next(GenerateRNG *r) { /// splitmix64 – arc4random can't be seeded
+    uint64_t z = (r->s += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+static NSInteger _generate_uniform(GenerateRNG *r, NSInteger n)   { return (NSInteger)(_generate_next(r) % (uint64_t)n); }
+static bool      _generate_chance(GenerateRNG *r, double p)       { return (_generate_next(r) >> 11) * 0x1.0p-53 < p; }
+
+static NSString *_generate_word(GenerateRNG *r) {
+    static const char *syllables[] = { "ka", "lo", "mi", "ne", "ru", "sa", "te", "vi", "zo", "ber", "dan", "fen", "hil", "jun", "pra", "qui", "wex", "yol", "tra", "mon" };
+    auto w = [NSMutableString new];
+    NSInteger n = 1 + _generate_uniform(r, 3);
+    for (NSInteger i = 0; i < n; i++) [w appendFormat: @"%s", syllables[_generate_uniform(r, arrcount(syllables))]];
+    return w;
+}
+static NSString *_generate_sentence(GenerateRNG *r, NSInteger minWords, NSInteger maxWords) {
+    auto words = [NSMutableArray<NSString *> new];
+    NSInteger n = minWords + _generate_uniform(r, maxWords - minWords + 1);
+    for (NSInteger i = 0; i < n; i++) [words addObject: _generate_word(r)];
+    NSString *s = [words componentsJoinedByString: @" "];
+    return [[s substringToIndex: 1].uppercaseString stringByAppendingString: [s substringFromIndex: 1]];
+}
+static NSString *_generate_germanish(NSString *s) { /// Cheap fake translation – longer, with some non-ASCII
+    return [[s stringByReplacingOccurrencesOfString: @"a" withString: @"ä"] stringByAppendingString: @" (übersetzt)"];
+}
+static NSString *_generate_objectID(GenerateRNG *r) {
+    static const char chars[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+    char id[11];
+    for (int i = 0; i < 10; i++) id[i] = chars[_generate_uniform(r, sizeof(chars) - 1)];
+    id[3] = id[6] = '-';
+    id[10] = 0;
+    return @(id);
+}
+
+#pragma mark - Writing
+
+static void _generate_writeEscaped(FILE *f, NSString *s) {
+    for (const char *c = s.UTF8String; *c; c++) {
+        if      (*c == '&') fputs("&amp;", f);
+        else if (*c == '<') fputs("&lt;", f);
+        else if (*c == '>') fputs("&gt;", f);
+        else if (*c == '"') fputs("&quot;", f);
+        else                fputc(*c, f);
+    }
+}
+
+static void _generate_writeTransUnit(FILE *f, NSString *transUnitID, NSString *source, NSString *_Nullable target, NSString *_Nullable state, NSString *_Nullable note) {
+    fputs("      <trans-unit id=\"", f); _generate_writeEscaped(f, transUnitID); fputs("\" xml:space=\"preserve\">\n", f);
+    fputs("        <source>", f); _generate_writeEscaped(f, source); fputs("</source>\n", f);
+    if (target) {
+        fputs("        <target", f);
+        if (state) fprintf(f, " state=\"%s\"", state.UTF8String);
+        fputs(">", f); _generate_writeEscaped(f, target); fputs("</target>\n", f);
+    }
+    if (note) { fputs("        <note>", f); _generate_writeEscaped(f, note); fputs("</note>\n", f); }
+    fputs("      </trans-unit>\n", f);
+}
+
+static BOOL generateXcloc(NSString *xclocPath, const GenerateOptions *o, NSError *__autoreleasing _Nullable *outError) {
+
+    /// Writes `xclocPath` (replacing it if it exists) – `contents.json`, `Localized Contents/<lang>.xliff` and, if `screenshotEntries`, `Notes/Screenshots/…/localizedStringData.plist` (without the images)
+
+    auto fm = [NSFileManager defaultManager];
+    [fm removeItemAtPath: xclocPath error: nil];
+
+    NSString *xliffDir = [xclocPath stringByAppendingPathComponent: @"Localized Contents"];
+    if (![fm createDirectoryAtPath: xliffDir withIntermediateDirectories: YES attributes: nil error: outError]) return NO;
+
+    /// contents.json
+    NSDictionary *contents = @{
+        @"developmentRegion": @"en", @"targetLocale": o->targetLanguage, @"version": @"1.0",
+        @"toolInfo": @{ @"toolID": @"com.apple.dt.xcode", @"toolName": @"Xcode", @"toolVersion": @"16.2", @"toolBuildNumber": @"16C5032a" },
+    };
+    NSData *contentsData = [NSJSONSerialization dataWithJSONObject: contents options: NSJSONWritingPrettyPrinted | NSJSONWritingSortedKeys error: outError];
+    if (!contentsData || ![contentsData writeToFile: [xclocPath stringByAppendingPathComponent: @"contents.json"] options: NSDataWritingAtomic error: outError]) return NO;
+
+    /// xliff
+    NSString *xliffPath = [xliffDir stringByAppendingPathComponent: stringf(@"%@.xliff", o->targetLanguage)];
+    FILE *f = fopen(xliffPath.fileSystemRepresentation, "w");
+    if (!f) {
+        if (outError) *outError = [NSError errorWithDomain: NSPOSIXErrorDomain code: errno userInfo: @{ NSFilePathErrorKey: xliffPath }];
+        return NO;
+    }
+
+    GenerateRNG rng = { o->seed };
+    GenerateRNG *r = &rng;
+    static const char *pluralVariants[] = { "one", "few", "many", "zero", "two" };
+    auto screenshotKeys = [NSMutableArray<NSArray<NSString *> *> new]; /// [stringKey, tableName] – a sample of the rows
+
+    fprintf(f, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+    fprintf(f, "<xliff xmlns=\"urn:oasis:names:tc:xliff:document:1.2\" xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\" version=\"1.2\">\n");
+
+    NSInteger files = MAX(1, o->files);
+    NSInteger written = 0;
+    for (NSInteger file = 0; file < files; file++) @autoreleasepool {
+
+        BOOL isStoryboard = _generate_chance(r, o->ibNoteFraction);
+        NSString *tableName = stringf(@"%@%ld", isStoryboard ? @"Main" : @"Localizable", file);
+        NSString *original  = isStoryboard ? stringf(@"App/Base.lproj/%@.storyboard", tableName) : stringf(@"App/en.lproj/%@.strings", tableName);
+
+        fprintf(f, "  <file original=\"%s\" source-language=\"en\" target-language=\"%s\" datatype=\"plaintext\">\n", original.UTF8String, o->targetLanguage.UTF8String);
+        fprintf(f, "    <header>\n      <tool tool-id=\"com.apple.dt.xcode\" tool-name=\"Xcode\" tool-version=\"16.2\" build-num=\"16C5032a\"/>\n    </header>\n    <body>\n");
+
+        NSInteger quota = (o->transUnits - written) / (files - file); /// Spread evenly, the last file gets the remainder
+        NSInteger inFile = 0;
+        while (inFile < quota) @autoreleasepool {
+
+            BOOL translated = _generate_chance(r, o->translatedFraction);
+            NSString *state = translated ? kMFTransUnitState_Translated : (_generate_chance(r, 0.5) ? kMFTransUnitState_NeedsReview : nil);
+
+            if (!isStoryboard && quota - inFile >= 3 && _generate_chance(r, o->pluralFraction)) { /// Pluralizable: the parent and its variants
+
+                NSString *key = stringf(@"%%lld %@ %ld", _generate_word(r), written + inFile);
+                NSString *noun = _generate_word(r);
+                _generate_writeTransUnit(f, key, stringf(@"%%#@%@@", noun), stringf(@"%%#@%@@", noun), nil, _generate_sentence(r, 3, 8));
+                inFile++;
+
+                NSInteger variants = MIN(2 + _generate_uniform(r, 5), quota - inFile);
+                for (NSInteger v = 0; v < variants; v++) {
+                    NSString *source = stringf(@"%%lld %@", _generate_sentence(r, 1, 4));
+                    _generate_writeTransUnit(f,
+                        stringf(@"%@|==|substitutions.pluralizable.plural.%s", key, v == variants - 1 ? "other" : pluralVariants[v]), /// There's always an `other`
+                        source, translated ? _generate_germanish(source) : nil, state, nil);
+                    inFile++;
+                }
+                continue;
+            }
+
+            NSString *source = _generate_sentence(r, 1, _generate_chance(r, 0.1) ? 40 : 8); /// Mostly labels, some long paragraphs
+            NSString *transUnitID;
+            NSString *note;
+            if (isStoryboard) {
+                NSString *objectID = _generate_objectID(r);
+                NSString *property = @[@"title", @"placeholderString", @"ibShadowedToolTip", @"label"][_generate_uniform(r, 4)];
+                transUnitID = stringf(@"%@.%@", objectID, property);
+                note = stringf(@"Class = \"NS%@Cell\"; %@ = \"%@\"; ObjectID = \"%@\";", _generate_word(r).capitalizedString, property, source, objectID); /// Old-style plist without the braces, like IB writes them (See `example-docs` and `_rowModel_cleanUpNote()`)
+            }
+            else {
+                transUnitID = stringf(@"%@.%@.%ld", _generate_word(r), _generate_word(r), written + inFile);
+                note = _generate_chance(r, 0.6) ? _generate_sentence(r, 4, 16) : nil;
+            }
+            _generate_writeTransUnit(f, transUnitID, source, (translated || state) ? _generate_germanish(source) : nil, state, note);
+
+            if (screenshotKeys.count < o->screenshotEntries) [screenshotKeys addObject: @[transUnitID, tableName]];
+            inFile++;
+        }
+        written += inFile;
+
+        fprintf(f, "    </body>\n  </file>\n");
+    }
+    fprintf(f, "</xliff>\n");
+
+    if (fclose(f) != 0) {
+        if (outError) *outError = [NSError errorWithDomain: NSPOSIXErrorDomain code: errno userInfo: @{ NSFilePathErrorKey: xliffPath }];
+        return NO;
+    }
+
+    /// Screenshot plist
+    ///     Same shape as Xcode's. Each entry points at 1–6 screenshots out of a pool of 50.
+    if (o->screenshotEntries) {
+        auto entries = [NSMutableArray<NSDictionary *> new];
+        for (NSArray<NSString *> *k in screenshotKeys) {
+            auto screenshots = [NSMutableArray new];
+            NSInteger n = 1 + _generate_uniform(r, 6);
+            for (NSInteger i = 0; i < n; i++)
+                [screenshots addObject: @{
+                    @"name":  stringf(@"BenchUITests-iPhone-%@-%ld.jpeg", o->targetLanguage, _generate_uniform(r, 50)),
+                    @"frame": stringf(@"{{%ld, %ld}, {%ld, 20}}", _generate_uniform(r, 300), _generate_uniform(r, 800), 40 + _generate_uniform(r, 200)),
+                }];
+            [entries addObject: @{ @"stringKey": k[0], @"tableName": k[1], @"bundleID": @"com.example.Bench", @"screenshots": screenshots }];
+        }
+        NSString *dir = [xclocPath stringByAppendingPathComponent: @"Notes/Screenshots/BenchUITests/iPhone"];
+        if (![fm createDirectoryAtPath: dir withIntermediateDirectories: YES attributes: nil error: outError]) return NO;
+        NSData *plist = [NSPropertyListSerialization dataWithPropertyList: entries format: NSPropertyListXMLFormat_v1_0 options: 0 error: outError];
+        if (!plist || ![plist writeToFile: [dir stringByAppendingPathComponent: @"localizedStringData.plist"] options: NSDataWritingAtomic error: outError]) return NO;
+    }
+
+    return YES;
+}
@@ -0,0 +1,289 @@
+//
+//  main.m
+//  xcloc-tool
+//
+//  Created by Noah Nübling on 10/17/26.
+//
+
+/// Command-line front end for the editor's model – for CI and batch jobs on large localization sets. [Oct 2026]
+///     Loads, filters, counts and edits xclocs with exactly the code the app uses (See `Model.h`), just without AppKit.
+///
+///     Usage:
+///         xcloc-tool [--filter <string>] [--regex] [--case-sensitive] [--mark translated|needs-review] [--jobs <n>] <xcloc>...
+///         xcloc-tool generate [--units <n>] [--files <n>] [--plurals <fraction>] [--ib-notes <fraction>] [--translated <fraction>] [--screenshots <n>] [--language <code>] [--seed <n>] <out.xcloc>
+///         xcloc-tool bench [--iterations <n>] [--baseline <json>] [--write-baseline <json>] [--tolerance <fraction>] <xcloc>
+///
+///         --filter            Only count / mark rows that the app's filter field would show for this string
+///         --regex, --case-sensitive   Same as the options in the app's Filter menu
+///         --mark              Set the state of the matching rows (all rows without `--filter`) and save the xliff in place
+///         --jobs              How many xclocs to process at once. Defaults to the number of cores.
+///
+///     Output: One JSON object per xcloc on stdout, in the order they were passed in:
+///         {"path", "sourceLanguage", "targetLanguage", "translated", "total", "issues", "files": [{"file", "translated", "total", "issues"}], "matches", "marked"}
+///         `issues` counts the strings that would crash or garble at runtime (See `Validator.m`)
+///         `matches` only with `--filter`, `marked` only with `--mark`. On failure: {"path", "error"} – and the exit status is 1.
+///
+///     `generate` writes a synthetic xcloc of any size (See `Generate.m`), `bench` times the model's load, filter, sort, progress and save code on one (See `Bench.m`). [Oct 2026]
+///         E.g.: xcloc-tool generate --units 100000 big.xcloc && xcloc-tool bench --baseline bench-baseline.json big.xcloc
+///
+///     Building:
+///         Use the `xcloc-tool` target in the Xcode project. Without Xcode:
+///             clang -fobjc-arc -fmodules -I"$(xcrun --show-sdk-path)/usr/include/libxml2" -lxml2 -framework Foundation xcloc-tool/main.m -o xcloc-tool
+///         On Linux – with clang, and a GNUstep that's built on the libobjc2 runtime (The gcc runtime of the distro packages has no ARC or blocks), gnustep-corebase, libdispatch and libxml2:
+///             clang -fobjc-arc -fblocks -D_GNU_SOURCE $(gnustep-config --objc-flags) $(xml2-config --cflags) xcloc-tool/main.m -o xcloc-tool \
+///                 $(gnustep-config --base-libs) -lgnustep-corebase -ldispatch $(xml2-config --libs)
+///         Keep the model building there: No AppKit (See `Model.h`), and no Darwin-only APIs outside of `#if __APPLE__` – e.g. `mflock_t` instead of `os_unfair_lock` (See `Utility.h`).
+///             GNUstep's Foundation doesn't pull in CoreFoundation and libdispatch – they're included below.
+
+#define MF_HEADLESS 1
+
+/// Framework imports
+
+#include <Foundation/Foundation.h>
+#include <objc/runtime.h>
+#include <libxml/xmlreader.h>
+#if __APPLE__
+    #include <os/lock.h>
+    #include <mach/mach.h> /// Resident memory for `bench`
+#else
+    #include <pthread.h> /// `mflock_t` (See `Utility.h`)
+    #include <CoreFoundation/CoreFoundation.h> /// gnustep-corebase – `SearchIndex` and `TranslationMemory` use CFDictionary
+    #include <dispatch/dispatch.h>
+#endif
+
+/// Imports of local files
+
+#include "../mf-xcloc-editor/Utility/Utility.h"
+#include "../mf-xcloc-editor/Model.h"
+#include "Generate.m"
+#include "Bench.m"
+
+#pragma mark - Options
+
+typedef struct {
+    NSString *_Nullable filterString;
+    NSStringCompareOptions filterOptions;
+    NSString *_Nullable markState;      /// `kMFTransUnitState_Translated` or `kMFTransUnitState_NeedsReview`
+    NSInteger jobs;
+} ToolOptions;
+
+static void printUsage(FILE *f) {
+    fprintf(f, "usage: xcloc-tool [--filter <string>] [--regex] [--case-sensitive] [--mark translated|needs-review] [--jobs <n>] <xcloc>...\n");
+    fprintf(f, "       xcloc-tool generate [--units <n>] [--files <n>] [--plurals <fraction>] [--ib-notes <fraction>] [--translated <fraction>] [--screenshots <n>] [--language <code>] [--seed <n>] <out.xcloc>\n");
+    fprintf(f, "       xcloc-tool bench [--iterations <n>] [--baseline <json>] [--write-baseline <json>] [--tolerance <fraction>] <xcloc>\n");
+}
+
+#pragma mark - Processing
+
+static NSDictionary *processXcloc(NSString *xclocPath, const ToolOptions *opts) {
+
+    /// Returns the JSON object for one xcloc. Safe to call concurrently for different xclocs – each one gets its own `Xliff` and `RowStore`.
+
+    #define fail(msg...) \
+        return @{ @"path": xclocPath, @"error": stringf(msg) }
+
+    /// Find xliff
+    BOOL isDir = NO;
+    if (![[NSFileManager defaultManager] fileExistsAtPath: xclocPath isDirectory: &isDir] || !isDir)
+        fail(@"Not an .xcloc package");
+    NSString *xliffSubpath = XclocPackage_XliffSubpath(xclocPath);
+    if (!xliffSubpath) fail(@"No .xliff inside");
+    NSString *xliffPath = [xclocPath stringByAppendingPathComponent: xliffSubpath];
+
+    /// Load xliff
+    ///     Same as `-[XclocDocument readFromURL:ofType:error:]` – stream, then fall back to NSXMLDocument.
+    NSError *err = nil;
+    NSData *xliffData = XclocPackage_MapFile(xliffPath, &err);
+    if (!xliffData) fail(@"Reading '%@' failed: %@", xliffPath, err.localizedDescription);
+
+    Xliff *xliff = Xliff_Stream(xliffData, StringTable_ForProject(xclocPath.stringByDeletingLastPathComponent), &err); /// xclocs from the same folder share their sources while they're being processed
+    if (xliff) xliff_copyMappedData(xliff);
+    else {
+        mflog(@"Streaming '%@' failed with error: '%@' – Falling back to NSXMLDocument", xliffPath, err);
+        err = nil;
+        NSXMLDocument *doc = [[NSXMLDocument alloc] initWithData: xliffData options: NSXMLNodeOptionsNone error: &err];
+        if (!doc) fail(@"Parsing '%@' failed: %@", xliffPath, err.localizedDescription);
+        xliff = Xliff_FromDocument(doc);
+    }
+
+    /// Filter & mark
+    ///     Works on top-level rows, like the table. Marking a plural parent marks its variants – the parent's own state isn't shown or counted anywhere. (See `MFProgress`)
+    NSInteger matches = 0;
+    NSInteger marked = 0;
+    NSRegularExpression *filterRegex = rowModel_filterRegex(opts->filterString, opts->filterOptions);
+    for (NSArray<NSXMLElement *> *transUnits in xliff->transUnitsByFile) {
+        for (NSXMLElement *transUnit in transUnits) {
+
+            if (rowModel_getParent(transUnit)) continue;
+
+            if (opts->filterString.length) {
+                if (!rowModel_searchStringMatches(_rowModel_makeSearchString(transUnit, nil, nil), opts->filterString, opts->filterOptions, filterRegex))
+                    continue;
+                matches += 1;
+            }
+
+            if (opts->markState) {
+                NSArray<NSXMLElement *> *rows = rowModel_isPluralParent(transUnit) ? rowModel_getChildren(transUnit) : @[transUnit];
+                for (NSXMLElement *row in rows) {
+                    if ([rowModel_getCellModel(row, @"state") isEqual: opts->markState]) continue;
+                    _rowModel_setCellModel(row, @"state", opts->markState);
+                    marked += 1;
+                }
+            }
+        }
+    }
+
+    /// Save
+    if (marked) {
+        NSData *newData = xliff_serialize(xliff);
+        if (!newData) fail(@"Serializing '%@' failed", xliffPath);
+        if (!writeFileAtomically(xliffPath, newData, &err))
+            fail(@"Writing '%@' failed: %@", xliffPath, err.userInfo[NSDebugDescriptionErrorKey] ?: err.localizedDescription);
+    }
+
+    /// Count progress (after marking, so it reflects what's on disk now)
+    auto files = [NSMutableArray<NSDictionary *> new];
+    MFProgress all = rowStore_getProgress(xliff->rowStore, -1);
+    for (NSInteger i = 0; i < xliff->filePaths.count; i++) {
+        MFProgress p = rowStore_getProgress(xliff->rowStore, i);
+        [files addObject: @{ @"file": xliff->filePaths[i], @"translated": @(p.translated), @"total": @(p.total), @"issues": @(rowStore_getIssueCount(xliff->rowStore, i)) }];
+    }
+
+    auto result = [@{
+        @"path":            xclocPath,
+        @"sourceLanguage":  xliff->sourceLanguage ?: (id)[NSNull null],
+        @"targetLanguage":  xliff->targetLanguage ?: (id)[NSNull null],
+        @"translated":      @(all.translated),
+        @"total":           @(all.total),
+        @"issues":          @(rowStore_getIssueCount(xliff->rowStore, -1)),
+        @"files":           files,
+    } mutableCopy];
+    if (opts->filterString.length) result[@"matches"] = @(matches);
+    if (opts->markState)           result[@"marked"]  = @(marked);
+
+    return result;
+
+    #undef fail
+}
+
+#pragma mark - Main
+
+int main(int argc, const char *argv[]) {
+    @autoreleasepool {
+
+        #define nextarg() ({ if (i + 1 >= argc) { fprintf(stderr, "%s needs a value\n", argv[i]); return 2; } @(argv[++i]); })
+
+        /// Subcommands [Oct 2026]
+        if (argc >= 2 && !strcmp(argv[1], "generate")) {
+            GenerateOptions g = GenerateOptions_Default();
+            NSString *outPath = nil;
+            for (int i = 2; i < argc; i++) {
+                NSString *arg = @(argv[i]);
+                if ((0)) {}
+                    else if ([arg isEqual: @"--units"])         g.transUnits = MAX(1, nextarg().integerValue);
+                    else if ([arg isEqual: @"--files"])         g.files = MAX(1, nextarg().integerValue);
+                    else if ([arg isEqual: @"--plurals"])       g.pluralFraction = nextarg().doubleValue;
+                    else if ([arg isEqual: @"--ib-notes"])      g.ibNoteFraction = nextarg().doubleValue;
+                    else if ([arg isEqual: @"--translated"])    g.translatedFraction = nextarg().doubleValue;
+                    else if ([arg isEqual: @"--screenshots"])   g.screenshotEntries = MAX(0, nextarg().integerValue);
+                    else if ([arg isEqual: @"--language"])      g.targetLanguage = nextarg();
+                    else if ([arg isEqual: @"--seed"])          g.seed = nextarg().longLongValue;
+                    else if ([arg hasPrefix: @"-"]) { fprintf(stderr, "Unknown option %s\n", argv[i]); printUsage(stderr); return 2; }
+                else outPath = arg.stringByStandardizingPath;
+            }
+            if (!outPath) { printUsage(stderr); return 2; }
+            NSError *err = nil;
+            if (!generateXcloc(outPath, &g, &err)) { fprintf(stderr, "Generating failed: %s\n", err.localizedDescription.UTF8String); return 1; }
+            return 0;
+        }
+        if (argc >= 2 && !strcmp(argv[1], "bench")) {
+            BenchOptions b = { .iterations = 3, .tolerance = 0.25 };
+            NSString *xclocPath = nil;
+            for (int i = 2; i < argc; i++) {
+                NSString *arg = @(argv[i]);
+                if ((0)) {}
+                    else if ([arg isEqual: @"--iterations"])        b.iterations = MAX(1, nextarg().integerValue);
+                    else if ([arg isEqual: @"--baseline"])          b.baselinePath = nextarg().stringByStandardizingPath;
+                    else if ([arg isEqual: @"--write-baseline"])    b.writeBaselinePath = nextarg().stringByStandardizingPath;
+                    else if ([arg isEqual: @"--tolerance"])         b.tolerance = MAX(0, nextarg().doubleValue);
+                    else if ([arg hasPrefix: @"-"]) { fprintf(stderr, "Unknown option %s\n", argv[i]); printUsage(stderr); return 2; }
+                else xclocPath = arg.stringByStandardizingPath;
+            }
+            if (!xclocPath) { printUsage(stderr); return 2; }
+            xmlInitParser();
+            return runBench(xclocPath, &b);
+        }
+
+        /// Parse args
+        ToolOptions opts = { .jobs = [NSProcessInfo processInfo].activeProcessorCount };
+        BOOL isRegex = NO, isCaseSensitive = NO;
+        auto paths = [NSMutableArray<NSString *> new];
+
+        for (int i = 1; i < argc; i++) {
+            NSString *arg = @(argv[i]);
+            if ((0)) {}
+                else if ([arg isEqual: @"--filter"])            opts.filterString = nextarg();
+                else if ([arg isEqual: @"--regex"])             isRegex = YES;
+                else if ([arg isEqual: @"--case-sensitive"])    isCaseSensitive = YES;
+                else if ([arg isEqual: @"--jobs"])              opts.jobs = MAX(1, nextarg().integerValue);
+                else if ([arg isEqual: @"--mark"]) {
+                    NSString *state = nextarg();
+                    if ((0)) {}
+                        else if ([state isEqual: @"translated"])    opts.markState = kMFTransUnitState_Translated;
+                        else if ([state isEqual: @"needs-review"])  opts.markState = kMFTransUnitState_NeedsReview;
+                    else { fprintf(stderr, "--mark takes 'translated' or 'needs-review'\n"); return 2; }
+                }
+                else if ([arg isEqual: @"--help"] || [arg isEqual: @"-h"]) { printUsage(stdout); return 0; }
+                else if ([arg hasPrefix: @"-"]) { fprintf(stderr, "Unknown option %s\n", argv[i]); printUsage(stderr); return 2; }
+            else [paths addObject: arg.stringByStandardizingPath];
+        }
+        #undef nextarg
+        if (!paths.count) { printUsage(stderr); return 2; }
+        opts.filterOptions = rowModel_filterOptions(isRegex, isCaseSensitive);
+
+        if (opts.filterString.length && isRegex) { /// Fail early instead of once per row
+            NSError *err = nil;
+            if (![NSRegularExpression regularExpressionWithPattern: opts.filterString options: 0 error: &err]) {
+                fprintf(stderr, "Invalid regex: %s\n", err.localizedDescription.UTF8String);
+                return 2;
+            }
+        }
+
+        /// Process
+        ///     Concurrently, at most `jobs` at once. Results are collected by index so the output order doesn't depend on scheduling.
+        xmlInitParser(); /// Has to happen on one thread before we use libxml2 from several.
+
+        NSMutableArray *results = [NSMutableArray new];
+        for (NSInteger i = 0; i < paths.count; i++) [results addObject: [NSNull null]];
+
+        dispatch_semaphore_t slots = dispatch_semaphore_create(opts.jobs);
+        dispatch_group_t group = dispatch_group_create();
+        dispatch_queue_t queue = dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0);
+        NSObject *resultsLock = [NSObject new];
+
+        for (NSInteger i = 0; i < paths.count; i++) {
+            dispatch_semaphore_wait(slots, DISPATCH_TIME_FOREVER);
+            dispatch_group_async(group, queue, ^{
+                @autoreleasepool {
+                    NSDictionary *r = processXcloc(paths[i], &opts);
+                    @synchronized (resultsLock) { results[i] = r; }
+                }
+                dispatch_semaphore_signal(slots);
+            });
+        }
+        dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+
+        /// Print
+        int status = 0;
+        for (NSDictionary *r in results) {
+            if (r[@"error"]) status = 1;
+            NSError *err = nil;
+            NSData *line = [NSJSONSerialization dataWithJSONObject: r options: NSJSONWritingSortedKeys error: &err];
+            if (!line) { fprintf(stderr, "Couldn't encode result for %s: %s\n", [r[@"path"] UTF8String], err.localizedDescription.UTF8String); status = 1; continue; }
+            fwrite(line.bytes, 1, line.length, stdout);
+            fputc('\n', stdout);
+        }
+
+        return status;
+    }
+}